@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "money.h"
+
+struct BalanceCredit {
+    uint32_t line;
+    std::string player_name;
+    Money amount;
+};
+
+struct ImportRowError {
+    uint32_t line;
+    std::string error;
+};
+
+// Satır hataları sınırlı tutulur; sayaç hepsini sayar
+struct BalanceImportReport {
+    static constexpr size_t MAX_ERRORS = 1000;
+
+    uint32_t rows = 0;        // Boş olmayan veri satırı
+    uint32_t credited = 0;
+    Money total = 0;          // Yüklenen toplam (kuruş)
+    uint64_t error_count = 0;
+    std::vector<ImportRowError> errors;
+
+    void add_error(uint32_t line, std::string error);
+};
+
+// 📥 Toplu bakiye yükleme ayrıştırıcısı (CSV veya NDJSON)
+// Gövde parça parça beslenir; sadece yarım kalan son satır tutulur, tam satırlar hemen
+// ayrıştırılıp batch'lere eklenir. Batch dolunca handler çağrılır (oyuna tek kilitle uygulanır).
+// Biçim ilk dolu satırdan anlaşılır: '{' ile başlıyorsa NDJSON, değilse CSV.
+//
+//   player_name,amount           {"player_name": "beko", "amount": 25.5}
+//   beko,25.50                   {"player_name": "ali", "amount": 10}
+//   "Soyad, Ad",10
+class BalanceImportParser {
+public:
+    enum class Format { UNKNOWN, CSV, NDJSON };
+    // Bundan uzun satır hatalı sayılır ve atlanır; parçalar arası tutulan bellek sınırlı kalır
+    static constexpr size_t MAX_LINE_BYTES = 4096;
+    using BatchHandler = std::function<void(const std::vector<BalanceCredit>&)>;
+
+    BalanceImportParser(BalanceImportReport& report, BatchHandler on_batch, size_t batch_size = 1000);
+
+    void feed(std::string_view chunk);
+    void finish();  // Son satırı ve yarım batch'i işler
+
+    Format get_format() const;
+
+    // "12", "12.5", "12.34" (TL); 2'den fazla ondalık, işaret ve üs reddedilir
+    static bool parse_amount(std::string_view text, Money& out);
+
+private:
+    BalanceImportReport& report;
+    BatchHandler on_batch;
+    size_t batch_size;
+    Format format;
+    uint32_t line_number;
+    std::string partial;  // Önceki parçadan kalan yarım satır
+    bool oversized;       // Yarım satır MAX_LINE_BYTES'ı aştı, satır sonuna kadar atlanıyor
+    std::vector<BalanceCredit> batch;
+
+    void append_partial(std::string_view text);
+    void finish_partial();
+    void parse_line(std::string_view line);
+    bool parse_csv(std::string_view line, std::string& name, std::string_view& amount, std::string& error) const;
+    void parse_ndjson(std::string_view line);
+    void add(std::string name, Money amount);
+    void flush();
+};
+
+// 📦 Parçalı bakiye yükleme oturumları
+// Pistache gövdeyi tamamen belleğe aldığı için büyük dosya istemcide max_request_bytes'lık
+// parçalara bölünür. Her yükleme kendi ayrıştırıcısını tutar: parçalar sırayla beslenir, tamamlanan
+// batch'ler hemen uygulanır, son parçada rapor döner. Aynı parça tekrar gelirse (istemci retry'ı)
+// reddedilir; bakiye iki kez yüklenmez. Uzun süre parça gelmeyen yükleme düşürülür.
+class BalanceImportUploads {
+public:
+    enum class Result { ACCEPTED, DONE, UNKNOWN_UPLOAD, OUT_OF_ORDER, TOO_MANY };
+    using CreditHandler = std::function<void(const std::vector<BalanceCredit>&, BalanceImportReport&)>;
+
+    struct Progress {
+        Result result = Result::UNKNOWN_UPLOAD;
+        uint32_t next_part = 0;
+        BalanceImportReport report;  // ACCEPTED'ta ara sayaçlar (hatasız), DONE'da tam rapor
+    };
+
+    BalanceImportUploads(CreditHandler on_credits, size_t max_uploads = 4,
+                         int64_t idle_timeout_ms = 60000, size_t batch_size = 1000);
+
+    // part 0 yeni yüklemeyi açar; now_ms süre aşımı için (steady clock)
+    Progress feed(const std::string& upload_id, uint32_t part, bool last, std::string_view body, int64_t now_ms);
+
+    size_t active() const;
+
+private:
+    struct Upload {
+        BalanceImportReport report;
+        BalanceImportParser parser;
+        uint32_t next_part = 0;
+        int64_t last_seen_ms = 0;
+
+        Upload(const CreditHandler& on_credits, size_t batch_size);
+    };
+
+    CreditHandler on_credits;
+    size_t max_uploads;
+    int64_t idle_timeout_ms;
+    size_t batch_size;
+    mutable std::mutex uploads_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Upload>> uploads;
+
+    void expire_locked(int64_t now_ms);
+};
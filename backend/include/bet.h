@@ -1,6 +1,8 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <string_view>
+#include "money.h"
 
 enum class BetStatus {
     ACTIVE,      // Bahis aktif, henüz cashout yapılmamış
@@ -8,29 +10,32 @@ enum class BetStatus {
     CRASHED      // Oyun crash oldu, bahis kaybedildi
 };
 
+// Oyuncu id/isim alanları sahiplenilmez: round arena'sındaki (veya sabit) belleğe bakar.
+// Bet, gösterdiği bellekten uzun yaşamamalıdır.
 class Bet {
 private:
-    std::string player_id;
-    double amount;
-    double cashout_multiplier;
+    std::string_view player_id;
+    Money amount;
+    uint32_t cashout_multiplier_x100;  // Çarpan * 100 (2.35x -> 235)
     BetStatus status;
     int game_round;
-    std::string player_name;
+    std::string_view player_name;
     
 public:
-    Bet(const std::string& p_id, double bet_amount, int round);
-    Bet(const std::string& p_id, double bet_amount, int round,const std::string& p_name);
+    Bet(std::string_view p_id, Money bet_amount, int round);
+    Bet(std::string_view p_id, Money bet_amount, int round, std::string_view p_name);
     
     // Getter'lar
-    std::string get_player_id() const;
-    std::string get_player_name() const;
-    double get_amount() const;
+    std::string_view get_player_id() const;
+    std::string_view get_player_name() const;
+    Money get_amount() const;
     double get_cashout_multiplier() const;
+    uint32_t get_cashout_multiplier_x100() const;
     BetStatus get_status() const;
     int get_game_round() const;
     
     // Bahis işlemleri
     bool cashout(double current_multiplier);
     void mark_as_crashed();
-    double calculate_winnings() const;
-};
\ No newline at end of file
+    Money calculate_winnings() const;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 📜 Settle edilmiş bahis kaydı - diskte sabit 48 byte
+// prev alanı aynı oyuncunun bir önceki kaydını gösterir; oyuncu geçmişi bu zincirle sayfalanır.
+struct BetRecord {
+    uint64_t prev;             // Önceki kaydın indeksi + 1 (0: yok)
+    int64_t settled_at_ms;     // Unix epoch ms
+    int64_t amount;            // Kuruş
+    int64_t payout;            // Kuruş (kaybedilen bahiste 0)
+    uint32_t round;
+    uint32_t player;           // Oyuncu handle'ı
+    uint32_t multiplier_x100;  // Cashout çarpanı * 100 (kaybedilen bahiste 0)
+    uint8_t status;            // BetStatus
+    uint8_t reserved[3];
+};
+static_assert(sizeof(BetRecord) == 48, "BetRecord diskte sabit boyutlu olmalı");
+
+// Settlement'tan store'a giden girdi (view'lar sadece append_round süresince okunur)
+struct SettledBet {
+    std::string_view player_id;
+    std::string_view player_name;
+    int64_t amount;
+    int64_t payout;
+    uint32_t multiplier_x100;
+    uint8_t status;
+};
+
+// Bir round'un kayıtları dosyada ardışık durur (segment)
+struct RoundSegment {
+    uint32_t round;
+    uint64_t first;
+    uint64_t count;
+    int64_t settled_at_ms;
+};
+
+struct HistoryPage {
+    std::vector<BetRecord> records;  // Yeniden eskiye
+    uint64_t next_cursor;            // 0: daha fazla kayıt yok
+};
+
+// Append-only bahis geçmişi
+// path boşsa kayıtlar bellekte tutulur (testler için). Aksi halde kayıtlar "path" dosyasına,
+// oyuncu handle tablosu "path.players" dosyasına eklenir ve açılışta indeks yeniden kurulur.
+// Bellekte sadece oyuncu başına son kayıt + sayaç ve round segment tablosu tutulur.
+class BetHistoryStore {
+private:
+    struct PlayerIndex {
+        std::string player_id;
+        std::string name;
+        uint64_t head;   // Son kaydın indeksi + 1
+        uint64_t count;
+    };
+    
+    std::string path;
+    int records_fd;
+    int players_fd;
+    std::vector<BetRecord> memory_records;
+    std::deque<PlayerIndex> players;                          // Elemanların adresi sabit kalır
+    std::unordered_map<std::string_view, uint32_t> handles;   // Anahtarlar players içindeki id'lere bakar
+    std::vector<RoundSegment> segments;
+    uint64_t record_count;
+    mutable std::shared_mutex store_mutex;
+    
+    void load();
+    uint32_t handle_for(std::string_view player_id, std::string_view name);
+    bool read_record(uint64_t index, BetRecord& out) const;
+    
+public:
+    explicit BetHistoryStore(const std::string& file_path = "");
+    ~BetHistoryStore();
+    BetHistoryStore(const BetHistoryStore&) = delete;
+    BetHistoryStore& operator=(const BetHistoryStore&) = delete;
+    
+    void append_round(uint32_t round, int64_t settled_at_ms, const std::vector<SettledBet>& bets);
+    
+    // cursor 0: en yeni kayıttan başla; aksi halde önceki sayfanın next_cursor değeri
+    HistoryPage query(const std::string& player_id, uint64_t cursor, size_t limit) const;
+    
+    uint64_t size() const;
+    uint32_t last_round() const;  // Geçmişe yazılmış en büyük round (yoksa 0)
+    uint64_t get_player_bet_count(const std::string& player_id) const;
+    std::vector<RoundSegment> get_segments() const;
+    
+    // Dışa aktarım için kopyasız, parça parça okuma (segmentler settle zamanına göre sıralı)
+    size_t find_segment(int64_t from_ms) const;  // settled_at_ms >= from_ms olan ilk segment
+    bool get_segment(size_t index, RoundSegment& out) const;
+    size_t read_records(uint64_t first, size_t count, BetRecord* out) const;  // Okunan kayıt sayısı
+    // View'lar store yaşadıkça geçerli: oyuncu kayıtları hiç değişmez ve yer değiştirmez
+    bool get_player(uint32_t handle, std::string_view& player_id, std::string_view& name) const;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 🔎 Oyuncu id -> round bahis zinciri tablosu (açık adresleme, lineer arama)
+// Slot dizisi round'lar arası tekrar kullanılır: clear() sadece nesil sayacını artırır,
+// eski nesilden kalan slot boş sayılır. Tablo sadece doluluk yarıyı geçince büyür;
+// kalıcı round boyutuna ulaştıktan sonra bahis başına ayırma yapılmaz.
+// Anahtarlar sahiplenilmez: round arena'sındaki id'lere bakar.
+class BetIndex {
+public:
+    struct Chain {
+        uint32_t head;  // İlk (muhtemelen aktif) bahis
+        uint32_t tail;
+    };
+
+private:
+    struct Slot {
+        std::string_view key;
+        uint64_t hash;
+        uint32_t generation;  // generation != current_generation: boş
+        Chain chain;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+    uint32_t current_generation;
+
+    bool occupied(const Slot& slot) const { return slot.generation == current_generation; }
+    size_t find_slot(std::string_view key, uint64_t hash) const;  // Yoksa ilk boş slot
+    void grow();
+
+public:
+    explicit BetIndex(size_t initial_capacity = 1024);
+
+    Chain* find(std::string_view key);
+    const Chain* find(std::string_view key) const;
+    // Anahtar varsa mevcut zinciri döner, inserted false olur
+    Chain& insert(std::string_view key, Chain chain, bool& inserted);
+    void erase(std::string_view key);
+    void clear();
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 📼 Durum değiştiren komutların ikili günlüğü
+// Her kayıt 32 byte'lık başlık + player_id + name byte'larıdır. Oyun bu günlükten,
+// saat ve RNG'ye hiç bakmadan birebir yeniden yürütülebilir (bkz. tools/crash_replay.cpp).
+enum class JournalType : uint8_t {
+    START = 1,         // Sunucu (yeniden) başladı: oyun durumu sıfırdan
+    ADD_PLAYER = 2,    // id, name
+    BET = 3,           // id, value = tutar (kuruş); WAITING dışında bir sonraki round'a
+    CASHOUT = 4,       // id, value = çarpan * 100
+    LOAD_BALANCE = 5,  // id, value = tutar (kuruş)
+    WITHDRAW = 6,      // id, value = tutar (kuruş) - bring-beko
+    EVICT = 7,         // id - boşta kalan oturum silindi
+    FLY = 8,           // value = crash noktası * 100 (RNG çıktısı)
+    CRASH = 9,
+    NEW_ROUND = 10,    // round = yeni round
+    CHECKPOINT = 11,   // value = settlement sonrası bakiye özeti (CrashGame::balance_checksum)
+    HANDOFF = 12,      // Yeni süreç durumu devraldı (CRASH_HANDOFF_SOCKET): oyun kaldığı yerden sürer
+    RELOAD = 13        // id - EVICT ile sayfalanan oyuncu geri yüklendi (bakiye / kazanç korunur)
+};
+
+struct JournalRecordHeader {
+    int64_t at_ms;      // Unix epoch ms
+    int64_t value;
+    uint32_t round;     // Kayıt anındaki round
+    uint16_t id_size;
+    uint16_t name_size;
+    uint8_t type;       // JournalType
+    uint8_t reserved[7];
+};
+static_assert(sizeof(JournalRecordHeader) == 32, "Günlük başlığı sabit boyutlu olmalı");
+
+// Okunan kayıt; view'lar okunan tamponu gösterir
+struct JournalEntry {
+    JournalType type;
+    uint32_t round;     // Kayıt anındaki round
+    int64_t at_ms;
+    int64_t value;
+    std::string_view player_id;
+    std::string_view name;
+};
+
+// Append-only günlük yazıcısı
+// Kayıtlar bellekte biriktirilir; tampon dolunca veya flush() ile (her crash'te) dosyaya eklenir.
+// path boşsa kayıtlar sadece bellekte kalır (testler için, get_buffer ile okunur).
+class CommandJournal {
+private:
+    std::string path;
+    int fd;
+    std::string buffer;
+    uint64_t record_count;
+    std::mutex journal_mutex;
+
+    void write_buffer();
+
+public:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+
+    explicit CommandJournal(const std::string& file_path = "");
+    ~CommandJournal();
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    void record(JournalType type, uint32_t round, int64_t value,
+                std::string_view player_id = {}, std::string_view name = {});
+    void flush();
+
+    uint64_t size();
+    std::string get_buffer();  // Sadece bellek modunda anlamlı
+};
+
+// Ardışık okuyucu; yarım kalan son kayıt yok sayılır
+class JournalReader {
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+
+public:
+    JournalReader(const char* journal_data, size_t journal_size);
+
+    bool next(JournalEntry& entry);
+    size_t get_offset() const { return offset; }
+    bool truncated() const { return offset < size; }
+};
+
+// Dosyanın tamamını belleğe okur (replay sırasında disk beklenmesin)
+std::vector<char> read_journal_file(const std::string& path);
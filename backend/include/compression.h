@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+// 🗜️ HTTP içerik sıkıştırma (Accept-Encoding pazarlığı + zlib)
+enum class ContentCoding {
+    IDENTITY,
+    GZIP,
+    DEFLATE
+};
+
+class Compression {
+public:
+    // Bu boyutun altındaki body'ler sıkıştırılmaz; header maliyeti kazancı geçer
+    static const size_t MIN_COMPRESS_SIZE = 256;
+
+    // Accept-Encoding başlığından en uygun kodlamayı seç (q değerleri dikkate alınır)
+    static ContentCoding negotiate(const std::string& accept_encoding);
+    
+    static std::string compress(const std::string& data, ContentCoding coding);
+    static std::string decompress(const std::string& data, ContentCoding coding);
+    static const char* coding_name(ContentCoding coding);
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "money.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+// Cashout çarpanı histogramı: kova i, [BOUNDS[i-1], BOUNDS[i]) aralığı; son kova üst sınırsız
+constexpr size_t EXPOSURE_BUCKETS = 8;
+constexpr std::array<uint32_t, EXPOSURE_BUCKETS - 1> EXPOSURE_BOUNDS_X100 = {150, 200, 300, 500, 1000, 2000, 5000};
+
+struct RoundAggregates {
+    int round;
+    uint64_t bets;
+    Money wagered;        // Round'a yatırılan toplam
+    Money active_stake;   // Henüz cashout yapılmamış ve kaybetmemiş bahisler
+    uint64_t cashouts;
+    Money paid_out;       // Cashout'larda kazanılan toplam (bahis dahil)
+    Money lost;           // Crash'te kaybedilen bahisler
+    std::array<uint64_t, EXPOSURE_BUCKETS> cashout_histogram;
+    
+    // Şu an herkes cashout yapsa ödenecek tutar
+    Money liability(uint32_t multiplier_x100) const;
+};
+
+// 📊 Round başına anlık kasa riski
+// Bahis, cashout ve settlement'ta artımlı güncellenir; okuma current_bets'i hiç taramaz.
+// Sayaçlar thread başına cache line'lara bölünür (yazıcılar aynı satırı çekiştirmez) ve
+// okurken toplanır. İki slot round paritesine göre seçilir: FLYING sırasında bir sonraki
+// round'a verilen bahisler diğer slota yazılır. Biten round yeni round başlarken arşivlenir.
+//
+// Yazıcılar CrashGame::game_mutex altında çağırır; okuyucular kilitsizdir ve bir round
+// geçişine denk gelirse o anki kısmi toplamı görebilir.
+class ExposureTracker {
+private:
+    static constexpr size_t SHARDS = 16;
+    
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> bets{0};
+        std::atomic<Money> wagered{0};
+        std::atomic<Money> active_stake{0};
+        std::atomic<uint64_t> cashouts{0};
+        std::atomic<Money> paid_out{0};
+        std::atomic<Money> lost{0};
+        std::array<std::atomic<uint64_t>, EXPOSURE_BUCKETS> histogram{};
+    };
+    
+    struct Slot {
+        std::atomic<int> round{0};
+        std::array<Shard, SHARDS> shards;
+    };
+    
+    std::array<Slot, 2> slots;
+    mutable std::mutex last_mutex;
+    RoundAggregates last_round{};
+    
+    Slot& slot_for(int round);
+    const Slot& slot_for(int round) const;
+    static Shard& local_shard(Slot& slot);
+    static RoundAggregates merge(const Slot& slot);
+    static void reset(Slot& slot, int round);
+    
+public:
+    ExposureTracker();
+    
+    void on_bet(int round, Money amount);
+    void on_cashout(int round, Money stake, Money payout, uint32_t multiplier_x100);
+    void on_settle(int round);               // Kalan aktif bahisler kaybedildi
+    void on_round_start(int round);          // Biten round arşivlenir, round + 1 slotu boşaltılır
+    
+    RoundAggregates get_round(int round) const;  // Mevcut veya bir sonraki round
+    RoundAggregates get_last_round() const;      // En son biten round (yoksa round = 0)
+    
+    static size_t histogram_bucket(uint32_t multiplier_x100);
+};
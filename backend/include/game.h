@@ -5,13 +5,29 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include "json_utils.h"
 #include "player.h"
 #include "bet.h"
 #include "fixed_queue.h"
+#include "leaderboard.h"
+#include "bet_history.h"
+#include "player_store.h"
+#include "command_journal.h"
+#include "string_arena.h"
+#include "bet_index.h"
+#include "timing_wheel.h"
+#include "exposure.h"
+#include "hash_chain.h"
 
 using json = nlohmann::json;
 
+struct BalanceCredit;
+struct BalanceImportReport;
+
 enum class GamePhase {
     WAITING,     // Oyuncuların bahis yapması için bekleme
     FLYING,      // Helikopter uçuyor, multiplier artıyor
@@ -28,19 +44,74 @@ private:
     int current_round;
     FixedQueue<double> old_crash_points{15};
     
+    // Cevap önbelleği için versiyonlar (ETag)
+    std::atomic<uint64_t> bets_version{0};     // Aktif bahis listesi her değiştiğinde artar
+    std::atomic<uint64_t> history_version{0};  // Her crash sonrası artar
+    std::atomic<uint64_t> status_version{0};   // Faz, çarpan veya aktif bahis sayısı değişince artar (long-poll)
+    
+    // Liderlik tabloları - settlement'ta artımlı güncellenir
+    Leaderboards leaderboards;
+    
+    // Kasa riski ve round toplamları - bahis/cashout/settlement'ta artımlı güncellenir
+    ExposureTracker exposure;
+    
+    // Settle edilen bahislerin kalıcı geçmişi
+    std::shared_ptr<BetHistoryStore> bet_history;
+    
+    // Durum değiştiren komutların günlüğü (yoksa kayıt tutulmaz)
+    std::shared_ptr<CommandJournal> journal;
+    
+    // Provably-fair crash noktaları (yoksa veya bittiyse RNG); -1: round'un linki yok
+    std::shared_ptr<HashChain> hash_chain;
+    int64_t round_chain_index;
+    bool hash_chain_pending;  // Zincir hazırlanıyor: round'lar WAITING'de bekler
+    
     // Test modu için hızlandırma
     bool test_mode;
     
     // Oyuncu ve bahis yönetimi
-    std::map<std::string, std::shared_ptr<Player>> players;
+    // players ve isim index'i HTTP thread'leri ile oyun döngüsü arasında paylaşılır
+    std::map<std::string, std::shared_ptr<Player>, std::less<>> players;
+    std::unordered_map<std::string, std::string> player_ids_by_name;
+    mutable std::shared_mutex players_mutex;
+    
+    // Faz, çarpan, bahis vektörleri ve index'ler: oyun döngüsü ile handler thread'leri
+    // arasında bu kilitle paylaşılır. Sıra: game_mutex -> players_mutex -> günlük
+    mutable std::mutex game_mutex;
+    
+    // Boşta kalan oturumlar: her oyuncu çarkta bir kez durur, süresi dolunca son aktiviteye
+    // bakılır; aktifse yeniden planlanır, değilse (ve bahsi yoksa) silinir. Bakiyesi başlangıçtan
+    // farklı oyuncu player_store'a sayfalanır, id'si veya ismi sorulunca geri yüklenir
+    TimingWheel<std::string> session_wheel;
+    std::shared_ptr<PlayerStore> player_store;
+    int64_t session_ttl_ms;
+    std::atomic<uint64_t> evicted_sessions{0};
     std::vector<Bet> current_bets;     // Mevcut round'un bahisleri
     std::vector<Bet> next_round_bets;  // Bir sonraki round için bahisler
     
+    // Bahislerin id/isim kopyaları round arena'larında tutulur; round değişince
+    // vektörler ve arena'lar yer değiştirir, kapasiteleri korunur
+    StringArena current_arena;
+    StringArena next_round_arena;
+    std::vector<SettledBet> settled_bets;  // Settlement için tekrar kullanılan tampon
+    
+    // Cashout için oyuncu -> mevcut round bahisleri zinciri (O(1) arama)
+    // Anahtarlar current_arena'daki id'lere bakar; sadece aktif bahisler. Settlement'ta boşalır,
+    // round değişince yeniden kurulur. Tablonun slotları round'lar arası korunur
+    static constexpr uint32_t NO_BET = UINT32_MAX;
+    BetIndex bet_index;
+    std::vector<uint32_t> next_bet_of_player;  // current_bets ile paralel
+    
+    // Oyuncu/bahis başına log (test modunda ve sentetik yükte kapalı)
+    bool log_actions;
+    
     // Timing ayarları
     static const int WAITING_TIME_MS = 10000;  // 10 saniye bahis zamanı
     static const int CRASHED_TIME_MS = 3000;   // 3 saniye sonuç gösterme
     static const int TEST_WAITING_TIME_MS = 100;  // Test için 100ms
     static const int TEST_CRASHED_TIME_MS = 50;   // Test için 50ms
+    static const int SESSION_TICK_MS = 1000;      // Oturum çarkı çözünürlüğü
+    static const int64_t DEFAULT_SESSION_TTL_MS = 30 * 60 * 1000;  // 30 dakika
     
 public:
     CrashGame(bool test_mode = false);
@@ -48,17 +119,37 @@ public:
     // Oyun yönetimi
     void update();
     void start_flying_phase();
+    void start_flying_phase(double crash_point);  // Replay: RNG yerine günlükteki crash noktası
     void end_game();
+    void start_next_round();
     
     // Oyuncu yönetimi
     bool add_player(const std::string& player_id, const std::string& name);
-    std::shared_ptr<Player> get_player(const std::string& player_id);
+    std::shared_ptr<Player> get_player(std::string_view player_id);
     bool get_player_by_name(const std::string& name, std::shared_ptr<Player>& out_player);
+    size_t get_player_count() const;
+    bool remove_player(const std::string& player_id);
+    uint64_t balance_checksum() const;
+    
+    // Oturum süresi (0: süresiz). Süresi dolan, bahsi olmayan oyuncular silinir.
+    void set_session_ttl_ms(int64_t ttl_ms);
+    // Sayfalanan oyuncular (varsayılan: bellekte)
+    void set_player_store(std::shared_ptr<PlayerStore> store);
+    std::shared_ptr<PlayerStore> get_player_store() const;
+    size_t expire_idle_sessions(int64_t now_ms);
+    uint64_t get_evicted_session_count() const;
+    static int64_t now_ms();
     
     // Bahis yönetimi
-    bool place_bet(const std::string& player_id, double amount);
+    bool place_bet(const std::string& player_id, Money amount);
     bool cashout(const std::string& player_id);
-    bool load_balance(const std::string& player_id, double amount);
+    bool cashout_at(const std::string& player_id, double multiplier);  // Replay: günlükteki çarpan
+    bool load_balance(const std::string& player_id, Money amount);
+    bool withdraw_balance(const std::string& player_id, Money amount);
+    // Toplu yükleme: isimler index'ten çözülür, batch tek kilitle uygulanır; bulunamayanlar rapora
+    size_t load_balances(const std::vector<BalanceCredit>& credits, BalanceImportReport& report);
+    bool has_active_bet(std::string_view player_id) const;  // Mevcut round'da açık bahsi var mı
+    void set_action_logging(bool enabled);
     
     // Getter'lar
     double get_current_multiplier() const;
@@ -66,10 +157,40 @@ public:
     GamePhase get_phase() const;
     std::string get_phase_string() const;
     int get_current_round() const;
+    // Soğuk başlangıçta ilk round'un numarası (bahis almadan, günlük bağlanmadan önce).
+    // Round id'leri yeniden başlatmalar arasında tekrar etmesin diye geçmişten ve zincirden gelir
+    void set_first_round(int round);
     int get_round() const;
     double get_multiplier() const;
     int get_remaining_time_ms() const;
     int get_active_bet_count() const;
+    uint64_t get_bets_version() const;
+    uint64_t get_history_version() const;
+    uint64_t get_status_version() const;
+    uint64_t get_leaderboard_version() const;
+    
+    // Bahis geçmişi (varsayılan: bellekte)
+    void set_bet_history(std::shared_ptr<BetHistoryStore> store);
+    std::shared_ptr<BetHistoryStore> get_bet_history() const;
+    
+    // Komut günlüğü (varsayılan: kapalı). resumed: durum önceki süreçten devralındı (HANDOFF kaydı)
+    void set_command_journal(std::shared_ptr<CommandJournal> command_journal, bool resumed = false);
+    std::shared_ptr<CommandJournal> get_command_journal() const;
+    
+    // Hash zinciri (varsayılan: kapalı). Arka planda hazırlanınca bağlanır, sonraki round'dan geçerli.
+    // pending iken bekleme süresi dolsa da round uçmaz: zincir açılırken RNG'li round oynanmaz.
+    // set_hash_chain bekleyişi bitirir; hazırlık başarısızsa set_hash_chain_pending(false) ile RNG'ye dönülür
+    void set_hash_chain(std::shared_ptr<HashChain> chain);
+    void set_hash_chain_pending(bool pending);
+    std::shared_ptr<HashChain> get_hash_chain() const;
+    int64_t get_round_chain_index() const;
+    
+    // Süreç devri (handoff): round uçmuyorsa bellekteki tüm durum (oyuncular, bahisler, round,
+    // faz süresi, ETag versiyonları, liderlik toplamları) JSON'a alınır. import sadece henüz
+    // oyuncusu olmayan bir oyuna uygulanır. Hata: exception
+    static constexpr int HANDOFF_STATE_VERSION = 1;
+    void export_state(json& state) const;
+    void import_state(const json& state);
     
     // Test modunda hızlı çalışma
     void enable_test_mode();
@@ -79,10 +200,29 @@ public:
     std::string get_game_state_json() const;
     void get_current_bets_json(json &resp) const;
     void get_old_crash_points_json(json &resp) const;
+    std::vector<double> get_old_crash_points() const;
+    // version: tablonun alındığı versiyon. false: settlement yarıda, cevap önbelleğe konmamalı
+    bool get_leaderboard_json(json &resp, uint64_t& version) const;
+    const ExposureTracker& get_exposure() const;  // Okuma kilitsiz
+    bool get_bet_history_json(const std::string& player_id, uint64_t cursor, size_t limit, json &resp) const;
     
 private:
+    // *_locked: game_mutex tutulurken çağrılır
+    void start_flying_phase_locked(double next_crash_point);
+    void end_game_locked();
+    void start_next_round_locked();
+    size_t expire_idle_sessions_locked(int64_t now_ms);
+    bool cashout_locked(const std::string& player_id, double multiplier);
+    int remaining_time_ms_locked() const;
+    
     // Crash noktası hesaplama
     double calculate_crash_point();
     void update_multiplier();
     void process_crashed_bets();
+    void index_bet(size_t index);
+    void erase_player_locked(std::map<std::string, std::shared_ptr<Player>, std::less<>>::iterator it);
+    std::shared_ptr<Player> find_player_locked(std::string_view player_id);  // Sayfalanmışsa geri yükler
+    std::shared_ptr<Player> reload_player_locked(std::string_view player_id);
+    void record(JournalType type, int64_t value = 0, std::string_view player_id = {}, std::string_view name = {});
+    void rebuild_bet_index();
 };
\ No newline at end of file
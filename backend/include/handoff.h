@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 🔄 Kesintisiz yeniden başlatma (handoff) protokolü
+// Çalışan süreç CRASH_HANDOFF_SOCKET yolunda bir UNIX soketi dinler; yeni süreç açılışta bağlanır:
+//
+//   yeni -> HELLO   HTTP portunu (SO_REUSEPORT) dinliyor; gelen istekler kuyrukta bekler
+//   eski -> STATE   round bitti, dinleyici kapandı, işlenen istekler boşaldı:
+//                   oyun durumu (CBOR) + tick yayını dinleme soketi (SCM_RIGHTS)
+//   yeni -> ACK     durum yüklendi, geçmiş ve günlük açıldı; eski süreç çıkar
+//
+// Her mesaj 16 byte'lık başlık (tip, uzunluk) ve gövdedir; fd'ler başlıkla birlikte gider.
+// ACK'tan önce ardıl oyunu değiştirmez: ardıl STATE'ten önce veya ACK'sız kapanırsa eski süreç
+// dinleyicisini yeniden açıp oyuna devam eder.
+namespace handoff {
+
+enum class MessageType : uint32_t {
+    HELLO = 1,
+    STATE = 2,
+    ACK = 3
+};
+
+constexpr size_t MAX_FDS = 4;
+constexpr uint64_t MAX_PAYLOAD = 1ULL << 30;  // Bozuk başlıkla dev tahsis yapılmasın
+
+int listen(const std::string& path);        // Kalmış dosyayı siler; hata: exception
+int connect(const std::string& path);       // Dinleyen süreç yoksa -1 (soğuk başlangıç)
+int accept(int listen_fd, int timeout_ms);  // Zaman aşımında -1
+
+void send_message(int fd, MessageType type, std::string_view payload, const std::vector<int>& fds = {});
+// timeout_ms içinde tam mesaj gelmezse veya bağlantı koparsa exception atar
+MessageType receive_message(int fd, std::string& payload, std::vector<int>& fds, int timeout_ms);
+
+// Karşı taraf bağlantıyı kapatmadıysa true (bloklamaz). Beklenen mesaj yokken okunabilirlik de kapanıştır.
+bool peer_alive(int fd);
+
+// Bu süreçte port'u dinleyen TCP soketlerini kapatır. fd numarası bağlantısız yeni bir sokete
+// yönlendirilir: soketin sahibi (Pistache) fark etmeden kabul etmeyi bırakır, açık bağlantılar sürer.
+// net.ipv4.tcp_migrate_req=1 ise kabul kuyruğunda bekleyenler aynı portu dinleyen yeni sürece geçer.
+size_t retire_listeners(uint16_t port);
+
+// Bu süreçte port'tan kabul edilmiş, hâlâ açık TCP bağlantıları. Devirde keep-alive bağlantıların
+// boşalması beklenir; kalan boştaki bağlantılar close_connections ile kapatılır (shutdown: fd
+// sahibinde kalır, istemci ardıla yeniden bağlanır)
+size_t open_connections(uint16_t port);
+size_t close_connections(uint16_t port);
+
+}  // namespace handoff
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct HashChainConfig {
+    std::string path;          // Boşsa kapalı: crash noktaları RNG'den gelir
+    uint64_t length = 1000000; // Link sayısı; link başına 36 byte
+    std::string salt;          // Zincir yayınlandıktan sonra açıklanan tuz (en fazla 64 byte)
+    int threads = 0;           // Üretim / doğrulama thread'leri; 0: donanım thread sayısı
+};
+
+// 🔗 Provably-fair SHA-256 hash zinciri (mmap'li dosya)
+// Gizli bir tohumdan başlayıp link[i] = sha256(link[i + 1]) ile geriye doğru üretilir;
+// round'lar link[0]'dan başlayarak sırayla tüketir. Zincirin ucu sha256(link[0]) önceden
+// yayınlanır: crash olan her round'un hash'i açıklanınca herkes sha256(link[i]) == link[i - 1]
+// ile zinciri uca kadar izleyebilir, crash noktası da link + tuzdan yeniden hesaplanır.
+//
+// Dosya: [başlık][link x length][crash noktası x100 x length][round x length]
+// Crash noktaları üretimde paralel olarak önceden hesaplanır; oyun thread'i round başında
+// sadece sıradaki 4 byte'ı okur, hash hesaplamaz. Tüketim sayaçları dosyadadır: yeniden
+// başlayınca kullanılmış bir link asla tekrar kullanılmaz. Linki alan round'un numarası da
+// dosyaya yazılır: oyuncu round numarasıyla doğrular, yeniden başlatma / devirden sonra da.
+class HashChain {
+public:
+    static constexpr size_t HASH_SIZE = 32;
+    static constexpr size_t MAX_SALT = 64;
+    using Hash = std::array<uint8_t, HASH_SIZE>;
+
+    // Dosya yoksa üretir (geçici dosyaya yazıp rename), sonra map edip paralel doğrular.
+    // Bozuk dosya veya farklı tuz runtime_error fırlatır.
+    static std::shared_ptr<HashChain> open_or_generate(const HashChainConfig& config);
+    static void generate(const HashChainConfig& config);
+    static std::shared_ptr<HashChain> open(const std::string& path, int threads);
+    // Doğrulamadan, açılışta: link almış en büyük round (dosya yoksa / bozuksa 0)
+    static uint32_t last_taken_round(const std::string& path);
+
+    ~HashChain();
+    HashChain(const HashChain&) = delete;
+    HashChain& operator=(const HashChain&) = delete;
+
+    // Oyun thread'i: sıradaki round'un linki. Zincir bittiyse false. round 0: bilinmiyor
+    bool take(uint64_t& index, uint32_t& crash_point_x100, uint32_t round = 0);
+    // Round crash oldu: index dahil önceki tüm linkler doğrulanabilir
+    void reveal(uint64_t index);
+
+    // Sadece açıklanmış linkler döner (uçan round'un hash'i gizli kalır)
+    bool revealed_link(uint64_t index, Hash& link, uint32_t& crash_point_x100) const;
+    uint32_t link_round(uint64_t index) const;  // Linki alan round (0: bilinmiyor)
+    // Eski dosyalarda round numaraları tekrar edebilir: en son açıklanan eşleşme döner
+    bool find_revealed_round(uint32_t round, uint64_t& index) const;
+
+    uint64_t length() const;
+    uint64_t next_index() const;
+    uint64_t revealed_count() const;
+    Hash terminal_hash() const;
+    std::string salt() const;
+    const std::string& get_path() const;
+
+    static Hash sha256(const uint8_t* data, size_t size);
+    // HMAC-SHA256(link, tuz)'un ilk 52 biti u ∈ (0, 1]: 0.99 / u, [1.01, 10.00] aralığında
+    static uint32_t crash_point_x100(const Hash& link, std::string_view salt);
+    static std::string to_hex(const Hash& hash);
+
+private:
+    struct Header {
+        static constexpr uint64_t MAGIC = 0x324e484348535243ULL;  // "CRSHCHN2"
+
+        uint64_t magic;                  // En son yazılır: yarım kalan üretim geçersizdir
+        uint64_t length;
+        std::atomic<uint64_t> next;      // Sıradaki round'un alacağı link
+        std::atomic<uint64_t> revealed;  // Crash olmuş (açıklanmış) link sayısı
+        uint8_t terminal[HASH_SIZE];     // sha256(link[0]): önceden yayınlanan taahhüt
+        uint32_t salt_length;
+        char salt[MAX_SALT];
+        uint32_t reserved;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Dosyada kilitsiz atomik gerekli");
+
+    std::string path;
+    void* mapping;
+    size_t mapping_size;
+    Header* header;
+    const uint8_t* links;
+    const uint32_t* crash_points;
+    uint32_t* rounds;
+
+    HashChain(const std::string& path, void* mapping, size_t size);
+    static size_t file_size(uint64_t length);
+    static unsigned worker_count(int threads);
+    bool verify(unsigned threads) const;
+};
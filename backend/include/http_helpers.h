@@ -0,0 +1,38 @@
+#pragma once
+
+#include "response_cache.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <pistache/http.h>
+#include <pistache/router.h>
+
+using namespace Pistache;
+
+// 🌐 Primary ve replica sunucularının ortak HTTP yardımcıları
+class HttpHelpers {
+public:
+    static void enableCors(Http::ResponseWriter& response);
+    
+    // Header adı büyük/küçük harf duyarsız aranır, yoksa boş string
+    static std::string getHeaderValue(const Rest::Request& request, const std::string& name);
+    
+    // Koşullu GET (ETag / If-None-Match) + Accept-Encoding'e göre sıkıştırılmış önbellek cevabı
+    static void sendCached(const Rest::Request& request, Http::ResponseWriter& response,
+                           const std::shared_ptr<const CachedResponse>& cached,
+                           const Http::Mime::MediaType& mime = MIME(Application, Json),
+                           const std::string& cache_control = "no-cache");
+    
+    // İkili protokol (application/x-crash-tick) yardımcıları
+    static bool acceptsBinaryTick(const Rest::Request& request);
+    static const Http::Mime::MediaType& binaryTickMime();
+    
+    // Long-poll: ?since=<version> varsa ve sayıysa true
+    static bool getSinceVersion(const Rest::Request& request, uint64_t& since);
+    
+    // Bekletilen status isteklerini aynı JSON gövdesiyle cevaplar (gövde bir kez üretilir).
+    // close_connection: devirde keep-alive bağlantı cevaptan sonra kapansın (Connection: close)
+    static void sendStatusToWaiters(std::vector<Http::ResponseWriter>& waiters, const std::string& body,
+                                    bool close_connection = false);
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct IdempotencyConfig {
+    size_t slots = 65536;            // 2'nin kuvvetine yuvarlanır; slot başına 32 byte
+    int64_t ttl_ms = 10 * 60 * 1000; // Tekrar denemelerin tanındığı süre
+};
+
+enum class IdempotencyStatus {
+    NEW,          // İlk kez görüldü: işlem yapılmalı, sonra complete çağrılmalı
+    IN_PROGRESS,  // İlk istek hâlâ işleniyor
+    SUCCEEDED,    // Tekrar: ilk istek başarılıydı
+    FAILED,       // Tekrar: ilk istek reddedilmişti
+    MISMATCH,     // Aynı anahtar farklı içerikle kullanılmış
+    FULL          // Penceredeki tüm slotlarda işlenen istek var: kayıt açılamadı, işlem yapılmamalı
+};
+
+struct IdempotencyStats {
+    uint64_t accepted;
+    uint64_t replayed;
+    uint64_t conflicts;  // IN_PROGRESS + MISMATCH
+    uint64_t evicted;    // Süresi dolmadan yer açmak için silinen
+    uint64_t full;       // Pencere işlenen isteklerle dolu olduğu için reddedilen
+};
+
+// 🔁 Idempotency-Key tekrar tablosu (bahis / cashout)
+// Sabit boyutlu açık adresli tablo: (oyuncu, anahtar) 64 bit hash'e indirgenir ve sadece
+// hash'in ilk PROBE slotluk penceresinde aranır. Pencerede boş veya süresi dolmuş slot yoksa
+// süresi en yakın tamamlanmış kayıt silinir; bellek hiç büyümez, arama en fazla PROBE karşılaştırmadır.
+// İşlenen (IN_PROGRESS) kayıt hiç silinmez: silinseydi tekrarı ikinci kez işlenirdi. Penceredeki
+// slotların hepsi işlenen isteklerle doluysa yeni istek FULL ile reddedilir.
+class IdempotencyCache {
+private:
+    static constexpr size_t PROBE = 8;
+    
+    struct Entry {
+        uint64_t key_hash;      // 0: boş
+        uint64_t request_hash;  // Aynı anahtarla farklı istek tespiti
+        int64_t expires_at_ms;
+        uint8_t state;          // IdempotencyStatus
+    };
+    
+    IdempotencyConfig config;
+    size_t slot_mask;
+    std::vector<Entry> entries;
+    mutable std::mutex table_mutex;
+    uint64_t accepted;
+    uint64_t replayed;
+    uint64_t conflicts;
+    uint64_t evicted;
+    uint64_t full;
+    
+    static uint64_t hash_key(std::string_view player_id, std::string_view key);
+    Entry* find_locked(uint64_t key_hash, int64_t now_ms);
+    
+public:
+    explicit IdempotencyCache(const IdempotencyConfig& cache_config = IdempotencyConfig());
+    
+    IdempotencyStatus begin(std::string_view player_id, std::string_view key, uint64_t request_hash, int64_t now_ms);
+    void complete(std::string_view player_id, std::string_view key, bool success, int64_t now_ms);
+    void forget(std::string_view player_id, std::string_view key);  // İşlem exception attı: tekrar denenebilsin
+    
+    // Süreç devri (handoff): tamamlanmış, süresi dolmamış kayıtlar ham olarak aktarılır.
+    // Son kullanma zamanları steady clock'tur; iki süreç aynı makinede olmalı.
+    std::string save_entries(int64_t now_ms) const;
+    size_t restore_entries(std::string_view data, int64_t now_ms);  // Yerleşen kayıt sayısı
+    
+    IdempotencyStats get_stats() const;
+    size_t capacity() const;
+    
+    static constexpr size_t MAX_KEY_LENGTH = 255;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "command_journal.h"
+#include "game.h"
+
+struct ReplayStats {
+    uint64_t records = 0;
+    uint64_t starts = 0;
+    uint64_t handoffs = 0;
+    uint64_t rounds = 0;
+    uint64_t commands = 0;            // Oyuncu komutları (join, bet, cashout, bakiye, evict)
+    uint64_t rejected = 0;            // Üretimde başarılı olup replay'de reddedilen komutlar
+    uint64_t checkpoints = 0;
+    uint64_t checkpoint_mismatches = 0;
+    uint32_t first_mismatch_round = 0;
+    int64_t first_at_ms = 0;
+    int64_t last_at_ms = 0;
+
+    bool diverged() const { return rejected > 0 || checkpoint_mismatches > 0; }
+};
+
+// ⏩ Komut günlüğünü CrashGame üzerinde saat beklemeden yeniden yürütür
+// Faz geçişleri günlükteki sırayla zorlanır, crash noktaları RNG yerine günlükten gelir.
+// Her START kaydında oyun sıfırdan kurulur (sunucu yeniden başlamış).
+class JournalReplayer {
+private:
+    std::unique_ptr<CrashGame> game;
+    ReplayStats stats;
+    std::string player_id;  // Tekrar kullanılan tampon
+    std::string name;
+
+    void reset_game();
+    void apply(const JournalEntry& entry);
+    void reject(const JournalEntry& entry);
+
+public:
+    JournalReplayer();
+
+    const ReplayStats& run(JournalReader& reader);
+
+    const CrashGame& get_game() const { return *game; }
+    const ReplayStats& get_stats() const { return stats; }
+};
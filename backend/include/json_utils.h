@@ -2,6 +2,9 @@
 
 #include <nlohmann/json.hpp>
 #include <string>
+#include "money.h"
+#include "tick_protocol.h"
+#include "shm_state.h"
 
 using json = nlohmann::json;
 
@@ -15,6 +18,10 @@ public:
     // ✅ Request JSON'ları parse etme
     static json parseRequest(const std::string& body);
     
+    // ⚡ Tam parse yapmadan bir string alanının ilk geçtiği değeri bul (rate limit gibi ucuz ön kontroller için)
+    // Kaçış karakteri içeren veya bulunamayan değerlerde boş string döner
+    static std::string peekString(const std::string& body, const std::string& key);
+    
     // ✅ JSON validation
     static bool validateJoinRequest(const json& request);
     static bool validateBetRequest(const json& request);
@@ -25,12 +32,33 @@ public:
     static double getDouble(const json& obj, const std::string& key, double defaultValue = 0.0);
     static int getInt(const json& obj, const std::string& key, int defaultValue = 0);
     static bool getBool(const json& obj, const std::string& key, bool defaultValue = false);
+    
+    // 💰 TL cinsinden tutarı kuruşa çevirir; 2'den fazla ondalık, negatif veya aşırı büyük değerlerde false
+    static bool getMoney(const json& obj, const std::string& key, Money& out);
 };
 
 // 🎮 GAME STATE SERIALIZATION - Oyun durumunu JSON'a çevirme
 class GameStateSerializer {
 public:
     static json serializeGameState(const class CrashGame& game);
+    static tick_protocol::Tick serializeTick(const class CrashGame& game);
+    
+    // Replica'lar için: primary'nin yayınladığı snapshot'tan aynı cevaplar
+    static GameSnapshot captureSnapshot(const class CrashGame& game);
+    static json serializeSnapshot(const GameSnapshot& snapshot, int64_t now_ms);
+    static json serializeCrashPoints(const GameSnapshot& snapshot);
+    static tick_protocol::Tick serializeTick(const GameSnapshot& snapshot, int64_t now_ms);
     static json serializePlayer(const class Player& player);
     static json serializeBet(const class Bet& bet);
+    
+    // Admin: mevcut / sonraki / son round toplamları ve anlık kasa riski
+    static json serializeExposure(const class CrashGame& game);
+    static json serializeRoundAggregates(const struct RoundAggregates& aggregates);
+    
+    // Toplu bakiye yükleme sonucu (satır hataları satır sırasında)
+    static json serializeImportReport(const struct BalanceImportReport& report);
+    
+    // Provably-fair: zincir taahhüdü ve açıklanmış bir round'un linki
+    static json serializeFairness(const class HashChain& chain, int64_t round_chain_index);
+    static json serializeChainLink(const class HashChain& chain, uint64_t index);
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "money.h"
+
+struct LeaderboardEntry {
+    std::string player_id;
+    std::string name;
+    Money value;
+};
+
+// 🏆 Sınırlı top-K listesi - oyuncu başına tek kayıt
+// offer() O(log K), top() O(K). Değerler oyuncu başına sadece artmalı (kazanç toplamları gibi);
+// böylece listeden düşen bir oyuncunun tekrar girmesi için yeni değeri yeterlidir.
+class TopK {
+private:
+    size_t capacity;
+    std::set<std::pair<Money, std::string>> ordered;  // (değer, player_id) artan
+    std::unordered_map<std::string, LeaderboardEntry> members;
+    
+public:
+    explicit TopK(size_t k);
+    
+    void offer(const std::string& player_id, const std::string& name, Money value);
+    std::vector<LeaderboardEntry> top() const;  // Büyükten küçüğe
+    void clear();
+    size_t size() const;
+};
+
+// Süreç devri (handoff) için tabloların kaynağı: toplamlar aktarılır, tablolar yeniden kurulur.
+// Tüm zamanlar tablosu oyuncuların kazanç toplamlarından kurulduğu için burada yok.
+struct LeaderboardState {
+    int64_t day = -1;
+    int settled_round = 0;
+    uint64_t version = 0;
+    std::vector<LeaderboardEntry> round_totals;  // name sadece listedekiler için dolu
+    std::vector<LeaderboardEntry> daily_totals;
+};
+
+// Tabloların tek kilit altında alınmış hali. settling: settlement yarıda (round tablosu
+// yeni round'dan kısmen dolu, versiyon henüz artmadı); bu hal versiyonla önbelleğe konmaz
+struct LeaderboardSnapshot {
+    uint64_t version = 0;
+    bool settling = false;
+    int settled_round = 0;
+    std::vector<LeaderboardEntry> round_top;
+    std::vector<LeaderboardEntry> daily_top;
+    std::vector<LeaderboardEntry> all_time_top;
+};
+
+// Round, günlük ve tüm zamanlar liderlik tabloları
+// Settlement sırasında artımlı güncellenir; okuma tarafı sadece K kayıt kopyalar.
+class Leaderboards {
+private:
+    mutable std::mutex boards_mutex;
+    TopK round_board;
+    TopK daily_board;
+    TopK all_time_board;
+    std::unordered_map<std::string, Money> round_totals;  // Sadece bu round kazananlar
+    std::unordered_map<std::string, Money> daily_totals;  // Sadece bugün kazananlar
+    int64_t current_day;
+    int settled_round;
+    uint64_t version;
+    bool settling;
+    
+public:
+    explicit Leaderboards(size_t k = 10);
+    
+    // day: UTC gün numarası (epoch'tan beri); değişirse günlük tablo sıfırlanır
+    void begin_settlement(int round, int64_t day);
+    void record_win(const std::string& player_id, const std::string& name, Money winnings, Money all_time_total);
+    void end_settlement();
+    
+    LeaderboardState save_state() const;
+    // Boş tablolara uygulanır; isimler çağıran tarafından tamamlanmış olmalı
+    void restore_state(const LeaderboardState& state);
+    void restore_all_time(const std::string& player_id, const std::string& name, Money all_time_total);
+    
+    int get_settled_round() const;
+    uint64_t get_version() const;
+    std::vector<LeaderboardEntry> get_round_top() const;
+    std::vector<LeaderboardEntry> get_daily_top() const;
+    std::vector<LeaderboardEntry> get_all_time_top() const;
+    LeaderboardSnapshot snapshot() const;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct LongPollStats {
+    size_t parked;       // Şu an bekleyen
+    uint64_t woken;      // Versiyon ilerleyince cevaplanan
+    uint64_t timed_out;  // Süre dolunca mevcut durumla cevaplanan
+    uint64_t rejected;   // Kuyruk dolu olduğu için hemen cevaplanan
+};
+
+// ⏳ Versiyonlu long-poll bekleme kuyruğu
+// İstemci bildiği versiyonu (since) gönderir; versiyon farklıysa hemen cevaplanır, aksi halde
+// cevap nesnesi (Waiter, örn. Http::ResponseWriter) burada thread tutmadan bekletilir.
+// Oyun thread'i versiyon değişince bekleyenlerin hepsini tek seferde alıp cevaplar.
+// Versiyon sadece eşitlikle karşılaştırılır: primary yeniden başlayıp sıfırdan sayarsa
+// eski versiyonla gelen istemciler de takılmadan cevap alır.
+// Timeout sabit olduğundan kuyruk deadline sırasındadır; süre dolanlar baştan alınır.
+// Aynı sıra park edilen versiyona göre de sıralıdır: güncel versiyonla bekleyenler hep sondadır.
+template <typename Waiter>
+class LongPollQueue {
+public:
+    LongPollQueue(size_t max_waiters, int64_t timeout_ms)
+        : max_waiters(max_waiters), timeout_ms(timeout_ms), version(0), woken(0), timed_out(0), rejected(0) {}
+
+    // Bekletildiyse waiter taşınır ve true döner; false ise çağıran hemen cevaplamalı
+    bool park(uint64_t since, Waiter& waiter, int64_t now_ms) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (since != version) return false;
+        if (waiters.size() >= max_waiters) {
+            rejected++;
+            return false;
+        }
+        waiters.push_back(Entry{now_ms + timeout_ms, since, std::move(waiter)});
+        return true;
+    }
+
+    // Bayat versiyonla bekleyenleri döndürür. parked_before_ms verilirse sadece o andan önce
+    // park edilenler döner (seyrek yayın); kalanlar versiyon değişmese de sonraki çağrılarda alınır.
+    std::vector<Waiter> advance(uint64_t new_version,
+                                int64_t parked_before_ms = std::numeric_limits<int64_t>::max()) {
+        std::vector<Waiter> ready;
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        version = new_version;
+        while (!waiters.empty() && waiters.front().since != version &&
+               waiters.front().deadline_ms - timeout_ms <= parked_before_ms) {
+            ready.push_back(std::move(waiters.front().waiter));
+            waiters.pop_front();
+        }
+        woken += ready.size();
+        return ready;
+    }
+
+    // Süresi dolanlar mevcut durumla cevaplanır
+    std::vector<Waiter> expire(int64_t now_ms) {
+        std::vector<Waiter> expired;
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        while (!waiters.empty() && waiters.front().deadline_ms <= now_ms) {
+            expired.push_back(std::move(waiters.front().waiter));
+            waiters.pop_front();
+        }
+        timed_out += expired.size();
+        return expired;
+    }
+
+    uint64_t get_version() const {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return version;
+    }
+
+    LongPollStats get_stats() const {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return LongPollStats{waiters.size(), woken, timed_out, rejected};
+    }
+
+private:
+    struct Entry {
+        int64_t deadline_ms;
+        uint64_t since;
+        Waiter waiter;
+    };
+
+    size_t max_waiters;
+    int64_t timeout_ms;
+    mutable std::mutex queue_mutex;
+    std::deque<Entry> waiters;
+    uint64_t version;
+    uint64_t woken;
+    uint64_t timed_out;
+    uint64_t rejected;
+};
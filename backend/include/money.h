@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// 💰 Para birimi: kuruş cinsinden tam sayı (1 TL = 100)
+// Bakiye, bahis ve kazanç hesapları bu tiple yapılır; double sadece JSON sınırında kullanılır.
+using Money = int64_t;
+
+constexpr Money MONEY_SCALE = 100;
+
+inline Money money_from_double(double tl) {
+    return static_cast<Money>(std::llround(tl * MONEY_SCALE));
+}
+
+inline double money_to_double(Money amount) {
+    return static_cast<double>(amount) / MONEY_SCALE;
+}
+
+// Log ve mesajlar için "12.34"
+inline std::string money_to_string(Money amount) {
+    Money whole = std::llabs(amount) / MONEY_SCALE;
+    Money cents = std::llabs(amount) % MONEY_SCALE;
+    return std::string(amount < 0 ? "-" : "") + std::to_string(whole) + "." + (cents < 10 ? "0" : "") + std::to_string(cents);
+}
+
+// Çarpanlar 2 ondalık basamaklıdır; tam sayı olarak *100 tutulur
+inline uint32_t multiplier_to_x100(double multiplier) {
+    return static_cast<uint32_t>(std::llround(multiplier * 100.0));
+}
+
+// Kazanç = bahis * çarpan, kuruşa aşağı yuvarlanır
+inline Money apply_multiplier(Money amount, uint32_t multiplier_x100) {
+    return amount * static_cast<Money>(multiplier_x100) / 100;
+}
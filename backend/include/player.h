@@ -1,22 +1,36 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include "money.h"
 
+// Bakiye işlemleri kilitsizdir: düşme CAS ile koşullu, ekleme fetch_add ile yapılır.
+// Aynı oyuncuya eşzamanlı bahis ve bakiye yükleme gelse de tutarlı kalır.
 class Player {
 private:
     std::string player_id;
     std::string name;
-    double balance;
+    std::atomic<Money> balance;
+    std::atomic<Money> total_winnings;  // Tüm zamanlar liderlik tablosu için
+    std::atomic<int64_t> last_activity_ms;  // Boşta kalan oturumların süresi dolar (steady clock)
     
 public:
-    Player(const std::string& id, const std::string& player_name, double initial_balance = 1000.0);
+    static constexpr Money STARTING_BALANCE = 1000 * MONEY_SCALE;
+
+    Player(const std::string& id, const std::string& player_name, Money initial_balance = STARTING_BALANCE,
+           Money initial_winnings = 0);  // initial_winnings: süreç devrinde (handoff) aktarılan toplam
     
     // Getter'lar
     std::string get_id() const;
     std::string get_name() const;
-    double get_balance() const;
+    Money get_balance() const;
+    Money get_total_winnings() const;
+    int64_t get_last_activity_ms() const;
     
     // Balance işlemleri
-    bool deduct_balance(double amount);
-    void add_balance(double amount);
-};
\ No newline at end of file
+    bool deduct_balance(Money amount);
+    void add_balance(Money amount);
+    void add_winnings(Money amount);  // Bakiyeye ekler ve kazanç toplamını günceller
+    
+    void touch(int64_t now_ms);
+};
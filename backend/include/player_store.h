@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "money.h"
+
+// 💤 Oturumu kapanan oyuncuların sayfalandığı kayıt - diskte 24 byte başlık + id + isim
+struct DormantRecordHeader {
+    int64_t balance;         // Kuruş
+    int64_t total_winnings;  // Kuruş
+    uint16_t id_size;
+    uint16_t name_size;
+    uint8_t live;            // 0: oyuncu geri yüklendi, kayıt ölü
+    uint8_t reserved[3];
+};
+static_assert(sizeof(DormantRecordHeader) == 24, "Uyuyan oyuncu başlığı sabit boyutlu olmalı");
+
+struct DormantPlayer {
+    std::string player_id;
+    std::string name;
+    Money balance = 0;
+    Money total_winnings = 0;
+};
+
+// Boşta kalan oyuncular bellekten atılınca bakiye / kazançları burada bekler; tekrar
+// katıldıklarında veya id'leriyle sorulduklarında geri yüklenir (take).
+// Kayıtlar dosyaya eklenir, geri yüklenen kaydın live byte'ı sıfırlanır. Bellekte sadece
+// id ve isim hash'inden kayıt offset'ine index tutulur; eşleşme kayıt okunarak doğrulanır.
+// Ölü kayıtlar canlılardan fazlalaşınca dosya yeniden yazılır.
+// path boşsa kayıtlar bellekte tutulur (testler ve replay için). resume false ise dosya
+// boşaltılır: soğuk başlangıçta bellekteki oyuncular da kaybolur, günlük START'tan başlar.
+class PlayerStore {
+private:
+    std::string path;
+    int fd;
+    std::string memory;  // path boşsa dosyanın yerine
+    uint64_t end_offset;
+    uint64_t live_bytes;
+    uint64_t dead_bytes;
+    std::unordered_multimap<uint64_t, uint64_t> by_id;    // hash(id) -> offset
+    std::unordered_multimap<uint64_t, uint64_t> by_name;  // hash(isim) -> offset
+    mutable std::mutex store_mutex;
+
+    void load();
+    void index_record(const DormantPlayer& player, uint64_t offset, uint64_t size);
+    bool read_record(uint64_t offset, DormantRecordHeader& header, DormantPlayer& out) const;
+    bool find_locked(std::string_view player_id, uint64_t& offset, DormantPlayer& out) const;
+    void write_at(uint64_t offset, const char* data, size_t size);
+    void kill_locked(uint64_t offset, const DormantPlayer& player);
+    void compact_locked();
+
+public:
+    static constexpr uint64_t COMPACT_MIN_DEAD_BYTES = 1024 * 1024;
+
+    explicit PlayerStore(const std::string& file_path = "", bool resume = false);
+    ~PlayerStore();
+    PlayerStore(const PlayerStore&) = delete;
+    PlayerStore& operator=(const PlayerStore&) = delete;
+
+    void put(const DormantPlayer& player);
+    bool take(std::string_view player_id, DormantPlayer& out);  // Bulursa kaydı siler
+    bool credit(std::string_view player_id, Money amount);      // Geri yüklemeden bakiye ekler
+    bool contains(std::string_view player_id) const;
+    bool find_id_by_name(std::string_view name, std::string& player_id) const;
+
+    size_t size() const;
+    uint64_t file_bytes() const;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct RateLimitConfig {
+    double rate_per_sec = 5.0;  // Saniyede dolan token; <= 0 ise limit kapalı
+    double burst = 10.0;        // Kova kapasitesi
+    size_t slots = 65536;       // Kova tablosu boyutu (2'nin kuvvetine yuvarlanır)
+};
+
+// 🪣 Kilitsiz token bucket tablosu
+// Her anahtar (oyuncu / IP) hash ile bir slota düşer. Slot tek bir 64 bit atomik:
+// üst 40 bit son güncelleme zamanı (ms), alt 24 bit harcanan token (1/1000 birim).
+// Sıfır değer "dolu kova" demektir; tablo ilk kullanımda hazırdır.
+class RateLimiter {
+private:
+    static constexpr uint64_t TOKEN_BITS = 24;
+    static constexpr uint64_t TOKEN_MASK = (1ULL << TOKEN_BITS) - 1;
+    static constexpr uint64_t MILLI = 1000;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    size_t slot_mask;
+    double rate_milli_per_ms;
+    uint64_t capacity_milli;
+    bool enabled;
+    int retry_after;
+    std::chrono::steady_clock::time_point epoch;
+
+public:
+    explicit RateLimiter(const RateLimitConfig& config);
+
+    bool try_acquire(const std::string& key);
+    bool try_acquire(const std::string& key, uint64_t now_ms);  // Testler için zaman enjekte edilebilir
+
+    bool is_enabled() const;
+    int get_retry_after_seconds() const;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "response_cache.h"
+#include "server_config.h"
+#include "shm_state.h"
+#include "tick_stream.h"
+#include "long_poll.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <pistache/endpoint.h>
+#include <pistache/http.h>
+#include <pistache/router.h>
+
+using namespace Pistache;
+
+// 🪞 Durumsuz okuma replica'sı
+// Oyun çalıştırmaz; primary'nin paylaşılan belleğe yayınladığı snapshot'tan status,
+// old-crash-points ve tick yayınını sunar. Birden fazla replica aynı read_port'u
+// SO_REUSEPORT ile paylaşır, yazıcıyla hiçbir IPC turu yapılmaz.
+class ReplicaServer {
+private:
+    std::shared_ptr<Http::Endpoint> httpEndpoint;
+    Rest::Router router;
+    ServerConfig config;
+    ShmStateReader reader;
+    ResponseCache response_cache;
+    TickStream tick_stream;
+    std::atomic<bool> running;
+    std::thread stream_thread;
+    LongPollQueue<Http::ResponseWriter> long_poll;
+    
+    // Primary bu süre yayın yapmazsa (çökmüş / yeniden başlıyor) replica 503 döner
+    static const int STALE_AFTER_MS = 2000;
+    
+    void setupRoutes();
+    void stream_loop();
+    void wakeLongPolls(const GameSnapshot& snapshot, int64_t now);
+    bool readSnapshot(GameSnapshot& snapshot);
+    void sendUnavailable(Http::ResponseWriter& response);
+    
+    void getGameStatus(const Rest::Request& request, Http::ResponseWriter response);
+    void getOldCrashPoints(const Rest::Request& request, Http::ResponseWriter response);
+    void handleOptions(const Rest::Request& request, Http::ResponseWriter response);
+    
+public:
+    ReplicaServer(Address address, const ServerConfig& server_config);
+    ~ReplicaServer();
+    
+    void start();
+    void stop();
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "compression.h"
+
+// 📦 Versiyon bazlı cevap önbelleği
+// Aynı versiyon için body bir kez serialize edilir, ETag ile birlikte saklanır.
+// Sıkıştırılmış halleri ilk isteyen için bir kez üretilir, sonra herkes paylaşır.
+struct CachedResponse {
+    uint64_t version = 0;
+    std::string etag;
+    std::string body;
+
+    // Küçük body'ler için IDENTITY döner
+    ContentCoding effective_coding(ContentCoding requested) const;
+    const std::string& encoded_body(ContentCoding coding) const;
+    std::string encoded_etag(ContentCoding coding) const;
+
+private:
+    mutable std::once_flag gzip_once;
+    mutable std::once_flag deflate_once;
+    mutable std::string gzip_body;
+    mutable std::string deflate_body;
+};
+
+class ResponseCache {
+private:
+    std::map<std::string, std::shared_ptr<const CachedResponse>> entries;
+    mutable std::mutex cache_mutex;
+    // Process yeniden başladığında versiyonlar sıfırlanır; eski ETag'ler eşleşmesin diye
+    std::string instance_tag;
+
+public:
+    ResponseCache();
+
+    // Aynı versiyon için kayıt varsa döndürür, yoksa nullptr
+    std::shared_ptr<const CachedResponse> get(const std::string& key, uint64_t version) const;
+    std::shared_ptr<const CachedResponse> put(const std::string& key, uint64_t version, std::string body);
+
+    std::string make_etag(const std::string& key, uint64_t version) const;
+
+    // If-None-Match başlığı verilen ETag ile eşleşiyor mu? ("*", liste ve W/ desteklenir)
+    static bool etag_matches(const std::string& if_none_match, const std::string& etag);
+};
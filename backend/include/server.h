@@ -1,6 +1,27 @@
 #pragma once
 
 #include "game.h"
+#include "response_cache.h"
+#include "rate_limiter.h"
+#include "server_config.h"
+#include "work_dispatcher.h"
+#include "tick_stream.h"
+#include "websocket_gateway.h"
+#include "http_helpers.h"
+#include "shm_state.h"
+#include "synthetic_players.h"
+#include "trace.h"
+#include "long_poll.h"
+#include "tick_policy.h"
+#include "idempotency_cache.h"
+#include "static_assets.h"
+#include "balance_import.h"
+#include "settlement_export.h"
+#include "handoff.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <memory>
@@ -12,14 +33,62 @@ using namespace Pistache;
 
 class CrashGameServer {
 private:
+    Address listen_address;
     std::shared_ptr<Http::Endpoint> httpEndpoint;
     Rest::Router router;
     CrashGame game;
-    bool running;
+    std::atomic<bool> running;
+    std::mutex lifecycle_mutex;
+    std::condition_variable lifecycle_cv;  // start() stop'a kadar bekler
     std::thread game_thread;
+    std::thread chain_thread;  // Hash zincirini üretir / doğrular, sonra oyuna bağlar
+    std::thread handoff_thread;  // CRASH_HANDOFF_SOCKET: ardıl süreci bekler, durumu devreder
+    std::atomic<bool> handoff_requested{false};  // Uçan round bitince oyun döngüsü durur
+    std::atomic<bool> game_frozen{false};
+    std::atomic<bool> handoff_draining{false};  // Cevaplar Connection: close taşır, long-poll park edilmez
+    std::atomic<int> http_in_flight{0};         // Kuyruğa girmiş veya işlenen HTTP istekleri
+    ResponseCache response_cache;
+    ServerConfig config;
+    RateLimiter player_limiter;
+    RateLimiter ip_limiter;
+    WorkDispatcher dispatcher;
+    WorkDispatcher export_dispatcher;  // Uzun süren dışa aktarımlar handler worker'larını tutmasın
+    WorkDispatcher import_dispatcher;  // Toplu bakiye parçaları da komut kuyruğunu tıkamasın
+    BalanceImportUploads import_uploads;
+    TickStream tick_stream;
+    WebSocketGateway websocket;  // Oturum başına tek bağlantı: tick, bakiye ve komutlar
+    std::unique_ptr<ShmStatePublisher> state_publisher;  // Replica'lar için
+    LatestSnapshot latest_snapshot;                      // Status cevapları (long-poll versiyonuyla aynı)
+    std::unique_ptr<SyntheticPlayers> synthetic_players;  // Sadece kapasite testinde
+    TickPolicy tick_policy;
+    LongPollQueue<Http::ResponseWriter> long_poll;        // status?since= bekleyen bahisçiler (tam hız)
+    LongPollQueue<Http::ResponseWriter> spectator_poll;   // Bahsi olmayanlar (seyreltilmiş)
+    IdempotencyCache idempotency_cache;                   // Bahis / cashout tekrarları
+    StaticAssets static_assets;                           // CRASH_STATIC_DIR (boşsa kapalı)
     
+    void createEndpoint();
     void setupRoutes();
+    void setupWebSocket();
     void game_loop();
+    void tick();
+    void wakeLongPolls(const GameSnapshot& snapshot, GamePhase phase);
+    void flushLongPolls(bool close_connection);  // Devir: bekleyen tüm long-poll'lar hemen cevaplanır
+    void writeTraceDump();
+    void prepareHashChain();
+    void attachStores(bool resumed);  // Geçmiş, günlük ve paylaşılan bellek (devirde durumdan sonra)
+    
+    // Süreç devri (handoff.h): eski taraf durumu verir ve çıkar, yeni taraf devralır
+    void handoffLoop();
+    bool handOff(int successor_fd);            // false: devir olmadı, bu süreç oynamaya devam ediyor
+    bool resumeAfterHandoff(size_t retired, int websocket_fd);
+    void takeOver(int predecessor_fd, int& tick_fd, int& websocket_fd);
+    
+    // Handler'ı öncelikli kuyruk üzerinden çalıştıran route sarmalayıcı
+    using RequestHandler = void (CrashGameServer::*)(const Rest::Request&, Http::ResponseWriter);
+    Rest::Route::Handler queued(const char* trace_name, WorkPriority priority, RequestHandler handler, bool rate_limited = false);
+    Rest::Route::Handler queuedOn(WorkDispatcher& target, const char* trace_name, WorkPriority priority,
+                                  RequestHandler handler, bool rate_limited);
+    void sendOverloaded(Http::ResponseWriter& response);
     
     // REST endpoint handlers
     void getGameStatus(const Rest::Request& request, Http::ResponseWriter response);
@@ -27,17 +96,38 @@ private:
     void placeBet(const Rest::Request& request, Http::ResponseWriter response);
     void cashout(const Rest::Request& request, Http::ResponseWriter response);
     void loadBalance(const Rest::Request& request, Http::ResponseWriter response);
+    void importBalances(const Rest::Request& request, Http::ResponseWriter response);
+    void exportSettlements(const Rest::Request& request, Http::ResponseWriter response);
     void getPlayersInfo(const Rest::Request& request, Http::ResponseWriter response);
     void bringBeko(const Rest::Request& request, Http::ResponseWriter response);
     void handleOptions(const Rest::Request& request, Http::ResponseWriter response);
-    void enableCors(Http::ResponseWriter& response);
     void getActiveBets(const Rest::Request& request, Http::ResponseWriter response);
     void getOldCrashPoints(const Rest::Request& request, Http::ResponseWriter response);
+    void getMetrics(const Rest::Request& request, Http::ResponseWriter response);
+    void getExposure(const Rest::Request& request, Http::ResponseWriter response);
+    void getTrace(const Rest::Request& request, Http::ResponseWriter response);
+    void getFairness(const Rest::Request& request, Http::ResponseWriter response);
+    void verifyRound(const Rest::Request& request, Http::ResponseWriter response);
+    void serveStatic(const Rest::Request& request, Http::ResponseWriter response);
+    void getLeaderboard(const Rest::Request& request, Http::ResponseWriter response);
+    void getBetHistory(const Rest::Request& request, Http::ResponseWriter response);
+    void binaryCommand(const Rest::Request& request, Http::ResponseWriter response);
+    
+    // Bahis / cashout için token bucket kontrolü (JSON parse'tan önce)
+    std::string getClientAddress(const Rest::Request& request) const;
+    bool admitMutation(const Rest::Request& request, Http::ResponseWriter& response);
+    
+    // Idempotency-Key varsa aynı (oyuncu, anahtar) ile gelen tekrar action'ı çalıştırmadan ilk
+    // sonucu alır. false: cevap burada gönderildi (geçersiz anahtar, ilk istek sürüyor, farklı içerik)
+    bool runIdempotent(const Rest::Request& request, const std::string& playerId, uint64_t fingerprint,
+                       Http::ResponseWriter& response, const std::function<bool()>& action, bool& success);
     
 public:
-    CrashGameServer(Address address);
+    CrashGameServer(Address address, const ServerConfig& server_config = ServerConfig());
     ~CrashGameServer();
     
-    void start();
+    // predecessor_fd: handoff::connect ile bağlanılan çalışan süreç (-1: soğuk başlangıç).
+    // stop() çağrılana veya durum ardıla devredilene kadar döner.
+    void start(int predecessor_fd = -1);
     void stop();
 };
\ No newline at end of file
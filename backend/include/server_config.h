@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include "rate_limiter.h"
+#include "work_dispatcher.h"
+#include "synthetic_players.h"
+#include "tick_policy.h"
+#include "idempotency_cache.h"
+#include "hash_chain.h"
+
+// ⚙️ Sunucu ayarları - ortam değişkenlerinden okunur (CRASH_*)
+struct ServerConfig {
+    int port = 5050;
+    int http_threads = 2;
+    
+    // İstek gövdesi üst sınırı. Pistache gövdeyi handler'dan önce tamamen belleğe alır; büyük
+    // bakiye dosyaları da bu sınırı aşmayan parçalarla yüklenir
+    int max_request_bytes = 64 * 1024;
+    
+    // Bahis / cashout için istek limitleri
+    RateLimitConfig player_rate_limit{5.0, 10.0, 65536};
+    RateLimitConfig ip_rate_limit{50.0, 100.0, 65536};
+    
+    // Handler kuyrukları ve yük atma eşikleri
+    DispatcherConfig dispatcher;
+    
+    // Settle edilen bahislerin yazıldığı dosya; boşsa sadece bellekte tutulur
+    std::string history_path = "bet_history.bin";
+    
+    // Bu kadar süre istek atmayan ve bahsi olmayan oyuncu bellekten atılır; 0 kapatır
+    int session_ttl_sec = 30 * 60;
+    
+    // Bellekten atılan oyuncuların bakiyelerinin sayfalandığı dosya; boşsa bellekte tutulur.
+    // Soğuk başlangıçta boşaltılır, devirde (handoff) ardıl süreç kaldığı yerden açar
+    std::string player_store_path = "dormant_players.bin";
+    
+    // İkili tick yayını için TCP portu; 0 kapatır (Docker imajında 5052)
+    int tick_stream_port = 0;
+    
+    // Oyuncu WebSocket'i (ws://host:port/ws?player_id=): tick + bakiye aşağı, bahis / cashout yukarı;
+    // 0 kapatır (Docker imajında 5053, nginx /ws'yi buraya yönlendirir)
+    int websocket_port = 0;
+    
+    // "primary": oyunu çalıştırır ve durumu paylaşılan belleğe yayınlar
+    // "replica": sadece okuma uçlarını paylaşılan bellekten sunar (read_port, SO_REUSEPORT)
+    std::string role = "primary";
+    int read_port = 5051;
+    std::string shm_name;  // Boşsa primary yayın yapmaz, replica başlamaz (Docker imajında "/crash_game_state")
+    
+    // Derlenmiş frontend dizini: verilirse API dışındaki GET'ler bellekten sunulur (nginx'siz mod)
+    std::string static_dir;
+    
+    // Settlement dışa aktarımları kendi thread'inde sırayla çalışır; bekleyebilecek istek sayısı
+    int export_queue = 4;
+    
+    // Toplu bakiye parçaları da kendi thread'inde sırayla uygulanır; bekleyebilecek parça sayısı
+    int import_queue = 16;
+    
+    // Provably-fair crash noktaları: mmap'li SHA-256 zinciri; path boşsa RNG
+    HashChainConfig hash_chain;
+    
+    // Bahis / cashout tekrarlarının tanındığı Idempotency-Key tablosu
+    IdempotencyConfig idempotency;
+    
+    // Faza göre oyun döngüsü / yayın aralıkları ve izleyici seyreltmesi
+    TickPolicyConfig tick_policy;
+    
+    // Long-poll status: ?since=<version> ile bekleyen isteklerin süresi ve üst sınırı
+    int longpoll_timeout_ms = 25000;
+    int longpoll_max_waiters = 10000;
+    
+    // Kesintisiz yeniden başlatma: çalışan süreç bu UNIX soketini dinler, açılan yeni süreç
+    // bağlanıp oyun durumunu ve dinleme soketlerini devralır (bkz. handoff.h); boşsa kapalı
+    std::string handoff_socket;
+    // Dinleyici kapandıktan sonra açık keep-alive bağlantıların boşalması için en fazla beklenen süre
+    int handoff_drain_ms = 5000;
+    
+    // Durum değiştiren komutların replay günlüğü; boşsa kapalı
+    std::string journal_path;
+    
+    // İzleme: thread başına halka tampon boyutu (0 kapatır) ve SIGUSR1 döküm dosyası
+    int trace_events = 16384;
+    std::string trace_path = "crash_trace.json";
+    
+    // Kapasite testi: oyun thread'inin sürdüğü sentetik oyuncular
+    SyntheticConfig synthetic;
+    
+    static ServerConfig fromEnv();
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bet_history.h"
+
+// Round numaraları yeniden başlatınca 1'den sayar: uzun aralıklarda zamanla birlikte verin
+struct ExportRange {
+    int64_t from_ms = 0;                                       // Dahil (Unix epoch ms)
+    int64_t to_ms = std::numeric_limits<int64_t>::max();       // Hariç
+    uint32_t from_round = 0;                                   // Dahil
+    uint32_t to_round = std::numeric_limits<uint32_t>::max();  // Dahil
+};
+
+// 🧾 Settlement dışa aktarımı (muhasebe, NDJSON)
+// Bahis geçmişinin round segmentlerinde başlangıç zamanına ikili aramayla atlar, sonra
+// kayıtları sabit boyutlu bir tamponla okuyup satır satır yazar. Bellek satır sayısından
+// bağımsızdır: bir parça (chunk) metni + bir batch kayıt.
+//
+//   {"round":12,"settled_at":1718000000000,"player_id":"p1","player_name":"Ali","amount":10.00,
+//    "status":"cashed_out","cashout_multiplier":2.35,"winnings":23.50}
+//
+// Son satır her zaman dışa aktarımın bütün olup olmadığını söyler; bu satır gelmeyen cevap yarımdır:
+//   {"export":"complete","rows":1234}
+//   {"export":"incomplete","rows":800,"error":"..."}
+class SettlementExporter {
+public:
+    SettlementExporter(const BetHistoryStore& history, const ExportRange& export_range,
+                       size_t chunk_bytes = 256 * 1024, size_t batch_records = 1024);
+
+    // out'u temizleyip yaklaşık chunk_bytes'lık satırla doldurur; kayıt kalmadıysa false
+    bool next_chunk(std::string& out);
+
+    uint64_t get_rows() const;
+    bool is_complete() const;  // Aralığın sonuna kadar okundu (okuma hatasıyla bitmedi)
+
+    static void append_trailer(std::string& out, bool complete, uint64_t rows, std::string_view error = {});
+
+    static void append_record(std::string& out, const BetRecord& record,
+                              std::string_view player_id, std::string_view player_name);
+
+private:
+    const BetHistoryStore& store;
+    ExportRange range;
+    size_t chunk_bytes;
+    std::vector<BetRecord> records;
+    size_t segment_index;
+    uint64_t next_record;  // Mevcut segmentte sıradaki kayıt
+    uint64_t segment_end;
+    uint64_t rows;
+    bool finished;
+    bool complete;
+
+    bool advance_segment();
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// 🪞 Primary'nin her tick'te yayınladığı oyun durumu (POD, process'ler arası paylaşılır)
+// Replica'lar status / old-crash-points / tick yayınını sadece bundan üretir.
+struct GameSnapshot {
+    static constexpr size_t MAX_CRASH_POINTS = 15;
+    
+    uint32_t round;
+    uint32_t multiplier_x100;
+    uint32_t crash_point_x100;   // Sadece crashed fazında, diğerlerinde 0
+    uint32_t remaining_time_ms;  // published_at_ms anındaki değer
+    uint32_t active_bets;
+    uint8_t phase;               // tick_protocol::Phase
+    uint8_t crash_point_count;
+    uint16_t reserved;
+    uint64_t bets_version;
+    uint64_t history_version;
+    int64_t published_at_ms;     // steady clock (CLOCK_MONOTONIC tüm process'lerde ortak)
+    uint32_t crash_points_x100[MAX_CRASH_POINTS];  // Eskiden yeniye
+    uint32_t reserved2;
+    uint64_t status_version;     // Long-poll: /api/game/status?since=<version>
+    int64_t chain_index;         // Uçan / crash olan round'un hash zinciri linki; -1: RNG veya bekleme
+};
+static_assert(sizeof(GameSnapshot) % 8 == 0, "Snapshot 8 byte'lık kelimelere bölünür");
+
+// Paylaşılan bellek düzeni: seqlock sayacı + kelime kelime atomik kopyalanan snapshot.
+// Yazıcı tektir (oyun thread'i); okuyucu sayısı sınırsızdır ve yazıcıyı hiç bekletmez.
+struct ShmStateLayout {
+    static constexpr uint32_t MAGIC = 0x43524153;  // "CRAS"
+    static constexpr uint32_t LAYOUT_VERSION = 3;
+    static constexpr size_t WORDS = sizeof(GameSnapshot) / 8;
+    
+    uint32_t magic;
+    uint32_t layout_version;
+    std::atomic<uint64_t> sequence;  // Tek: yazım sürüyor; 0: henüz yayın yok
+    std::atomic<uint64_t> words[WORDS];
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Paylaşılan bellekte kilitsiz atomik gerekli");
+
+// Primary'nin kendi HTTP thread'leri için son yayınlanan snapshot. Status cevabı buradan
+// üretilir: long-poll kuyruğu da aynı snapshot'ın versiyonuna ilerlediğinden istemcinin
+// döndürülen versiyonla tekrar gelişi park edilir (tick'ler arası canlı versiyon öne geçmez)
+class LatestSnapshot {
+private:
+    mutable std::mutex snapshot_mutex;
+    GameSnapshot snapshot{};
+    bool ready = false;
+    
+public:
+    void store(const GameSnapshot& published) {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        snapshot = published;
+        ready = true;
+    }
+    // İlk tick'ten önce false
+    bool load(GameSnapshot& out) const {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        out = snapshot;
+        return ready;
+    }
+};
+
+// Primary tarafı: segmenti oluşturur, kapanırken siler
+class ShmStatePublisher {
+private:
+    std::string name;
+    ShmStateLayout* layout;
+    
+public:
+    explicit ShmStatePublisher(const std::string& shm_name);
+    ~ShmStatePublisher();
+    ShmStatePublisher(const ShmStatePublisher&) = delete;
+    ShmStatePublisher& operator=(const ShmStatePublisher&) = delete;
+    
+    void publish(const GameSnapshot& snapshot);
+    // Segmenti silmeden bırakır: süreç devrinde (handoff) ardıl aynı ismi kullanır
+    void release();
+};
+
+// Replica tarafı: segment yoksa veya primary henüz yayın yapmadıysa read false döner
+class ShmStateReader {
+private:
+    std::string name;
+    const ShmStateLayout* layout;
+    
+    bool attach();
+    void detach();
+    
+public:
+    explicit ShmStateReader(const std::string& shm_name);
+    ~ShmStateReader();
+    ShmStateReader(const ShmStateReader&) = delete;
+    ShmStateReader& operator=(const ShmStateReader&) = delete;
+    
+    bool read(GameSnapshot& out);
+    
+    // Primary yeniden başlayıp segmenti baştan oluşturduysa eski map bayat kalır
+    bool reattach();
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "response_cache.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct StaticAsset {
+    std::string content_type;
+    std::string cache_control;
+    std::shared_ptr<const CachedResponse> response;  // ETag = içerik hash'i
+};
+
+// 🗂️ Derlenmiş frontend'in bellekten sunulması (nginx'siz tek process modu)
+// Başlangıçta dizindeki tüm dosyalar okunur, içerik hash'iyle ETag alır ve sıkıştırılabilir
+// olanlar önceden gzip/deflate'lenir; istek sırasında disk veya zlib çağrısı yapılmaz.
+// Dosya adında içerik hash'i olanlar (bundle.3f9a2c1d.js) bir yıl, index.html hiç
+// önbelleğe alınmaz; uzantısız bilinmeyen yollar SPA için index.html'e düşer.
+class StaticAssets {
+private:
+    std::unordered_map<std::string, StaticAsset> assets;  // "/assets/x.png" -> içerik
+    const StaticAsset* index;
+    size_t bytes;
+    
+public:
+    StaticAssets();
+    
+    // Dizin yoksa exception atar; yüklenen dosya sayısını döndürür
+    size_t load(const std::string& root);
+    
+    // URL yolu için içerik; bulunamazsa nullptr
+    const StaticAsset* find(std::string_view path) const;
+    
+    size_t size() const;
+    size_t total_bytes() const;
+    
+    static std::string content_type_for(std::string_view path);
+    static bool is_fingerprinted(std::string_view filename);  // ".<en az 8 hex>." içeriyor mu
+};
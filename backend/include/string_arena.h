@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// 🧱 Round ömürlü string arena'sı
+// Bahislerin oyuncu id/isim kopyaları buraya yazılır; round bitince reset() ile tek seferde
+// bırakılır. Bloklar serbest bırakılmaz, sonraki round aynı belleği tekrar kullanır.
+class StringArena {
+private:
+    size_t block_size;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<size_t> block_sizes;
+    size_t current_block;
+    size_t offset;
+    
+public:
+    explicit StringArena(size_t block_bytes = 64 * 1024);
+    
+    // Dönen view arena reset edilene kadar geçerlidir
+    std::string_view store(std::string_view value);
+    void reset();
+    
+    size_t block_count() const;
+    size_t bytes_reserved() const;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "money.h"
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class CrashGame;
+
+struct SyntheticConfig {
+    size_t players = 0;                    // 0: kapalı
+    Money min_bet = 1 * MONEY_SCALE;       // Bahis miktarı log-uniform [min, max]
+    Money max_bet = 100 * MONEY_SCALE;
+    double bet_probability = 1.0;          // Her round bahis yapan oyuncu oranı
+    double cashout_mean = 2.0;             // Hedef çarpan: 1.01 + üstel dağılım, ortalama bu
+    double max_cashout = 10.0;
+    int tick_ms = 50;                      // Oyun döngüsü periyodu (bahisleri WAITING'e yaymak için)
+    uint64_t seed = 42;
+};
+
+struct SyntheticStats {
+    size_t players;
+    uint64_t rounds;
+    uint64_t bets_placed;
+    uint64_t cashouts;
+};
+
+// 🤖 Kapasite testi için süreç içi sentetik oyuncular
+// Oyun thread'inden her tick'te çağrılır ve bahis/cashout'ları doğrudan CrashGame'e verir.
+// Bahisler WAITING süresine yayılır; cashout hedefleri çarpan*100'e göre kovalanır,
+// böylece her tick sadece o tick'te cashout yapacak oyunculara bakılır.
+class SyntheticPlayers {
+private:
+    SyntheticConfig config;
+    std::mt19937_64 rng;
+    std::vector<std::string> player_ids;
+    
+    int current_round;
+    size_t next_to_bet;  // Bu round sıradaki bahis yapacak oyuncu
+    std::vector<std::vector<uint32_t>> cashout_buckets;  // [çarpan*100] -> oyuncu indeksleri
+    size_t next_bucket;
+    
+    // Metrik uçu başka thread'den okur
+    std::atomic<uint64_t> rounds{0};
+    std::atomic<uint64_t> bets_placed{0};
+    std::atomic<uint64_t> cashouts{0};
+    
+    void start_round(int round);
+    void place_bets(CrashGame& game, size_t budget);
+    void cash_out(CrashGame& game, uint32_t multiplier_x100);
+    Money sample_bet();
+    uint32_t sample_cashout_x100();
+    
+public:
+    explicit SyntheticPlayers(const SyntheticConfig& synthetic_config);
+    
+    // Oyuncuları ekler ve bahis başına log'u kapatır
+    void attach(CrashGame& game);
+    void on_tick(CrashGame& game);
+    
+    SyntheticStats get_stats() const;
+};
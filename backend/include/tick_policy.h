@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+enum class GamePhase;
+
+struct TickPolicyConfig {
+    int waiting_tick_ms = 1000;       // Geri sayım için saniyede bir yeter
+    int flying_tick_ms = 50;          // Çarpan ve cashout'lar tam çözünürlük ister
+    int crashed_tick_ms = 250;
+    int spectator_interval_ms = 250;  // FLYING'de bahsi olmayan long-poll istemcilerine en sık cevap
+};
+
+struct TickPolicyStats {
+    uint64_t waiting_ticks;
+    uint64_t flying_ticks;
+    uint64_t crashed_ticks;
+};
+
+// ⏱️ Faza ve dinleyiciye göre tick / yayın aralığı
+// Oyun döngüsü her tick'ten sonra next_tick_ms kadar uyur. Aralık fazın ayarıdır ama faz
+// bitişini kaçırmamak için kalan süreye kırpılır; WAITING → FLYING geçişi gecikmez.
+// Tick stream, paylaşılan bellek ve long-poll yayını tick'e bağlı olduğundan onlar da seyrekleşir.
+class TickPolicy {
+private:
+    TickPolicyConfig config;
+    std::atomic<uint64_t> waiting_ticks{0};
+    std::atomic<uint64_t> flying_ticks{0};
+    std::atomic<uint64_t> crashed_ticks{0};
+    
+public:
+    explicit TickPolicy(const TickPolicyConfig& policy_config = TickPolicyConfig());
+    
+    // Tick'i sayar ve bir sonraki tick'e kadar beklenecek süreyi döndürür (>= 1)
+    int next_tick_ms(GamePhase phase, int remaining_time_ms);
+    
+    // Seyrek yayın: bu andan önce park etmiş izleyiciler cevaplanabilir
+    int64_t spectator_cutoff_ms(GamePhase phase, int64_t now_ms) const;
+    
+    const TickPolicyConfig& get_config() const;
+    TickPolicyStats get_stats() const;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 📡 Bot'lar için sabit düzenli ikili tick protokolü
+// Bu header bağımsızdır (sadece standart kütüphane); istemciler doğrudan kopyalayıp kullanabilir.
+// Tüm sayılar little-endian. Alan düzeni README'deki "İkili Tick Protokolü" bölümündedir.
+//
+// TICK (32 byte):
+//   0  u8  type = 1          1  u8  version = 1
+//   2  u8  phase (0 waiting, 1 flying, 2 crashed)   3  u8  reserved
+//   4  u32 round             8  u32 multiplier_x100
+//   12 u32 crash_point_x100 (sadece crashed'de, diğer fazlarda 0)
+//   16 u32 remaining_time_ms 20 u32 active_bets
+//   24 i64 timestamp_ms (unix epoch)
+//
+// BET (12 + n byte):   0 u8 type = 2, 1 u8 version, 2 u8 n (player_id uzunluğu), 3 u8 reserved,
+//                      4 i64 amount (kuruş), 12 player_id[n]
+// CASHOUT (4 + n byte): 0 u8 type = 3, 1 u8 version, 2 u8 n, 3 u8 reserved, 4 player_id[n]
+// ACK (12 byte):       0 u8 type = 4, 1 u8 version, 2 u8 ok (0/1), 3 u8 reserved, 4 i64 balance (kuruş)
+// BALANCE (12 byte):   0 u8 type = 5, 1 u8 version, 2 u16 reserved, 4 i64 balance (kuruş) - WebSocket'te settlement sonrası
+namespace tick_protocol {
+
+constexpr uint8_t VERSION = 1;
+constexpr const char* CONTENT_TYPE = "application/x-crash-tick";
+
+enum class MessageType : uint8_t {
+    TICK = 1,
+    BET = 2,
+    CASHOUT = 3,
+    ACK = 4,
+    BALANCE = 5
+};
+
+enum class Phase : uint8_t {
+    WAITING = 0,
+    FLYING = 1,
+    CRASHED = 2
+};
+
+constexpr size_t TICK_SIZE = 32;
+constexpr size_t COMMAND_HEADER_SIZE = 4;
+constexpr size_t BET_HEADER_SIZE = 12;
+constexpr size_t ACK_SIZE = 12;
+constexpr size_t BALANCE_SIZE = 12;
+constexpr size_t MAX_PLAYER_ID = 255;
+
+struct Tick {
+    uint32_t round = 0;
+    Phase phase = Phase::WAITING;
+    uint32_t multiplier_x100 = 100;
+    uint32_t crash_point_x100 = 0;
+    uint32_t remaining_time_ms = 0;
+    uint32_t active_bets = 0;
+    int64_t timestamp_ms = 0;
+};
+
+// BET veya CASHOUT; player_id decode edilen tamponu gösterir
+struct Command {
+    MessageType type = MessageType::BET;
+    std::string_view player_id;
+    int64_t amount = 0;  // Sadece BET
+};
+
+namespace detail {
+
+inline void put_u32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline void put_u64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline uint32_t get_u32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+inline uint64_t get_u64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+inline void put_header(uint8_t* out, MessageType type, uint8_t arg) {
+    out[0] = static_cast<uint8_t>(type);
+    out[1] = VERSION;
+    out[2] = arg;
+    out[3] = 0;
+}
+
+}  // namespace detail
+
+inline void encode_tick(const Tick& tick, uint8_t* out) {
+    detail::put_header(out, MessageType::TICK, static_cast<uint8_t>(tick.phase));
+    detail::put_u32(out + 4, tick.round);
+    detail::put_u32(out + 8, tick.multiplier_x100);
+    detail::put_u32(out + 12, tick.crash_point_x100);
+    detail::put_u32(out + 16, tick.remaining_time_ms);
+    detail::put_u32(out + 20, tick.active_bets);
+    detail::put_u64(out + 24, static_cast<uint64_t>(tick.timestamp_ms));
+}
+
+inline bool decode_tick(const uint8_t* in, size_t size, Tick& tick) {
+    if (size < TICK_SIZE || in[0] != static_cast<uint8_t>(MessageType::TICK) || in[1] != VERSION) return false;
+    if (in[2] > static_cast<uint8_t>(Phase::CRASHED)) return false;
+    tick.phase = static_cast<Phase>(in[2]);
+    tick.round = detail::get_u32(in + 4);
+    tick.multiplier_x100 = detail::get_u32(in + 8);
+    tick.crash_point_x100 = detail::get_u32(in + 12);
+    tick.remaining_time_ms = detail::get_u32(in + 16);
+    tick.active_bets = detail::get_u32(in + 20);
+    tick.timestamp_ms = static_cast<int64_t>(detail::get_u64(in + 24));
+    return true;
+}
+
+inline std::string encode_bet(std::string_view player_id, int64_t amount) {
+    if (player_id.size() > MAX_PLAYER_ID) return "";
+    std::string out(BET_HEADER_SIZE + player_id.size(), '\0');
+    uint8_t* data = reinterpret_cast<uint8_t*>(&out[0]);
+    detail::put_header(data, MessageType::BET, static_cast<uint8_t>(player_id.size()));
+    detail::put_u64(data + 4, static_cast<uint64_t>(amount));
+    out.replace(BET_HEADER_SIZE, player_id.size(), player_id.data(), player_id.size());
+    return out;
+}
+
+inline std::string encode_cashout(std::string_view player_id) {
+    if (player_id.size() > MAX_PLAYER_ID) return "";
+    std::string out(COMMAND_HEADER_SIZE + player_id.size(), '\0');
+    detail::put_header(reinterpret_cast<uint8_t*>(&out[0]), MessageType::CASHOUT, static_cast<uint8_t>(player_id.size()));
+    out.replace(COMMAND_HEADER_SIZE, player_id.size(), player_id.data(), player_id.size());
+    return out;
+}
+
+// Boyut tam tutmalı; eksik veya fazla byte'lı komutlar reddedilir
+inline bool decode_command(const uint8_t* in, size_t size, Command& command) {
+    if (size < COMMAND_HEADER_SIZE || in[1] != VERSION) return false;
+    size_t id_size = in[2];
+    if (id_size == 0) return false;
+
+    if (in[0] == static_cast<uint8_t>(MessageType::BET)) {
+        if (size != BET_HEADER_SIZE + id_size) return false;
+        command.type = MessageType::BET;
+        command.amount = static_cast<int64_t>(detail::get_u64(in + 4));
+        command.player_id = std::string_view(reinterpret_cast<const char*>(in + BET_HEADER_SIZE), id_size);
+        return true;
+    }
+    if (in[0] == static_cast<uint8_t>(MessageType::CASHOUT)) {
+        if (size != COMMAND_HEADER_SIZE + id_size) return false;
+        command.type = MessageType::CASHOUT;
+        command.amount = 0;
+        command.player_id = std::string_view(reinterpret_cast<const char*>(in + COMMAND_HEADER_SIZE), id_size);
+        return true;
+    }
+    return false;
+}
+
+inline void encode_ack(bool ok, int64_t balance, uint8_t* out) {
+    detail::put_header(out, MessageType::ACK, ok ? 1 : 0);
+    detail::put_u64(out + 4, static_cast<uint64_t>(balance));
+}
+
+inline bool decode_ack(const uint8_t* in, size_t size, bool& ok, int64_t& balance) {
+    if (size < ACK_SIZE || in[0] != static_cast<uint8_t>(MessageType::ACK) || in[1] != VERSION) return false;
+    ok = in[2] != 0;
+    balance = static_cast<int64_t>(detail::get_u64(in + 4));
+    return true;
+}
+
+inline void encode_balance(int64_t balance, uint8_t* out) {
+    detail::put_header(out, MessageType::BALANCE, 0);
+    detail::put_u64(out + 4, static_cast<uint64_t>(balance));
+}
+
+inline bool decode_balance(const uint8_t* in, size_t size, int64_t& balance) {
+    if (size < BALANCE_SIZE || in[0] != static_cast<uint8_t>(MessageType::BALANCE) || in[1] != VERSION) return false;
+    balance = static_cast<int64_t>(detail::get_u64(in + 4));
+    return true;
+}
+
+}  // namespace tick_protocol
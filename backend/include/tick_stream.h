@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct TickStreamStats {
+    size_t clients;
+    uint64_t connections;
+    uint64_t frames_sent;
+    uint64_t frames_dropped;  // Soket tamponu dolu olan yavaş istemciler için atlanan tick'ler
+    uint64_t refused;         // fd sınırında (EMFILE / ENFILE) kabul edilip hemen kapatılan bağlantılar
+};
+
+// 📡 İkili tick yayını için ayrı TCP portu
+// Bağlanan her istemciye oyun döngüsünün her tick'inde 32 byte'lık bir TICK çerçevesi gönderilir.
+// Tek yönlüdür; istemciden gelen veri okunup atılır. Bağlantılar kendi epoll thread'inde kabul edilir,
+// publish oyun thread'inden bloklamadan yazar: tampon doluysa o tick o istemci için atlanır.
+class TickStream {
+private:
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    // fd sınırında bekleyen bağlantı kabul edilip kapatılsın diye ayrılan yedek fd. O da
+    // alınamazsa dinleyici epoll'dan çıkarılır ve bir süre sonra geri eklenir
+    int reserve_fd;
+    bool listener_paused;  // Sadece loop thread'i
+    uint16_t port;
+    std::thread loop_thread;
+    
+    // clients sadece loop thread'inde kapatılır; publish aynı kilit altında yazar
+    std::mutex clients_mutex;
+    std::vector<int> clients;
+    std::string last_frame;  // Yeni bağlanan hemen son durumu alır
+    
+    std::atomic<uint64_t> connections{0};
+    std::atomic<uint64_t> frames_sent{0};
+    std::atomic<uint64_t> frames_dropped{0};
+    std::atomic<uint64_t> refused{0};
+    
+    void event_loop();
+    void accept_clients();
+    bool shed_connection();
+    void remove_client(int fd);
+    
+public:
+    TickStream();
+    ~TickStream();
+    
+    // port 0: çekirdek boş bir port seçer (get_port ile okunur). Bind hatasında exception atar.
+    void start(uint16_t listen_port);
+    // Süreç devrinde (handoff) SCM_RIGHTS ile gelen dinleme soketiyle başlar; kuyruktaki bağlantılar korunur
+    void start_on(int listening_fd);
+    void stop();
+    
+    void publish(const uint8_t* frame, size_t size);
+    
+    uint16_t get_port() const;
+    int get_listen_fd() const;  // Devir için; stop() kapatır
+    TickStreamStats get_stats();
+};
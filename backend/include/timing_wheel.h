@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ⏱️ Hiyerarşik zamanlama çarkı
+// Her seviye 64 slot; seviye 0 tek tick, seviye 1 64 tick, seviye 2 4096 tick... kapsar.
+// schedule O(1), her tick'te sadece o anki slot işlenir. Üst seviyelerdeki kayıtlar
+// alt seviyeye "dökülür" (cascade) ve zamanı gelince callback'e verilir.
+// Thread-safe değildir; tek bir thread'den (oyun döngüsü) kullanılmalıdır.
+template <typename T>
+class TimingWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr size_t LEVELS = 4;  // 64^4 tick'e kadar
+
+    explicit TimingWheel(uint64_t start_tick = 0) : current_tick(start_tick), count(0) {}
+
+    // Geçmiş bir deadline bir sonraki tick'te tetiklenir; kapsam dışı olanlar en üst seviyeye sıkıştırılır
+    void schedule(T value, uint64_t deadline_tick) {
+        if (deadline_tick <= current_tick) deadline_tick = current_tick + 1;
+        place(Entry{std::move(value), deadline_tick});
+        count++;
+    }
+
+    // now_tick'e kadar ilerler, süresi dolan her kayıt için on_expire(T&&) çağırır.
+    // Callback içinden schedule çağrılabilir.
+    template <typename F>
+    void advance(uint64_t now_tick, F&& on_expire) {
+        while (current_tick < now_tick) {
+            current_tick++;
+            cascade();
+
+            auto& slot = wheels[0][current_tick & (SLOTS - 1)];
+            if (slot.empty()) continue;
+            std::vector<Entry> due;
+            due.swap(slot);
+            count -= due.size();
+            for (auto& entry : due) {
+                on_expire(std::move(entry.value));
+            }
+            // Slot vektörünün kapasitesini geri ver; sonraki turda yeniden büyümesin
+            if (slot.empty()) {
+                due.clear();
+                slot.swap(due);
+            }
+        }
+    }
+
+    uint64_t get_current_tick() const { return current_tick; }
+    size_t size() const { return count; }
+
+private:
+    struct Entry {
+        T value;
+        uint64_t deadline;
+    };
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> wheels;
+    uint64_t current_tick;
+    size_t count;
+
+    void place(Entry entry) {
+        uint64_t delta = entry.deadline - current_tick;
+        for (size_t level = 0; level < LEVELS; level++) {
+            if (delta < (uint64_t(1) << (SLOT_BITS * (level + 1))) || level == LEVELS - 1) {
+                uint64_t deadline = entry.deadline;
+                if (level == LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * LEVELS))) {
+                    // Çarkın kapsamından uzak: en uzak slota koy, dökülünce tekrar yerleştirilir
+                    deadline = current_tick + (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+                }
+                size_t slot = (deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+                wheels[level][slot].push_back(std::move(entry));
+                return;
+            }
+        }
+    }
+
+    // Alt seviye tam tur attığında üst seviyenin sıradaki slotunu aşağı dök
+    void cascade() {
+        for (size_t level = 1; level < LEVELS; level++) {
+            if ((current_tick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) return;
+            auto& slot = wheels[level][(current_tick >> (SLOT_BITS * level)) & (SLOTS - 1)];
+            std::vector<Entry> moving;
+            moving.swap(slot);
+            for (auto& entry : moving) {
+                place(std::move(entry));
+            }
+        }
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 🔬 Tick seviyesinde izleme (Chrome / Perfetto trace-event JSON)
+// Her thread kendi sabit boyutlu halka tamponuna span yazar; yazma kilitsizdir ve
+// izleme kapalıyken bir atomic okumadan ibarettir. Dökümde tamponlar seqlock gibi
+// okunur: okuma sırasında üzerine yazılan olaylar atılır. Sıralama olay alanlarının
+// release yazısı / acquire okuması eşleşmesine dayanır (slot başına sayaç yok), her mimaride
+// geçerlidir: x86-64'te sıradan mov, AArch64'te stlr / ldar. ThreadSanitizer da bunu modeller.
+//
+//   void CrashGame::end_game() {
+//       TRACE_SPAN("game.end_game");
+//       ...
+//
+// Span isimleri statik ömürlü olmalı (string literal).
+namespace trace {
+
+// Thread başına olay sayısı (2'nin kuvvetine yuvarlanır); 0 izlemeyi kapatır.
+// Sadece thread'ler span yazmaya başlamadan önce değiştirilmelidir.
+void configure(size_t events_per_thread);
+
+namespace detail {
+extern std::atomic<size_t> capacity;
+}
+
+inline bool enabled() {
+    return detail::capacity.load(std::memory_order_relaxed) != 0;
+}
+
+int64_t now_ns();
+
+// Tamamlanmış bir span ekler (örn. kuyrukta bekleme süresi)
+void record(const char* name, int64_t begin_ns, int64_t end_ns);
+
+// Dökümde thread'in görünen adı ("game", "worker-0", ...)
+void set_thread_name(const char* name);
+
+// Tüm tamponlar: {"traceEvents": [...], "displayTimeUnit": "ms"}
+std::string dump_json();
+
+// Sinyal handler'ından güvenle çağrılabilir; oyun döngüsü dökümü dosyaya yazar
+void request_dump();
+bool take_dump_request();
+
+class Span {
+private:
+    const char* name;
+    int64_t begin_ns;
+
+public:
+    explicit Span(const char* span_name) : name(span_name), begin_ns(enabled() ? now_ns() : 0) {}
+    ~Span() {
+        if (begin_ns != 0) record(name, begin_ns, now_ns());
+    }
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+
+}  // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) trace::Span TRACE_CONCAT(trace_span_, __LINE__)(name)
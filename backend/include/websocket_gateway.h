@@ -0,0 +1,156 @@
+#pragma once
+
+#include "tick_protocol.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+// 🔌 RFC 6455 çerçeve ve el sıkışma yardımcıları (soketten bağımsız, testlerde doğrudan kullanılır)
+namespace websocket {
+
+enum class Opcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+constexpr size_t MAX_HANDSHAKE = 8192;
+constexpr size_t MAX_MESSAGE = 1024;      // En büyük komut 12 + 255 byte
+constexpr size_t MAX_FRAME_HEADER = 10;   // Sunucu çerçeveleri maskesiz
+
+// Kapanış kodları
+constexpr uint16_t CLOSE_NORMAL = 1000;
+constexpr uint16_t CLOSE_GOING_AWAY = 1001;
+constexpr uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+constexpr uint16_t CLOSE_UNSUPPORTED = 1003;
+constexpr uint16_t CLOSE_INVALID_PAYLOAD = 1007;
+constexpr uint16_t CLOSE_POLICY = 1008;
+constexpr uint16_t CLOSE_TOO_BIG = 1009;
+
+struct Handshake {
+    std::string key;        // Sec-WebSocket-Key
+    std::string player_id;  // ?player_id= (URL-decode edilmiş)
+};
+
+struct Frame {
+    bool fin = true;
+    Opcode opcode = Opcode::BINARY;
+    std::string payload;  // Maskesi çözülmüş
+};
+
+// base64(SHA1(key + GUID))
+std::string accept_key(std::string_view client_key);
+
+// "GET /ws?player_id=... HTTP/1.1" + Upgrade başlıkları. Boş satıra kadar olan kısım verilir.
+bool parse_handshake(std::string_view request, Handshake& handshake);
+std::string handshake_response(std::string_view client_key);
+
+// Sunucu çerçevesi (FIN, maskesiz): out en az size + MAX_FRAME_HEADER byte olmalı; yazılan byte sayısı
+size_t encode_frame(Opcode opcode, const uint8_t* payload, size_t size, uint8_t* out);
+std::string encode_frame(Opcode opcode, std::string_view payload);
+std::string encode_close(uint16_t code);
+
+// İstemci çerçevesi (maskeli olmak zorunda): 0 eksik, > 0 tüketilen byte, < 0 protokol hatası
+// (-CLOSE_* kodu). Yükü max_payload'u aşan çerçeve tamamı gelmeden reddedilir.
+long decode_frame(const uint8_t* in, size_t size, Frame& frame, size_t max_payload = MAX_MESSAGE);
+
+}  // namespace websocket
+
+struct WebSocketStats {
+    size_t sessions;
+    uint64_t connections;
+    uint64_t rejected;        // El sıkışması reddedilen / zaman aşımına uğrayan / fd sınırında kapatılan bağlantılar
+    uint64_t commands;
+    uint64_t frames_sent;
+    uint64_t frames_dropped;  // Tampon dolu olduğu için atlanan tick'ler
+};
+
+// Gateway oyunu bilmez; sunucu bu fonksiyonlarla bağlar. Hepsi gateway thread'inden çağrılır,
+// balance ayrıca publish içinden (oyun thread'i) settlement sonrası çağrılır.
+struct WebSocketHandlers {
+    std::function<bool(const std::string& player_id)> authenticate;
+    // BET / CASHOUT: sonuç ve güncel bakiye
+    std::function<bool(const std::string& player_id, const tick_protocol::Command& command, int64_t& balance)> execute;
+    std::function<int64_t(const std::string& player_id)> balance;
+};
+
+// 🔌 Oyuncu başına tek WebSocket bağlantısı: tick'ler ve bakiye aşağı, bahis / cashout yukarı
+// El sıkışmada bir kez ?player_id= ile oturum oyuncuya bağlanır; sonrasında her ikili mesaj
+// POST /api/game/command ile aynı BET / CASHOUT çerçevesidir ve cevabı ACK çerçevesidir.
+// Komutlar kuyruğa girmeden gateway'in epoll thread'inde çalışır: crash noktasına yakın cashout
+// HTTP isteği, route ve worker sırası beklemez. Tick yayını TickStream gibi bloklamadan yazar.
+class WebSocketGateway {
+public:
+    static constexpr int HANDSHAKE_TIMEOUT_MS = 5000;
+
+private:
+    struct Session {
+        bool upgraded = false;
+        int64_t accepted_at_ms = 0;
+        std::string player_id;
+        std::string inbox;    // Okunmuş ama işlenmemiş byte'lar
+        std::string message;  // Parçalı (FIN=0) binary mesaj birikimi
+        bool in_message = false;
+    };
+
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    int reserve_fd;        // fd sınırında bekleyen bağlantıyı kabul edip kapatmak için (TickStream ile aynı)
+    bool listener_paused;  // Yedek fd de yoksa dinleyici bir sonraki saniyelik turda geri eklenir
+    uint16_t port;
+    std::thread loop_thread;
+    WebSocketHandlers handlers;
+
+    // sessions'a sadece loop thread'i ekler / siler; yazılar (loop ve publish) bu kilit altında
+    std::mutex sessions_mutex;
+    std::unordered_map<int, Session> sessions;
+    size_t upgraded_count;
+    std::string last_tick;  // Çerçevelenmiş son TICK; yeni oturum hemen alır
+    uint8_t last_phase;
+
+    std::atomic<uint64_t> connections{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> commands{0};
+    std::atomic<uint64_t> frames_sent{0};
+    std::atomic<uint64_t> frames_dropped{0};
+
+    void event_loop();
+    void accept_clients();
+    bool shed_connection();
+    void expire_handshakes();
+    void on_readable(int fd);
+    bool handle_handshake(int fd, Session& session);
+    bool handle_frames(int fd, Session& session);
+    bool handle_message(int fd, Session& session, std::string_view message);
+    void send_locked(int fd, const void* data, size_t size);
+    void send_frame(int fd, websocket::Opcode opcode, std::string_view payload);
+    void reject(int fd, const char* status);
+    void send_close(int fd, uint16_t code);
+    void remove_session(int fd);
+
+public:
+    WebSocketGateway();
+    ~WebSocketGateway();
+
+    void set_handlers(WebSocketHandlers session_handlers);
+    // port 0: çekirdek boş bir port seçer. Bind hatasında exception atar.
+    void start(uint16_t listen_port);
+    void start_on(int listening_fd);  // Devirde gelen dinleme soketiyle
+    void stop();
+
+    // Oyun thread'inden her tick: TICK çerçevesi tüm oturumlara; round crash olunca bakiyeler de
+    void publish(const uint8_t* tick, size_t size);
+
+    uint16_t get_port() const;
+    int get_listen_fd() const;
+    WebSocketStats get_stats();
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class WorkPriority {
+    COMMAND,  // Bahis, cashout, join - para ile ilgili, önce işlenir
+    READ      // Status, aktif bahisler - yük altında ilk bunlar reddedilir
+};
+
+struct DispatcherConfig {
+    size_t workers = 2;                // >= 2 ise ilk worker sadece komutlara bakar
+    size_t command_capacity = 1024;
+    size_t read_capacity = 256;
+    size_t read_shed_threshold = 64;   // Komut kuyruğu bu derinliği geçince okumalar reddedilir
+};
+
+struct DispatcherStats {
+    size_t command_depth;
+    size_t read_depth;
+    uint64_t command_accepted;
+    uint64_t command_rejected;
+    uint64_t read_accepted;
+    uint64_t read_rejected;
+};
+
+// 🚦 Öncelikli, sınırlı iş kuyrukları
+// Pistache thread'leri isteği sadece kuyruğa atar; handler'lar buradaki worker'larda çalışır.
+// Kuyruk doluysa submit false döner ve çağıran hemen 503 cevaplar.
+class WorkDispatcher {
+public:
+    using Task = std::function<void()>;
+
+private:
+    DispatcherConfig config;
+    std::deque<Task> command_queue;
+    std::deque<Task> read_queue;
+    mutable std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::vector<std::thread> workers;
+    bool stopping;
+    
+    std::atomic<uint64_t> command_accepted{0};
+    std::atomic<uint64_t> command_rejected{0};
+    std::atomic<uint64_t> read_accepted{0};
+    std::atomic<uint64_t> read_rejected{0};
+    
+    void worker_loop(bool commands_only);
+
+public:
+    explicit WorkDispatcher(const DispatcherConfig& dispatcher_config = DispatcherConfig());
+    ~WorkDispatcher();
+    
+    void start();
+    void stop();  // Kuyruktaki işler bitirilir, sonra worker'lar durur
+    
+    bool submit(WorkPriority priority, Task task);
+    DispatcherStats get_stats() const;
+};
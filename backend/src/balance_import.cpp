@@ -0,0 +1,290 @@
+#include "balance_import.h"
+#include "json_utils.h"
+
+void BalanceImportReport::add_error(uint32_t line, std::string error) {
+    error_count++;
+    if (errors.size() < MAX_ERRORS) {
+        errors.push_back(ImportRowError{line, std::move(error)});
+    }
+}
+
+BalanceImportParser::BalanceImportParser(BalanceImportReport& import_report, BatchHandler handler, size_t size)
+    : report(import_report),
+      on_batch(std::move(handler)),
+      batch_size(size > 0 ? size : 1),
+      format(Format::UNKNOWN),
+      line_number(0),
+      oversized(false) {
+    batch.reserve(batch_size);
+}
+
+void BalanceImportParser::feed(std::string_view chunk) {
+    size_t start = 0;
+    size_t newline = chunk.find('\n');
+    if (newline == std::string_view::npos) {
+        append_partial(chunk);
+        return;
+    }
+    // Önceki parçanın yarım satırı bu parçanın ilk satırıyla tamamlanır
+    if (!partial.empty() || oversized) {
+        append_partial(chunk.substr(0, newline));
+        finish_partial();
+        start = newline + 1;
+        newline = chunk.find('\n', start);
+    }
+
+    while (newline != std::string_view::npos) {
+        parse_line(chunk.substr(start, newline - start));
+        start = newline + 1;
+        newline = chunk.find('\n', start);
+    }
+    append_partial(chunk.substr(start));
+}
+
+void BalanceImportParser::finish() {
+    if (!partial.empty() || oversized) finish_partial();
+    flush();
+}
+
+void BalanceImportParser::append_partial(std::string_view text) {
+    if (oversized) return;
+    if (partial.size() + text.size() > MAX_LINE_BYTES) {
+        oversized = true;
+        partial.clear();
+        partial.shrink_to_fit();
+        return;
+    }
+    partial.append(text.data(), text.size());
+}
+
+void BalanceImportParser::finish_partial() {
+    if (oversized) {
+        line_number++;
+        report.rows++;
+        report.add_error(line_number, "Satır çok uzun");
+        oversized = false;
+    } else {
+        parse_line(partial);
+    }
+    partial.clear();
+}
+
+BalanceImportParser::Format BalanceImportParser::get_format() const {
+    return format;
+}
+
+void BalanceImportParser::parse_line(std::string_view line) {
+    line_number++;
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    size_t first = line.find_first_not_of(" \t");
+    if (first == std::string_view::npos) return;
+
+    bool first_row = format == Format::UNKNOWN;
+    if (first_row) {
+        format = line[first] == '{' ? Format::NDJSON : Format::CSV;
+    }
+    if (format == Format::NDJSON) {
+        parse_ndjson(line);
+        return;
+    }
+
+    std::string name;
+    std::string_view amount_text;
+    std::string error;
+    Money amount = 0;
+    bool valid = parse_csv(line, name, amount_text, error);
+    if (valid && !parse_amount(amount_text, amount)) {
+        // İlk satırda sayı yoksa başlıktır (player_name,amount)
+        if (first_row) return;
+        valid = false;
+        error = "Geçersiz miktar: en fazla 2 ondalıklı pozitif TL";
+    }
+    report.rows++;
+    if (!valid) {
+        report.add_error(line_number, error);
+        return;
+    }
+    add(std::move(name), amount);
+}
+
+bool BalanceImportParser::parse_csv(std::string_view line, std::string& name, std::string_view& amount,
+                                    std::string& error) const {
+    size_t pos = line.find_first_not_of(" \t");
+    if (line[pos] == '"') {
+        // Tırnaklı isim: içindeki "" tek tırnaktır, virgül içerebilir
+        pos++;
+        while (true) {
+            size_t quote = line.find('"', pos);
+            if (quote == std::string_view::npos) {
+                error = "Kapanmayan tırnak";
+                return false;
+            }
+            name.append(line.data() + pos, quote - pos);
+            if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                name += '"';
+                pos = quote + 2;
+                continue;
+            }
+            pos = line.find_first_not_of(" \t", quote + 1);
+            break;
+        }
+        if (pos == std::string_view::npos || line[pos] != ',') {
+            error = "İki sütun gerekli: player_name,amount";
+            return false;
+        }
+    } else {
+        size_t comma = line.find(',', pos);
+        if (comma == std::string_view::npos) {
+            error = "İki sütun gerekli: player_name,amount";
+            return false;
+        }
+        std::string_view field = line.substr(pos, comma - pos);
+        size_t last = field.find_last_not_of(" \t");
+        name.assign(field.data(), last == std::string_view::npos ? 0 : last + 1);
+        pos = comma;
+    }
+
+    amount = line.substr(pos + 1);
+    if (amount.find(',') != std::string_view::npos) {
+        error = "Fazla sütun";
+        return false;
+    }
+    if (name.empty()) {
+        error = "Oyuncu adı boş";
+        return false;
+    }
+    return true;
+}
+
+void BalanceImportParser::parse_ndjson(std::string_view line) {
+    report.rows++;
+    json row = json::parse(line.begin(), line.end(), nullptr, false);
+    if (row.is_discarded() || !row.is_object()) {
+        report.add_error(line_number, "Geçersiz JSON satırı");
+        return;
+    }
+    std::string name = JsonUtils::getString(row, "player_name");
+    Money amount = 0;
+    if (name.empty()) {
+        report.add_error(line_number, "Oyuncu adı boş");
+    } else if (!JsonUtils::getMoney(row, "amount", amount) || amount <= 0) {
+        report.add_error(line_number, "Geçersiz miktar: en fazla 2 ondalıklı pozitif TL");
+    } else {
+        add(std::move(name), amount);
+    }
+}
+
+void BalanceImportParser::add(std::string name, Money amount) {
+    batch.push_back(BalanceCredit{line_number, std::move(name), amount});
+    if (batch.size() >= batch_size) flush();
+}
+
+void BalanceImportParser::flush() {
+    if (batch.empty()) return;
+    on_batch(batch);
+    batch.clear();
+}
+
+bool BalanceImportParser::parse_amount(std::string_view text, Money& out) {
+    // 1e12 TL üstü reddedilir (JsonUtils::getMoney ile aynı sınır)
+    constexpr Money MAX_WHOLE = 1000000000000LL;
+
+    size_t first = text.find_first_not_of(" \t");
+    size_t last = text.find_last_not_of(" \t");
+    if (first == std::string_view::npos) return false;
+    text = text.substr(first, last - first + 1);
+
+    Money whole = 0;
+    size_t i = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+        whole = whole * 10 + (text[i] - '0');
+        if (whole > MAX_WHOLE) return false;
+    }
+    if (i == 0) return false;
+
+    Money cents = 0;
+    if (i < text.size()) {
+        if (text[i] != '.') return false;
+        size_t decimals = text.size() - i - 1;
+        if (decimals == 0 || decimals > 2) return false;
+        for (size_t d = i + 1; d < text.size(); d++) {
+            if (text[d] < '0' || text[d] > '9') return false;
+            cents = cents * 10 + (text[d] - '0');
+        }
+        if (decimals == 1) cents *= 10;
+    }
+
+    out = whole * MONEY_SCALE + cents;
+    return out > 0;
+}
+
+BalanceImportUploads::Upload::Upload(const CreditHandler& on_credits, size_t batch_size)
+    : parser(report, [this, &on_credits](const std::vector<BalanceCredit>& batch) {
+          on_credits(batch, report);
+      }, batch_size) {}
+
+BalanceImportUploads::BalanceImportUploads(CreditHandler handler, size_t uploads_limit,
+                                           int64_t timeout_ms, size_t size)
+    : on_credits(std::move(handler)),
+      max_uploads(uploads_limit > 0 ? uploads_limit : 1),
+      idle_timeout_ms(timeout_ms),
+      batch_size(size) {}
+
+BalanceImportUploads::Progress BalanceImportUploads::feed(const std::string& upload_id, uint32_t part, bool last,
+                                                          std::string_view body, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(uploads_mutex);
+    expire_locked(now_ms);
+
+    Progress progress;
+    auto it = uploads.find(upload_id);
+    if (it == uploads.end()) {
+        if (part != 0) return progress;
+        if (uploads.size() >= max_uploads) {
+            progress.result = Result::TOO_MANY;
+            return progress;
+        }
+        it = uploads.emplace(upload_id, std::make_unique<Upload>(on_credits, batch_size)).first;
+    }
+
+    Upload& upload = *it->second;
+    if (part != upload.next_part) {
+        progress.result = Result::OUT_OF_ORDER;
+        progress.next_part = upload.next_part;
+        return progress;
+    }
+
+    upload.parser.feed(body);
+    upload.next_part++;
+    upload.last_seen_ms = now_ms;
+    progress.next_part = upload.next_part;
+
+    if (last) {
+        upload.parser.finish();
+        progress.result = Result::DONE;
+        progress.report = std::move(upload.report);
+        uploads.erase(it);
+        return progress;
+    }
+
+    progress.result = Result::ACCEPTED;
+    progress.report.rows = upload.report.rows;
+    progress.report.credited = upload.report.credited;
+    progress.report.total = upload.report.total;
+    progress.report.error_count = upload.report.error_count;
+    return progress;
+}
+
+size_t BalanceImportUploads::active() const {
+    std::lock_guard<std::mutex> lock(uploads_mutex);
+    return uploads.size();
+}
+
+void BalanceImportUploads::expire_locked(int64_t now_ms) {
+    for (auto it = uploads.begin(); it != uploads.end();) {
+        if (now_ms - it->second->last_seen_ms > idle_timeout_ms) {
+            it = uploads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
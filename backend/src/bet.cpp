@@ -1,29 +1,33 @@
 #include "bet.h"
 
-Bet::Bet(const std::string& p_id, double bet_amount, int round) 
-    : player_id(p_id), amount(bet_amount), cashout_multiplier(0.0), 
+Bet::Bet(std::string_view p_id, Money bet_amount, int round)
+    : player_id(p_id), amount(bet_amount), cashout_multiplier_x100(0), 
       status(BetStatus::ACTIVE), game_round(round) {
 }
 
-Bet::Bet(const std::string& p_id, double bet_amount, int round,const std::string& p_name)
-    : player_id(p_id), amount(bet_amount), cashout_multiplier(0.0),
+Bet::Bet(std::string_view p_id, Money bet_amount, int round, std::string_view p_name)
+    : player_id(p_id), amount(bet_amount), cashout_multiplier_x100(0),
         status(BetStatus::ACTIVE), game_round(round), player_name(p_name) {
 }
 
-std::string Bet::get_player_id() const {
+std::string_view Bet::get_player_id() const {
     return player_id;
 }
 
-std::string Bet::get_player_name() const {
+std::string_view Bet::get_player_name() const {
     return player_name;
 }
 
-double Bet::get_amount() const {
+Money Bet::get_amount() const {
     return amount;
 }
 
 double Bet::get_cashout_multiplier() const {
-    return cashout_multiplier;
+    return cashout_multiplier_x100 / 100.0;
+}
+
+uint32_t Bet::get_cashout_multiplier_x100() const {
+    return cashout_multiplier_x100;
 }
 
 BetStatus Bet::get_status() const {
@@ -36,7 +40,7 @@ int Bet::get_game_round() const {
 
 bool Bet::cashout(double current_multiplier) {
     if (status == BetStatus::ACTIVE) {
-        cashout_multiplier = current_multiplier;
+        cashout_multiplier_x100 = multiplier_to_x100(current_multiplier);
         status = BetStatus::CASHED_OUT;
         return true;
     }
@@ -49,9 +53,9 @@ void Bet::mark_as_crashed() {
     }
 }
 
-double Bet::calculate_winnings() const {
+Money Bet::calculate_winnings() const {
     if (status == BetStatus::CASHED_OUT) {
-        return amount * cashout_multiplier;
+        return apply_multiplier(amount, cashout_multiplier_x100);
     }
-    return 0.0;
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "bet_history.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+void write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            throw std::runtime_error("Bahis geçmişi yazılamadı: " + std::string(std::strerror(errno)));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// Handle tablosu satır bazlı; ayraç karakterlerini temizle
+std::string sanitize(std::string_view value) {
+    std::string out(value);
+    std::replace(out.begin(), out.end(), '\t', ' ');
+    std::replace(out.begin(), out.end(), '\n', ' ');
+    return out;
+}
+
+}
+
+BetHistoryStore::BetHistoryStore(const std::string& file_path)
+    : path(file_path), records_fd(-1), players_fd(-1), record_count(0) {
+    if (path.empty()) return;
+    
+    records_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    players_fd = ::open((path + ".players").c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (records_fd < 0 || players_fd < 0) {
+        throw std::runtime_error("Bahis geçmişi dosyası açılamadı: " + path);
+    }
+    load();
+}
+
+BetHistoryStore::~BetHistoryStore() {
+    if (records_fd >= 0) ::close(records_fd);
+    if (players_fd >= 0) ::close(players_fd);
+}
+
+void BetHistoryStore::load() {
+    // Oyuncu handle tablosu: her satır "player_id\tname"
+    std::string content;
+    char buffer[65536];
+    ssize_t n;
+    while ((n = ::pread(players_fd, buffer, sizeof(buffer), static_cast<off_t>(content.size()))) > 0) {
+        content.append(buffer, static_cast<size_t>(n));
+    }
+    size_t pos = 0;
+    while (pos < content.size()) {
+        size_t end = content.find('\n', pos);
+        if (end == std::string::npos) break;  // Yarım satır: yazılırken kesilmiş
+        std::string line = content.substr(pos, end - pos);
+        size_t tab = line.find('\t');
+        std::string player_id = line.substr(0, tab);
+        std::string name = tab == std::string::npos ? "" : line.substr(tab + 1);
+        players.push_back(PlayerIndex{player_id, name, 0, 0});
+        handles[players.back().player_id] = static_cast<uint32_t>(players.size() - 1);
+        pos = end + 1;
+    }
+    
+    // Kayıtları sırayla tarayıp oyuncu zincir başlarını ve round segmentlerini kur
+    off_t file_size = ::lseek(records_fd, 0, SEEK_END);
+    record_count = static_cast<uint64_t>(file_size) / sizeof(BetRecord);
+    if (static_cast<uint64_t>(file_size) % sizeof(BetRecord) != 0) {
+        // Yarım kalan son kayıt atılır ki sonraki eklemeler hizalı kalsın
+        if (::ftruncate(records_fd, static_cast<off_t>(record_count * sizeof(BetRecord))) != 0) {
+            throw std::runtime_error("Bahis geçmişi dosyası düzeltilemedi: " + path);
+        }
+    }
+    
+    std::vector<BetRecord> chunk(4096);
+    for (uint64_t index = 0; index < record_count; ) {
+        size_t batch = static_cast<size_t>(std::min<uint64_t>(chunk.size(), record_count - index));
+        ssize_t read_bytes = ::pread(records_fd, chunk.data(), batch * sizeof(BetRecord),
+                                     static_cast<off_t>(index * sizeof(BetRecord)));
+        if (read_bytes != static_cast<ssize_t>(batch * sizeof(BetRecord))) {
+            throw std::runtime_error("Bahis geçmişi okunamadı: " + path);
+        }
+        
+        for (size_t i = 0; i < batch; ++i, ++index) {
+            const BetRecord& record = chunk[i];
+            if (record.player < players.size()) {
+                players[record.player].head = index + 1;
+                players[record.player].count++;
+            }
+            if (segments.empty() || segments.back().round != record.round) {
+                segments.push_back(RoundSegment{record.round, index, 0, record.settled_at_ms});
+            }
+            segments.back().count++;
+        }
+    }
+}
+
+uint32_t BetHistoryStore::handle_for(std::string_view player_id, std::string_view name) {
+    auto it = handles.find(player_id);
+    if (it != handles.end()) return it->second;
+    
+    uint32_t handle = static_cast<uint32_t>(players.size());
+    if (players_fd >= 0) {
+        std::string line = sanitize(player_id) + "\t" + sanitize(name) + "\n";
+        write_all(players_fd, line.data(), line.size());
+    }
+    players.push_back(PlayerIndex{std::string(player_id), std::string(name), 0, 0});
+    handles.emplace(players.back().player_id, handle);
+    return handle;
+}
+
+void BetHistoryStore::append_round(uint32_t round, int64_t settled_at_ms, const std::vector<SettledBet>& bets) {
+    if (bets.empty()) return;
+    
+    std::unique_lock<std::shared_mutex> lock(store_mutex);
+    std::vector<BetRecord> batch;
+    batch.reserve(bets.size());
+    
+    // İndeks yazım başarılı olunca güncellenir; zincir bu round içinde yereldeki başlardan kurulur
+    std::unordered_map<uint32_t, uint64_t> heads;
+    for (const auto& bet : bets) {
+        uint32_t handle = handle_for(bet.player_id, bet.player_name);
+        auto head = heads.try_emplace(handle, players[handle].head).first;
+        
+        BetRecord record{};
+        record.prev = head->second;
+        record.settled_at_ms = settled_at_ms;
+        record.amount = bet.amount;
+        record.payout = bet.payout;
+        record.round = round;
+        record.player = handle;
+        record.multiplier_x100 = bet.multiplier_x100;
+        record.status = bet.status;
+        batch.push_back(record);
+        
+        head->second = record_count + batch.size();
+    }
+    
+    // Round'un tüm kayıtları tek yazımla diske gider
+    if (records_fd >= 0) {
+        try {
+            write_all(records_fd, reinterpret_cast<const char*>(batch.data()), batch.size() * sizeof(BetRecord));
+        } catch (...) {
+            // Yarım yazılan kayıtlar kesilir: sonraki round'lar 48 byte hizasında kalır
+            if (::ftruncate(records_fd, static_cast<off_t>(record_count * sizeof(BetRecord))) != 0) {
+                std::cerr << "❌ Bahis geçmişi yarım kayıttan temizlenemedi: " << path << std::endl;
+            }
+            throw;
+        }
+    } else {
+        memory_records.insert(memory_records.end(), batch.begin(), batch.end());
+    }
+    
+    for (const BetRecord& record : batch) {
+        players[record.player].count++;
+    }
+    for (const auto& [handle, head] : heads) {
+        players[handle].head = head;
+    }
+    segments.push_back(RoundSegment{round, record_count, batch.size(), settled_at_ms});
+    record_count += batch.size();
+}
+
+bool BetHistoryStore::read_record(uint64_t index, BetRecord& out) const {
+    if (index >= record_count) return false;
+    if (records_fd < 0) {
+        out = memory_records[index];
+        return true;
+    }
+    ssize_t read_bytes = ::pread(records_fd, &out, sizeof(BetRecord), static_cast<off_t>(index * sizeof(BetRecord)));
+    return read_bytes == static_cast<ssize_t>(sizeof(BetRecord));
+}
+
+HistoryPage BetHistoryStore::query(const std::string& player_id, uint64_t cursor, size_t limit) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    HistoryPage page{{}, 0};
+    
+    auto it = handles.find(player_id);
+    if (it == handles.end()) return page;
+    uint32_t handle = it->second;
+    
+    uint64_t next = cursor == 0 ? players[handle].head : cursor;
+    BetRecord record;
+    while (next != 0 && page.records.size() < limit) {
+        // Başka oyuncunun kaydına işaret eden imleç kabul edilmez
+        if (!read_record(next - 1, record) || record.player != handle) {
+            next = 0;
+            break;
+        }
+        page.records.push_back(record);
+        next = record.prev;
+    }
+    
+    page.next_cursor = next;
+    return page;
+}
+
+uint64_t BetHistoryStore::size() const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    return record_count;
+}
+
+uint32_t BetHistoryStore::last_round() const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    // Eski dosyalarda round'lar yeniden başlatmada 1'den saymış olabilir: son segment değil en büyüğü
+    uint32_t last = 0;
+    for (const RoundSegment& segment : segments) last = std::max(last, segment.round);
+    return last;
+}
+
+uint64_t BetHistoryStore::get_player_bet_count(const std::string& player_id) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    auto it = handles.find(player_id);
+    return it == handles.end() ? 0 : players[it->second].count;
+}
+
+std::vector<RoundSegment> BetHistoryStore::get_segments() const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    return segments;
+}
+
+size_t BetHistoryStore::find_segment(int64_t from_ms) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    auto it = std::lower_bound(segments.begin(), segments.end(), from_ms,
+        [](const RoundSegment& segment, int64_t at) { return segment.settled_at_ms < at; });
+    return static_cast<size_t>(it - segments.begin());
+}
+
+bool BetHistoryStore::get_segment(size_t index, RoundSegment& out) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    if (index >= segments.size()) return false;
+    out = segments[index];
+    return true;
+}
+
+size_t BetHistoryStore::read_records(uint64_t first, size_t count, BetRecord* out) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    if (first >= record_count) return 0;
+    count = static_cast<size_t>(std::min<uint64_t>(count, record_count - first));
+    if (records_fd < 0) {
+        std::copy(memory_records.begin() + static_cast<ptrdiff_t>(first),
+                  memory_records.begin() + static_cast<ptrdiff_t>(first + count), out);
+        return count;
+    }
+    ssize_t read_bytes = ::pread(records_fd, out, count * sizeof(BetRecord),
+                                 static_cast<off_t>(first * sizeof(BetRecord)));
+    return read_bytes < 0 ? 0 : static_cast<size_t>(read_bytes) / sizeof(BetRecord);
+}
+
+bool BetHistoryStore::get_player(uint32_t handle, std::string_view& player_id, std::string_view& name) const {
+    std::shared_lock<std::shared_mutex> lock(store_mutex);
+    if (handle >= players.size()) return false;
+    player_id = players[handle].player_id;
+    name = players[handle].name;
+    return true;
+}
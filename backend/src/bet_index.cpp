@@ -0,0 +1,101 @@
+#include "bet_index.h"
+#include <functional>
+
+namespace {
+
+uint64_t hash_of(std::string_view key) {
+    return std::hash<std::string_view>{}(key);
+}
+
+size_t round_up_pow2(size_t value) {
+    size_t capacity = 16;
+    while (capacity < value) capacity <<= 1;
+    return capacity;
+}
+
+}
+
+BetIndex::BetIndex(size_t initial_capacity)
+    : slots(round_up_pow2(initial_capacity)), mask(slots.size() - 1), count(0), current_generation(1) {
+}
+
+size_t BetIndex::find_slot(std::string_view key, uint64_t hash) const {
+    size_t position = hash & mask;
+    while (occupied(slots[position])) {
+        const Slot& slot = slots[position];
+        if (slot.hash == hash && slot.key == key) return position;
+        position = (position + 1) & mask;
+    }
+    return position;
+}
+
+BetIndex::Chain* BetIndex::find(std::string_view key) {
+    size_t position = find_slot(key, hash_of(key));
+    return occupied(slots[position]) ? &slots[position].chain : nullptr;
+}
+
+const BetIndex::Chain* BetIndex::find(std::string_view key) const {
+    size_t position = find_slot(key, hash_of(key));
+    return occupied(slots[position]) ? &slots[position].chain : nullptr;
+}
+
+BetIndex::Chain& BetIndex::insert(std::string_view key, Chain chain, bool& inserted) {
+    uint64_t hash = hash_of(key);
+    size_t position = find_slot(key, hash);
+    if (occupied(slots[position])) {
+        inserted = false;
+        return slots[position].chain;
+    }
+    // Doluluk en fazla yarı: arama zincirleri kısa kalır
+    if ((count + 1) * 2 > slots.size()) {
+        grow();
+        position = find_slot(key, hash);
+    }
+    slots[position] = Slot{key, hash, current_generation, chain};
+    count++;
+    inserted = true;
+    return slots[position].chain;
+}
+
+void BetIndex::erase(std::string_view key) {
+    size_t position = find_slot(key, hash_of(key));
+    if (!occupied(slots[position])) return;
+
+    // Mezar taşı bırakmadan sil: arkadaki slotlar kendi yuvalarına doğru geri kaydırılır
+    size_t hole = position;
+    size_t next = (hole + 1) & mask;
+    while (occupied(slots[next])) {
+        size_t home = slots[next].hash & mask;
+        // next, yuvasından hole'a kadar olan aralıkta değilse hole'a taşınabilir
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots[hole].generation = 0;
+    count--;
+}
+
+void BetIndex::clear() {
+    count = 0;
+    if (++current_generation == 0) {
+        // Sayaç taştı: eski nesiller yeni nesille karışmasın
+        for (Slot& slot : slots) slot.generation = 0;
+        current_generation = 1;
+    }
+}
+
+void BetIndex::grow() {
+    std::vector<Slot> old;
+    old.swap(slots);
+    uint32_t old_generation = current_generation;
+    slots.assign(old.size() * 2, Slot{});
+    mask = slots.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.generation != old_generation) continue;
+        size_t position = slot.hash & mask;
+        while (occupied(slots[position])) position = (position + 1) & mask;
+        slots[position] = slot;
+    }
+}
@@ -0,0 +1,136 @@
+#include "command_journal.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+CommandJournal::CommandJournal(const std::string& file_path)
+    : path(file_path), fd(-1), record_count(0) {
+    buffer.reserve(FLUSH_BYTES + 1024);
+    if (path.empty()) return;
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Komut günlüğü açılamadı: " + path);
+    }
+    // Önceki çalışmadan yarım kalan kayıt varsa okuyucu orada durur; yeni kayıtlar
+    // ondan sonra gelmesin diye dosya sonunu kayıt sınırına hizala
+    std::vector<char> existing = read_journal_file(path);
+    JournalReader reader(existing.data(), existing.size());
+    JournalEntry entry;
+    while (reader.next(entry)) record_count++;
+    if (reader.truncated() && ::ftruncate(fd, static_cast<off_t>(reader.get_offset())) != 0) {
+        throw std::runtime_error("Komut günlüğü düzeltilemedi: " + path);
+    }
+}
+
+CommandJournal::~CommandJournal() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (fd >= 0) ::close(fd);
+}
+
+void CommandJournal::record(JournalType type, uint32_t round, int64_t value,
+                            std::string_view player_id, std::string_view name) {
+    JournalRecordHeader header{};
+    header.at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.value = value;
+    header.round = round;
+    header.id_size = static_cast<uint16_t>(std::min<size_t>(player_id.size(), UINT16_MAX));
+    header.name_size = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+    header.type = static_cast<uint8_t>(type);
+
+    std::lock_guard<std::mutex> lock(journal_mutex);
+    buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer.append(player_id.data(), header.id_size);
+    buffer.append(name.data(), header.name_size);
+    record_count++;
+    if (fd >= 0 && buffer.size() >= FLUSH_BYTES) {
+        write_buffer();
+    }
+}
+
+void CommandJournal::flush() {
+    std::lock_guard<std::mutex> lock(journal_mutex);
+    if (fd >= 0) write_buffer();
+}
+
+void CommandJournal::write_buffer() {
+    const char* data = buffer.data();
+    size_t remaining = buffer.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            buffer.clear();
+            throw std::runtime_error("Komut günlüğü yazılamadı: " + std::string(std::strerror(errno)));
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    buffer.clear();
+}
+
+uint64_t CommandJournal::size() {
+    std::lock_guard<std::mutex> lock(journal_mutex);
+    return record_count;
+}
+
+std::string CommandJournal::get_buffer() {
+    std::lock_guard<std::mutex> lock(journal_mutex);
+    return buffer;
+}
+
+JournalReader::JournalReader(const char* journal_data, size_t journal_size)
+    : data(journal_data), size(journal_size), offset(0) {}
+
+bool JournalReader::next(JournalEntry& entry) {
+    if (size - offset < sizeof(JournalRecordHeader)) return false;
+
+    JournalRecordHeader header;
+    std::memcpy(&header, data + offset, sizeof(header));
+    size_t record_size = sizeof(header) + header.id_size + header.name_size;
+    if (header.type < static_cast<uint8_t>(JournalType::START) ||
+        header.type > static_cast<uint8_t>(JournalType::RELOAD) ||
+        size - offset < record_size) {
+        return false;
+    }
+
+    const char* strings = data + offset + sizeof(header);
+    entry.type = static_cast<JournalType>(header.type);
+    entry.round = header.round;
+    entry.at_ms = header.at_ms;
+    entry.value = header.value;
+    entry.player_id = std::string_view(strings, header.id_size);
+    entry.name = std::string_view(strings + header.id_size, header.name_size);
+    offset += record_size;
+    return true;
+}
+
+std::vector<char> read_journal_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Komut günlüğü okunamadı: " + path);
+    }
+    std::vector<char> content;
+    off_t file_size = ::lseek(fd, 0, SEEK_END);
+    if (file_size > 0) {
+        content.resize(static_cast<size_t>(file_size));
+        size_t read_total = 0;
+        while (read_total < content.size()) {
+            ssize_t n = ::pread(fd, content.data() + read_total, content.size() - read_total,
+                                static_cast<off_t>(read_total));
+            if (n <= 0) break;
+            read_total += static_cast<size_t>(n);
+        }
+        content.resize(read_total);
+    }
+    ::close(fd);
+    return content;
+}
@@ -0,0 +1,126 @@
+#include "compression.h"
+#include "trace.h"
+#include <zlib.h>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+// zlib windowBits: 15 = zlib sarmalı (HTTP "deflate"), +16 = gzip sarmalı
+int window_bits(ContentCoding coding) {
+    return coding == ContentCoding::GZIP ? 15 + 16 : 15;
+}
+
+std::string trim_lower(const std::string& value) {
+    size_t first = value.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    size_t last = value.find_last_not_of(" \t");
+    std::string out = value.substr(first, last - first + 1);
+    for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+}
+
+ContentCoding Compression::negotiate(const std::string& accept_encoding) {
+    // -1: başlıkta hiç geçmedi
+    double gzip_q = -1.0;
+    double deflate_q = -1.0;
+    double wildcard_q = 0.0;
+    
+    size_t pos = 0;
+    while (pos < accept_encoding.size()) {
+        size_t end = accept_encoding.find(',', pos);
+        if (end == std::string::npos) end = accept_encoding.size();
+        std::string item = accept_encoding.substr(pos, end - pos);
+        pos = end + 1;
+        
+        // "gzip;q=0.8" -> isim + kalite
+        double q = 1.0;
+        size_t semi = item.find(';');
+        std::string name = trim_lower(item.substr(0, semi));
+        if (semi != std::string::npos) {
+            std::string param = trim_lower(item.substr(semi + 1));
+            if (param.compare(0, 2, "q=") == 0) {
+                q = std::strtod(param.c_str() + 2, nullptr);
+            }
+        }
+        
+        if (name == "gzip" || name == "x-gzip") gzip_q = q;
+        else if (name == "deflate") deflate_q = q;
+        else if (name == "*") wildcard_q = q;
+    }
+    
+    // Açıkça belirtilmeyenler "*" kalitesini alır
+    if (gzip_q < 0.0) gzip_q = wildcard_q;
+    if (deflate_q < 0.0) deflate_q = wildcard_q;
+    
+    // Eşitlikte gzip tercih edilir
+    if (gzip_q > 0.0 && gzip_q >= deflate_q) return ContentCoding::GZIP;
+    if (deflate_q > 0.0) return ContentCoding::DEFLATE;
+    return ContentCoding::IDENTITY;
+}
+
+std::string Compression::compress(const std::string& data, ContentCoding coding) {
+    if (coding == ContentCoding::IDENTITY) return data;
+    TRACE_SPAN("compress");
+    
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, window_bits(coding), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+    
+    std::string out;
+    out.resize(deflateBound(&stream, data.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    
+    int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        throw std::runtime_error("deflate failed");
+    }
+    
+    out.resize(stream.total_out);
+    return out;
+}
+
+std::string Compression::decompress(const std::string& data, ContentCoding coding) {
+    if (coding == ContentCoding::IDENTITY) return data;
+    
+    z_stream stream{};
+    if (inflateInit2(&stream, window_bits(coding)) != Z_OK) {
+        throw std::runtime_error("inflateInit2 failed");
+    }
+    
+    std::string out;
+    char buffer[16384];
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    
+    int result = Z_OK;
+    while (result != Z_STREAM_END) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END) {
+            inflateEnd(&stream);
+            throw std::runtime_error("inflate failed");
+        }
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    
+    inflateEnd(&stream);
+    return out;
+}
+
+const char* Compression::coding_name(ContentCoding coding) {
+    switch (coding) {
+        case ContentCoding::GZIP: return "gzip";
+        case ContentCoding::DEFLATE: return "deflate";
+        default: return "identity";
+    }
+}
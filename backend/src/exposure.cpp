@@ -0,0 +1,105 @@
+#include "exposure.h"
+#include <algorithm>
+
+Money RoundAggregates::liability(uint32_t multiplier_x100) const {
+    return apply_multiplier(active_stake, multiplier_x100);
+}
+
+ExposureTracker::ExposureTracker() {
+    reset(slots[1], 1);
+    reset(slots[0], 2);
+}
+
+ExposureTracker::Slot& ExposureTracker::slot_for(int round) {
+    return slots[static_cast<unsigned>(round) & 1];
+}
+
+const ExposureTracker::Slot& ExposureTracker::slot_for(int round) const {
+    return slots[static_cast<unsigned>(round) & 1];
+}
+
+ExposureTracker::Shard& ExposureTracker::local_shard(Slot& slot) {
+    // Her thread ilk yazışta bir shard alır ve hep onu kullanır
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    return slot.shards[shard];
+}
+
+RoundAggregates ExposureTracker::merge(const Slot& slot) {
+    RoundAggregates total{};
+    total.round = slot.round.load(std::memory_order_relaxed);
+    for (const Shard& shard : slot.shards) {
+        total.bets += shard.bets.load(std::memory_order_relaxed);
+        total.wagered += shard.wagered.load(std::memory_order_relaxed);
+        total.active_stake += shard.active_stake.load(std::memory_order_relaxed);
+        total.cashouts += shard.cashouts.load(std::memory_order_relaxed);
+        total.paid_out += shard.paid_out.load(std::memory_order_relaxed);
+        total.lost += shard.lost.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < EXPOSURE_BUCKETS; i++) {
+            total.cashout_histogram[i] += shard.histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void ExposureTracker::reset(Slot& slot, int round) {
+    for (Shard& shard : slot.shards) {
+        shard.bets.store(0, std::memory_order_relaxed);
+        shard.wagered.store(0, std::memory_order_relaxed);
+        shard.active_stake.store(0, std::memory_order_relaxed);
+        shard.cashouts.store(0, std::memory_order_relaxed);
+        shard.paid_out.store(0, std::memory_order_relaxed);
+        shard.lost.store(0, std::memory_order_relaxed);
+        for (auto& bucket : shard.histogram) bucket.store(0, std::memory_order_relaxed);
+    }
+    slot.round.store(round, std::memory_order_relaxed);
+}
+
+size_t ExposureTracker::histogram_bucket(uint32_t multiplier_x100) {
+    return static_cast<size_t>(std::upper_bound(EXPOSURE_BOUNDS_X100.begin(), EXPOSURE_BOUNDS_X100.end(),
+                                                multiplier_x100) - EXPOSURE_BOUNDS_X100.begin());
+}
+
+void ExposureTracker::on_bet(int round, Money amount) {
+    Shard& shard = local_shard(slot_for(round));
+    shard.bets.fetch_add(1, std::memory_order_relaxed);
+    shard.wagered.fetch_add(amount, std::memory_order_relaxed);
+    shard.active_stake.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void ExposureTracker::on_cashout(int round, Money stake, Money payout, uint32_t multiplier_x100) {
+    Shard& shard = local_shard(slot_for(round));
+    shard.active_stake.fetch_sub(stake, std::memory_order_relaxed);
+    shard.cashouts.fetch_add(1, std::memory_order_relaxed);
+    shard.paid_out.fetch_add(payout, std::memory_order_relaxed);
+    shard.histogram[histogram_bucket(multiplier_x100)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ExposureTracker::on_settle(int round) {
+    // Yazıcılar game_mutex altında: shard'lar arası taşıma yarışmaz
+    for (Shard& shard : slot_for(round).shards) {
+        Money remaining = shard.active_stake.exchange(0, std::memory_order_relaxed);
+        shard.lost.fetch_add(remaining, std::memory_order_relaxed);
+    }
+}
+
+void ExposureTracker::on_round_start(int round) {
+    Slot& finished = slot_for(round - 1);
+    {
+        std::lock_guard<std::mutex> lock(last_mutex);
+        last_round = merge(finished);
+    }
+    // round + 1 ile aynı slot: o round'un bahisleri bundan sonra gelir
+    reset(finished, round + 1);
+}
+
+RoundAggregates ExposureTracker::get_round(int round) const {
+    RoundAggregates aggregates = merge(slot_for(round));
+    aggregates.round = round;
+    return aggregates;
+}
+
+RoundAggregates ExposureTracker::get_last_round() const {
+    std::lock_guard<std::mutex> lock(last_mutex);
+    return last_round;
+}
@@ -1,15 +1,27 @@
 #include "game.h"
+#include "trace.h"
+#include "balance_import.h"
 #include <iostream>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <unordered_set>
 
-CrashGame::CrashGame(bool test_mode_param) : rng(std::chrono::steady_clock::now().time_since_epoch().count()) {
+CrashGame::CrashGame(bool test_mode_param)
+    : rng(std::chrono::steady_clock::now().time_since_epoch().count()),
+      bet_history(std::make_shared<BetHistoryStore>()),
+      round_chain_index(-1),
+      hash_chain_pending(false),
+      session_wheel(static_cast<uint64_t>(now_ms() / SESSION_TICK_MS)),
+      player_store(std::make_shared<PlayerStore>()),
+      session_ttl_ms(DEFAULT_SESSION_TTL_MS) {
     current_multiplier = 1.0;
     crash_point = 0.0;
     phase = GamePhase::WAITING;
     current_round = 1;
     test_mode = test_mode_param;
+    log_actions = !test_mode;
     phase_start_time = std::chrono::steady_clock::now();
     
     if (!test_mode) {
@@ -18,6 +30,8 @@ CrashGame::CrashGame(bool test_mode_param) : rng(std::chrono::steady_clock::now(
 }
 
 void CrashGame::update() {
+    TRACE_SPAN("game.update");
+    std::lock_guard<std::mutex> lock(game_mutex);
     auto now = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - phase_start_time);
     
@@ -26,40 +40,47 @@ void CrashGame::update() {
     
     switch (phase) {
         case GamePhase::WAITING:
-            if (elapsed.count() >= waiting_time) {
-                start_flying_phase();
+            if (elapsed.count() >= waiting_time && !hash_chain_pending) {
+                start_flying_phase_locked(calculate_crash_point());
             }
             break;
             
         case GamePhase::FLYING:
             update_multiplier();
             if (current_multiplier >= crash_point) {
-                end_game();
-                old_crash_points.push(crash_point);
+                end_game_locked();
             }
             break;
             
         case GamePhase::CRASHED:
             if (elapsed.count() >= crashed_time) {
-                // Yeni round başlat
-                current_round++;
-                current_bets = std::move(next_round_bets);
-                next_round_bets.clear();
-                phase = GamePhase::WAITING;
-                phase_start_time = now;
-                if (!test_mode) {
-                    std::cout << "\n=== Round " << current_round << " başladı! Bahis zamanı ===" << std::endl;
-                }
+                start_next_round_locked();
             }
             break;
     }
+    
+    // Tick ilerlemediyse sadece bir karşılaştırma
+    expire_idle_sessions_locked(now_ms());
 }
 
 void CrashGame::start_flying_phase() {
-    crash_point = calculate_crash_point();
+    std::lock_guard<std::mutex> lock(game_mutex);
+    start_flying_phase_locked(calculate_crash_point());
+}
+
+void CrashGame::start_flying_phase(double next_crash_point) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    round_chain_index = -1;
+    start_flying_phase_locked(next_crash_point);
+}
+
+void CrashGame::start_flying_phase_locked(double next_crash_point) {
+    crash_point = next_crash_point;
     current_multiplier = 1.0;
     phase = GamePhase::FLYING;
     phase_start_time = std::chrono::steady_clock::now();
+    status_version++;
+    record(JournalType::FLY, multiplier_to_x100(crash_point));
     
     if (!test_mode) {
         std::cout << "\n🚁 Helikopter havalandı! Crash noktası: " << crash_point << "x" << std::endl;
@@ -73,50 +94,148 @@ void CrashGame::update_multiplier() {
     
     // Exponential growth formula - daha gerçekçi
     double time_seconds = duration.count() / 1000.0;
-    current_multiplier = 1.0 + (std::exp(time_seconds * 0.1) - 1.0) * 2.0;
+    double multiplier = 1.0 + (std::exp(time_seconds * 0.1) - 1.0) * 2.0;
     
-    // 2 ondalık basamağa yuvarla
-    current_multiplier = std::round(current_multiplier * 100.0) / 100.0;
+    // 2 ondalık basamağa yuvarla; görünen değer değişmediyse long-poll bekleyenleri uyandırma
+    multiplier = std::round(multiplier * 100.0) / 100.0;
+    if (multiplier != current_multiplier) {
+        current_multiplier = multiplier;
+        status_version++;
+    }
 }
 
 void CrashGame::end_game() {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    end_game_locked();
+}
+
+void CrashGame::end_game_locked() {
+    // update() ile dışarıdan çağrı yarışırsa round iki kez settle edilmesin
+    if (phase != GamePhase::FLYING) return;
+    
     current_multiplier = crash_point;
     phase = GamePhase::CRASHED;
     phase_start_time = std::chrono::steady_clock::now();
+    old_crash_points.push(crash_point);
+    history_version++;
+    status_version++;
     
     if (!test_mode) {
         std::cout << "\n💥 CRASH! " << crash_point << "x'te düştü!" << std::endl;
     }
     
+    record(JournalType::CRASH);
+    // Round bitti: hash'i artık açıklanabilir (/api/fair/verify)
+    if (hash_chain && round_chain_index >= 0) {
+        hash_chain->reveal(static_cast<uint64_t>(round_chain_index));
+    }
     process_crashed_bets();
+    exposure.on_settle(current_round);
+    
+    // Replay her round sonunda bakiyeleri bu özetle doğrular
+    if (journal) {
+        record(JournalType::CHECKPOINT, static_cast<int64_t>(balance_checksum()));
+        try {
+            journal->flush();
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Komut günlüğü yazılamadı: " << e.what() << std::endl;
+        }
+    }
+}
+
+void CrashGame::start_next_round() {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    start_next_round_locked();
+}
+
+void CrashGame::start_next_round_locked() {
+    current_round++;
+    exposure.on_round_start(current_round);
+    // Vektör ve arena'ları takasla: kapasiteler round'lar arası korunur
+    current_bets.swap(next_round_bets);
+    next_round_bets.clear();
+    std::swap(current_arena, next_round_arena);
+    next_round_arena.reset();
+    rebuild_bet_index();
+    bets_version++;
+    status_version++;
+    phase = GamePhase::WAITING;
+    phase_start_time = std::chrono::steady_clock::now();
+    record(JournalType::NEW_ROUND);
+    if (!test_mode) {
+        std::cout << "\n=== Round " << current_round << " başladı! Bahis zamanı ===" << std::endl;
+    }
 }
 
 void CrashGame::process_crashed_bets() {
+    TRACE_SPAN("game.settlement");
+    auto day = std::chrono::duration_cast<std::chrono::hours>(
+        std::chrono::system_clock::now().time_since_epoch()).count() / 24;
+    leaderboards.begin_settlement(current_round, day);
+    
+    settled_bets.clear();
+    
     for (auto& bet : current_bets) {
         if (bet.get_status() == BetStatus::ACTIVE) {
             bet.mark_as_crashed();
-            if (!test_mode) {
+            settled_bets.push_back(SettledBet{bet.get_player_id(), bet.get_player_name(),
+                                         bet.get_amount(), 0, 0,
+                                         static_cast<uint8_t>(BetStatus::CRASHED)});
+            if (log_actions) {
+                TRACE_SPAN("log");
                 std::cout << "Oyuncu " << bet.get_player_id() << " bahsini kaybetti: " 
-                          << bet.get_amount() << " TL" << std::endl;
+                          << money_to_string(bet.get_amount()) << " TL" << std::endl;
             }
         } else if (bet.get_status() == BetStatus::CASHED_OUT) {
-            auto player = get_player(bet.get_player_id());
+            auto player = find_player_locked(bet.get_player_id());
             if (player) {
-                double winnings = bet.calculate_winnings();
-                player->add_balance(winnings);
-                if (!test_mode) {
+                Money winnings = bet.calculate_winnings();
+                player->add_winnings(winnings);
+                leaderboards.record_win(player->get_id(), player->get_name(), winnings, player->get_total_winnings());
+                settled_bets.push_back(SettledBet{bet.get_player_id(), bet.get_player_name(),
+                                             bet.get_amount(), winnings,
+                                             bet.get_cashout_multiplier_x100(),
+                                             static_cast<uint8_t>(BetStatus::CASHED_OUT)});
+                if (log_actions) {
+                    TRACE_SPAN("log");
                     std::cout << "Oyuncu " << bet.get_player_id() << " kazandı: " 
-                              << winnings << " TL (Çarpan: " << bet.get_cashout_multiplier() << "x)" << std::endl;
+                              << money_to_string(winnings) << " TL (Çarpan: " << bet.get_cashout_multiplier() << "x)" << std::endl;
                 }
             }
         }
     }
+    leaderboards.end_settlement();
+    // Round'un açık bahsi kalmadı: long-poll ayrımı (has_active_bet) crash sonrası yanılmasın
+    bet_index.clear();
+    
+    // Round'un tüm bahisleri tek segment olarak geçmişe yazılır
+    auto settled_at = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    try {
+        TRACE_SPAN("game.history_append");
+        bet_history->append_round(static_cast<uint32_t>(current_round), settled_at, settled_bets);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Bahis geçmişi yazılamadı: " << e.what() << std::endl;
+    }
+    bets_version++;
 }
 
 bool CrashGame::add_player(const std::string& player_id, const std::string& name) {
+    std::lock_guard<std::mutex> game_lock(game_mutex);
+    // Sayfalanmış oyuncu tekrar katılınca bakiyesiyle döner; yeni oyuncu sayılmaz
+    if (reload_player_locked(player_id)) return false;
+    std::unique_lock<std::shared_mutex> lock(players_mutex);
     if (players.find(player_id) == players.end()) {
-        players[player_id] = std::make_shared<Player>(player_id, name);
-        if (!test_mode) {
+        auto player = std::make_shared<Player>(player_id, name);
+        int64_t now = now_ms();
+        player->touch(now);
+        players[player_id] = player;
+        player_ids_by_name.emplace(name, player_id);
+        record(JournalType::ADD_PLAYER, 0, player_id, name);
+        if (session_ttl_ms > 0) {
+            session_wheel.schedule(player_id, static_cast<uint64_t>((now + session_ttl_ms) / SESSION_TICK_MS));
+        }
+        if (log_actions) {
             std::cout << "Yeni oyuncu katıldı: " << name << " (ID: " << player_id << ")" << std::endl;
         }
         return true;
@@ -125,26 +244,202 @@ bool CrashGame::add_player(const std::string& player_id, const std::string& name
 }
 
 bool CrashGame::get_player_by_name(const std::string& name, std::shared_ptr<Player>& out_player) {
-    for (const auto& pair : players) {
-        if (pair.second->get_name() == name) {
-            out_player = pair.second;
+    {
+        std::shared_lock<std::shared_mutex> lock(players_mutex);
+        auto name_it = player_ids_by_name.find(name);
+        if (name_it != player_ids_by_name.end()) {
+            auto it = players.find(name_it->second);
+            if (it == players.end()) return false;
+            it->second->touch(now_ms());
+            out_player = it->second;
             return true;
         }
     }
-    return false;
+    
+    // İsim sayfalanmış bir oyuncunun: geri yüklenir (isim de boşa çıkmaz)
+    std::string player_id;
+    if (!player_store->find_id_by_name(name, player_id)) return false;
+    std::lock_guard<std::mutex> game_lock(game_mutex);
+    out_player = find_player_locked(player_id);
+    return out_player != nullptr;
+}
+
+std::shared_ptr<Player> CrashGame::get_player(std::string_view player_id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(players_mutex);
+        auto it = players.find(player_id);
+        if (it != players.end()) {
+            it->second->touch(now_ms());
+            return it->second;
+        }
+    }
+    // Bilinmeyen id'ler oyun kilidini almaz
+    if (!player_store->contains(player_id)) return nullptr;
+    std::lock_guard<std::mutex> game_lock(game_mutex);
+    return find_player_locked(player_id);
+}
+
+std::shared_ptr<Player> CrashGame::find_player_locked(std::string_view player_id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(players_mutex);
+        auto it = players.find(player_id);
+        if (it != players.end()) {
+            it->second->touch(now_ms());
+            return it->second;
+        }
+    }
+    return reload_player_locked(player_id);
+}
+
+std::shared_ptr<Player> CrashGame::reload_player_locked(std::string_view player_id) {
+    DormantPlayer dormant;
+    if (!player_store->take(player_id, dormant)) return nullptr;
+    
+    auto player = std::make_shared<Player>(dormant.player_id, dormant.name, dormant.balance, dormant.total_winnings);
+    int64_t now = now_ms();
+    player->touch(now);
+    {
+        std::unique_lock<std::shared_mutex> lock(players_mutex);
+        players[dormant.player_id] = player;
+        player_ids_by_name.emplace(dormant.name, dormant.player_id);
+    }
+    // Replay de aynı noktada geri yükler: bakiye özeti (CHECKPOINT) bellekteki oyunculara bakar
+    record(JournalType::RELOAD, 0, dormant.player_id);
+    if (session_ttl_ms > 0) {
+        session_wheel.schedule(dormant.player_id, static_cast<uint64_t>((now + session_ttl_ms) / SESSION_TICK_MS));
+    }
+    if (log_actions) {
+        std::cout << "Oyuncu geri yüklendi: " << dormant.name << " (ID: " << dormant.player_id << ", "
+                  << money_to_string(dormant.balance) << " TL)" << std::endl;
+    }
+    return player;
+}
+
+size_t CrashGame::get_player_count() const {
+    std::shared_lock<std::shared_mutex> lock(players_mutex);
+    return players.size();
 }
 
-std::shared_ptr<Player> CrashGame::get_player(const std::string& player_id) {
+bool CrashGame::remove_player(const std::string& player_id) {
+    std::lock_guard<std::mutex> game_lock(game_mutex);
+    std::unique_lock<std::shared_mutex> lock(players_mutex);
     auto it = players.find(player_id);
-    return (it != players.end()) ? it->second : nullptr;
+    if (it == players.end()) return false;
+    erase_player_locked(it);
+    return true;
+}
+
+void CrashGame::erase_player_locked(std::map<std::string, std::shared_ptr<Player>, std::less<>>::iterator it) {
+    auto name_it = player_ids_by_name.find(it->second->get_name());
+    if (name_it != player_ids_by_name.end() && name_it->second == it->first) {
+        player_ids_by_name.erase(name_it);
+    }
+    // Başlangıç durumundaki oyuncu tekrar katılınca aynısı olur: sayfalanmaz
+    const Player& player = *it->second;
+    if (player.get_balance() != Player::STARTING_BALANCE || player.get_total_winnings() != 0) {
+        player_store->put(DormantPlayer{it->first, player.get_name(), player.get_balance(),
+                                        player.get_total_winnings()});
+    }
+    record(JournalType::EVICT, 0, it->first);
+    players.erase(it);
+}
+
+// FNV-1a: oyuncu id sırasıyla (id, bakiye) çiftleri
+uint64_t CrashGame::balance_checksum() const {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    std::shared_lock<std::shared_mutex> lock(players_mutex);
+    for (const auto& entry : players) {
+        Money balance = entry.second->get_balance();
+        mix(entry.first.data(), entry.first.size());
+        mix(&balance, sizeof(balance));
+    }
+    return hash;
+}
+
+void CrashGame::set_session_ttl_ms(int64_t ttl_ms) {
+    session_ttl_ms = ttl_ms;
+}
+
+void CrashGame::set_player_store(std::shared_ptr<PlayerStore> store) {
+    player_store = std::move(store);
+}
+
+std::shared_ptr<PlayerStore> CrashGame::get_player_store() const {
+    return player_store;
 }
 
-bool CrashGame::place_bet(const std::string& player_id, double amount) {
-    auto player = get_player(player_id);
+size_t CrashGame::expire_idle_sessions(int64_t now) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return expire_idle_sessions_locked(now);
+}
+
+size_t CrashGame::expire_idle_sessions_locked(int64_t now) {
+    uint64_t now_tick = static_cast<uint64_t>(now / SESSION_TICK_MS);
+    if (now_tick <= session_wheel.get_current_tick()) return 0;
+    
+    std::vector<std::string> expired;
+    session_wheel.advance(now_tick, [&](std::string&& player_id) {
+        expired.push_back(std::move(player_id));
+    });
+    if (expired.empty() || session_ttl_ms <= 0) return 0;
+    TRACE_SPAN("game.expire_sessions");
+    
+    // Bahsi olan oyuncu settlement'a kadar kalmalı
+    std::unordered_set<std::string_view> has_bet;
+    for (const auto& bet : current_bets) has_bet.insert(bet.get_player_id());
+    for (const auto& bet : next_round_bets) has_bet.insert(bet.get_player_id());
+    
+    size_t evicted = 0;
+    std::unique_lock<std::shared_mutex> lock(players_mutex);
+    for (auto& player_id : expired) {
+        auto it = players.find(player_id);
+        if (it == players.end()) continue;
+        
+        int64_t idle_deadline = it->second->get_last_activity_ms() + session_ttl_ms;
+        if (idle_deadline > now || has_bet.count(player_id)) {
+            // Hâlâ aktif: son aktiviteden itibaren yeniden planla
+            int64_t deadline = std::max(idle_deadline, now + SESSION_TICK_MS);
+            session_wheel.schedule(std::move(player_id), static_cast<uint64_t>(deadline / SESSION_TICK_MS));
+            continue;
+        }
+        
+        erase_player_locked(it);
+        evicted++;
+    }
+    lock.unlock();
+    
+    if (evicted > 0) {
+        evicted_sessions += evicted;
+        if (!test_mode) {
+            std::cout << "🧹 " << evicted << " boşta oturum kapatıldı" << std::endl;
+        }
+    }
+    return evicted;
+}
+
+uint64_t CrashGame::get_evicted_session_count() const {
+    return evicted_sessions.load();
+}
+
+int64_t CrashGame::now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool CrashGame::place_bet(const std::string& player_id, Money amount) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    auto player = find_player_locked(player_id);
     if (!player) return false;
     
     if (!player->deduct_balance(amount)) {
-        if (!test_mode) {
+        if (log_actions) {
             std::cout << "Oyuncu " << player_id << " yetersiz bakiye!" << std::endl;
         }
         return false;
@@ -152,15 +447,26 @@ bool CrashGame::place_bet(const std::string& player_id, double amount) {
     
     if (phase == GamePhase::WAITING) {
         // Mevcut round için bahis
-        current_bets.emplace_back(player_id, amount, current_round, player->get_name());
-        if (!test_mode) {
-            std::cout << "Oyuncu " << player_id << " mevcut round için bahis yaptı: " << amount << " TL" << std::endl;
+        current_bets.emplace_back(current_arena.store(player_id), amount, current_round,
+                                  current_arena.store(player->get_name()));
+        index_bet(current_bets.size() - 1);
+        exposure.on_bet(current_round, amount);
+        bets_version++;
+        status_version++;
+        record(JournalType::BET, amount, player_id);
+        if (log_actions) {
+            TRACE_SPAN("log");
+            std::cout << "Oyuncu " << player_id << " mevcut round için bahis yaptı: " << money_to_string(amount) << " TL" << std::endl;
         }
     } else {
         // Bir sonraki round için bahis
-        next_round_bets.emplace_back(player_id, amount, current_round + 1, player->get_name());
-        if (!test_mode) {
-            std::cout << "Oyuncu " << player_id << " bir sonraki round için bahis yaptı: " << amount << " TL" << std::endl;
+        next_round_bets.emplace_back(next_round_arena.store(player_id), amount, current_round + 1,
+                                     next_round_arena.store(player->get_name()));
+        exposure.on_bet(current_round + 1, amount);
+        record(JournalType::BET, amount, player_id);
+        if (log_actions) {
+            TRACE_SPAN("log");
+            std::cout << "Oyuncu " << player_id << " bir sonraki round için bahis yaptı: " << money_to_string(amount) << " TL" << std::endl;
         }
     }
     
@@ -168,14 +474,41 @@ bool CrashGame::place_bet(const std::string& player_id, double amount) {
 }
 
 bool CrashGame::cashout(const std::string& player_id) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return cashout_locked(player_id, current_multiplier);
+}
+
+bool CrashGame::cashout_at(const std::string& player_id, double multiplier) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return cashout_locked(player_id, multiplier);
+}
+
+bool CrashGame::has_active_bet(std::string_view player_id) const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return bet_index.find(player_id) != nullptr;
+}
+
+bool CrashGame::cashout_locked(const std::string& player_id, double multiplier) {
     if (phase != GamePhase::FLYING) return false;
     
-    for (auto& bet : current_bets) {
-        if (bet.get_player_id() == player_id && bet.get_status() == BetStatus::ACTIVE) {
-            bet.cashout(current_multiplier);
-            if (!test_mode) {
+    BetIndex::Chain* chain = bet_index.find(player_id);
+    if (!chain) return false;
+    
+    // Oyuncunun bahis zincirinde ilk aktif bahsi bul; öncekiler zaten kapanmış
+    for (uint32_t i = chain->head; i != NO_BET; i = next_bet_of_player[i]) {
+        Bet& bet = current_bets[i];
+        if (bet.get_status() == BetStatus::ACTIVE) {
+            bet.cashout(multiplier);
+            exposure.on_cashout(current_round, bet.get_amount(), bet.calculate_winnings(),
+                                bet.get_cashout_multiplier_x100());
+            chain->head = next_bet_of_player[i];
+            if (chain->head == NO_BET) bet_index.erase(player_id);
+            bets_version++;
+            record(JournalType::CASHOUT, multiplier_to_x100(multiplier), player_id);
+            if (log_actions) {
+                TRACE_SPAN("log");
                 std::cout << "Oyuncu " << player_id << " cashout yaptı: " 
-                          << current_multiplier << "x (" << bet.calculate_winnings() << " TL)" << std::endl;
+                          << multiplier << "x (" << money_to_string(bet.calculate_winnings()) << " TL)" << std::endl;
             }
             return true;
         }
@@ -183,33 +516,125 @@ bool CrashGame::cashout(const std::string& player_id) {
     return false;
 }
 
-bool CrashGame::load_balance(const std::string& player_id, double amount) {
-    auto player = get_player(player_id);
-    if (!player) return false;
-    player->add_balance(amount);
-    if (!test_mode) {
-        std::cout << "Oyuncu " << player_id << " bakiyesini yükledi: " << amount << " TL" << std::endl;
+void CrashGame::index_bet(size_t index) {
+    next_bet_of_player.push_back(NO_BET);
+    uint32_t position = static_cast<uint32_t>(index);
+    bool inserted = false;
+    BetIndex::Chain& chain = bet_index.insert(current_bets[index].get_player_id(), BetIndex::Chain{position, position}, inserted);
+    if (!inserted) {
+        next_bet_of_player[chain.tail] = position;
+        chain.tail = position;
     }
+}
+
+void CrashGame::rebuild_bet_index() {
+    bet_index.clear();
+    next_bet_of_player.clear();
+    for (size_t i = 0; i < current_bets.size(); i++) {
+        // Settle / cashout olmuş bahis (ör. crash ekranında devralınan durum) indekse girmez
+        if (current_bets[i].get_status() == BetStatus::ACTIVE) {
+            index_bet(i);
+        } else {
+            next_bet_of_player.push_back(NO_BET);
+        }
+    }
+}
+
+void CrashGame::set_action_logging(bool enabled) {
+    log_actions = enabled;
+}
+
+bool CrashGame::load_balance(const std::string& player_id, Money amount) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    std::shared_lock<std::shared_mutex> players_lock(players_mutex);
+    auto it = players.find(player_id);
+    if (it != players.end()) {
+        it->second->touch(now_ms());
+        it->second->add_balance(amount);
+    } else if (!player_store->credit(player_id, amount)) {
+        return false;
+    }
+    players_lock.unlock();
+    record(JournalType::LOAD_BALANCE, amount, player_id);
+    if (log_actions) {
+        std::cout << "Oyuncu " << player_id << " bakiyesini yükledi: " << money_to_string(amount) << " TL" << std::endl;
+    }
+    return true;
+}
+
+size_t CrashGame::load_balances(const std::vector<BalanceCredit>& credits, BalanceImportReport& report) {
+    TRACE_SPAN("game.load_balances");
+    std::lock_guard<std::mutex> lock(game_mutex);
+    std::shared_lock<std::shared_mutex> players_lock(players_mutex);
+    size_t credited = 0;
+    std::string dormant_id;
+    for (const BalanceCredit& credit : credits) {
+        auto name_it = player_ids_by_name.find(credit.player_name);
+        auto it = name_it != player_ids_by_name.end() ? players.find(name_it->second) : players.end();
+        // Oturumu canlı tutmaz: kampanya yüklemesi oyuncu aktivitesi değildir. Sayfalanmış oyuncu
+        // belleğe alınmaz, kaydındaki bakiye artırılır
+        if (it != players.end()) {
+            it->second->add_balance(credit.amount);
+            record(JournalType::LOAD_BALANCE, credit.amount, it->first);
+        } else if (player_store->find_id_by_name(credit.player_name, dormant_id) &&
+                   player_store->credit(dormant_id, credit.amount)) {
+            record(JournalType::LOAD_BALANCE, credit.amount, dormant_id);
+        } else {
+            report.add_error(credit.line, "Oyuncu bulunamadı: " + credit.player_name);
+            continue;
+        }
+        report.credited++;
+        report.total += credit.amount;
+        credited++;
+    }
+    return credited;
+}
+
+bool CrashGame::withdraw_balance(const std::string& player_id, Money amount) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    auto player = find_player_locked(player_id);
+    if (!player || !player->deduct_balance(amount)) return false;
+    record(JournalType::WITHDRAW, amount, player_id);
     return true;
 }
 
+void CrashGame::record(JournalType type, int64_t value, std::string_view player_id, std::string_view name) {
+    if (journal) {
+        journal->record(type, static_cast<uint32_t>(current_round), value, player_id, name);
+    }
+}
+
 double CrashGame::get_current_multiplier() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return current_multiplier;
 }
 
 double CrashGame::get_crash_point() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return crash_point;
 }
 
 GamePhase CrashGame::get_phase() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return phase;
 }
 
 int CrashGame::get_current_round() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return current_round;
 }
 
+void CrashGame::set_first_round(int round) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    current_round = std::max(round, 1);
+}
+
 int CrashGame::get_remaining_time_ms() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return remaining_time_ms_locked();
+}
+
+int CrashGame::remaining_time_ms_locked() const {
     auto now = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - phase_start_time);
     
@@ -227,6 +652,7 @@ int CrashGame::get_remaining_time_ms() const {
 }
 
 std::string CrashGame::get_game_state_json() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     std::stringstream json;
     json << std::fixed << std::setprecision(2);
     
@@ -243,7 +669,7 @@ std::string CrashGame::get_game_state_json() const {
     json << "\",";
     json << "\"multiplier\": " << current_multiplier << ",";
     json << "\"crash_point\": " << crash_point << ",";
-    json << "\"remaining_time_ms\": " << get_remaining_time_ms() << ",";
+    json << "\"remaining_time_ms\": " << remaining_time_ms_locked() << ",";
     json << "\"active_bets\": " << current_bets.size() << ",";
     json << "\"next_round_bets\": " << next_round_bets.size();
     json << "}";
@@ -252,6 +678,18 @@ std::string CrashGame::get_game_state_json() const {
 }
 
 double CrashGame::calculate_crash_point() {
+    // Zincir varsa nokta önceden hesaplanmış: sadece sıradaki linki al
+    uint64_t index = 0;
+    uint32_t crash_point_x100 = 0;
+    if (hash_chain && hash_chain->take(index, crash_point_x100, static_cast<uint32_t>(current_round))) {
+        round_chain_index = static_cast<int64_t>(index);
+        return crash_point_x100 / 100.0;
+    }
+    if (hash_chain && round_chain_index >= 0) {
+        std::cerr << "⚠️ Hash zinciri bitti, crash noktaları RNG'ye döndü: " << hash_chain->get_path() << std::endl;
+    }
+    round_chain_index = -1;
+    
     std::uniform_real_distribution<double> dist(0.0, 1.0);
     double random_value = dist(rng);
     
@@ -266,8 +704,188 @@ double CrashGame::calculate_crash_point() {
     return std::round(crash_point * 100.0) / 100.0;
 }
 
+void CrashGame::set_bet_history(std::shared_ptr<BetHistoryStore> store) {
+    bet_history = std::move(store);
+}
+
+std::shared_ptr<BetHistoryStore> CrashGame::get_bet_history() const {
+    return bet_history;
+}
+
+void CrashGame::set_command_journal(std::shared_ptr<CommandJournal> command_journal, bool resumed) {
+    journal = std::move(command_journal);
+    record(resumed ? JournalType::HANDOFF : JournalType::START);
+}
+
+void CrashGame::export_state(json& state) const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    // Uçuştaki round'un crash noktası ve cashout'ları yarıda devredilemez
+    if (phase == GamePhase::FLYING) {
+        throw std::runtime_error("Round uçarken durum devredilemez");
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - phase_start_time).count();
+    
+    state = {
+        {"version", HANDOFF_STATE_VERSION},
+        {"round", current_round},
+        {"phase", phase == GamePhase::WAITING ? "WAITING" : "CRASHED"},
+        {"phase_elapsed_ms", elapsed},
+        {"crash_point", crash_point},
+        {"multiplier", current_multiplier},
+        {"old_crash_points", std::vector<double>(old_crash_points.buffer_.begin(), old_crash_points.buffer_.end())},
+        {"bets_version", bets_version.load()},
+        {"history_version", history_version.load()},
+        {"status_version", status_version.load()}
+    };
+    
+    // Diziler: nesne anahtarları yüz binlerce oyuncuda boyutu ikiye katlar
+    json& player_rows = state["players"] = json::array();
+    {
+        std::shared_lock<std::shared_mutex> players_lock(players_mutex);
+        for (const auto& [player_id, player] : players) {
+            player_rows.push_back({player_id, player->get_name(), player->get_balance(),
+                                   player->get_total_winnings(), player->get_last_activity_ms()});
+        }
+    }
+    json& current_rows = state["current_bets"] = json::array();
+    for (const auto& bet : current_bets) {
+        current_rows.push_back({std::string(bet.get_player_id()), bet.get_amount(), static_cast<int>(bet.get_status()),
+                                bet.get_cashout_multiplier_x100()});
+    }
+    json& next_rows = state["next_round_bets"] = json::array();
+    for (const auto& bet : next_round_bets) {
+        next_rows.push_back({std::string(bet.get_player_id()), bet.get_amount()});
+    }
+    
+    LeaderboardState boards = leaderboards.save_state();
+    auto totals = [](const std::vector<LeaderboardEntry>& entries) {
+        json rows = json::array();
+        for (const auto& entry : entries) rows.push_back({entry.player_id, entry.value});
+        return rows;
+    };
+    state["leaderboards"] = {
+        {"day", boards.day},
+        {"settled_round", boards.settled_round},
+        {"version", boards.version},
+        {"round_totals", totals(boards.round_totals)},
+        {"daily_totals", totals(boards.daily_totals)}
+    };
+}
+
+void CrashGame::import_state(const json& state) {
+    if (state.value("version", 0) != HANDOFF_STATE_VERSION) {
+        throw std::runtime_error("Devir durumu sürümü desteklenmiyor");
+    }
+    std::lock_guard<std::mutex> lock(game_mutex);
+    std::unique_lock<std::shared_mutex> players_lock(players_mutex);
+    if (!players.empty() || !current_bets.empty() || !next_round_bets.empty()) {
+        throw std::runtime_error("Devir durumu sadece boş bir oyuna yüklenebilir");
+    }
+    
+    current_round = state.at("round").get<int>();
+    phase = state.at("phase").get<std::string>() == "WAITING" ? GamePhase::WAITING : GamePhase::CRASHED;
+    // Faz süresi kaldığı yerden: round devir yüzünden uzamaz
+    phase_start_time = std::chrono::steady_clock::now() -
+                       std::chrono::milliseconds(state.at("phase_elapsed_ms").get<int64_t>());
+    crash_point = state.at("crash_point").get<double>();
+    current_multiplier = state.at("multiplier").get<double>();
+    for (double point : state.at("old_crash_points")) old_crash_points.push(point);
+    // ETag'ler süreçler arası geçerli kalsın: versiyonlar sıfırdan başlarsa istemciler yanlış 304 alır
+    bets_version = state.at("bets_version").get<uint64_t>();
+    history_version = state.at("history_version").get<uint64_t>();
+    status_version = state.at("status_version").get<uint64_t>();
+    
+    int64_t now = now_ms();
+    for (const auto& row : state.at("players")) {
+        const std::string player_id = row.at(0).get<std::string>();
+        const std::string name = row.at(1).get<std::string>();
+        auto player = std::make_shared<Player>(player_id, name, row.at(2).get<Money>(), row.at(3).get<Money>());
+        int64_t last_activity = row.at(4).get<int64_t>();
+        player->touch(last_activity);
+        players.emplace(player_id, player);
+        player_ids_by_name.emplace(name, player_id);
+        if (session_ttl_ms > 0) {
+            session_wheel.schedule(player_id,
+                static_cast<uint64_t>((std::max(last_activity, now) + session_ttl_ms) / SESSION_TICK_MS));
+        }
+        if (player->get_total_winnings() > 0) {
+            leaderboards.restore_all_time(player_id, name, player->get_total_winnings());
+        }
+    }
+    
+    auto name_of = [this](const std::string& player_id) {
+        auto it = players.find(player_id);
+        return it != players.end() ? it->second->get_name() : std::string();
+    };
+    exposure.on_round_start(current_round);
+    for (const auto& row : state.at("current_bets")) {
+        const std::string player_id = row.at(0).get<std::string>();
+        Money amount = row.at(1).get<Money>();
+        current_bets.emplace_back(current_arena.store(player_id), amount, current_round,
+                                  current_arena.store(name_of(player_id)));
+        auto status = static_cast<BetStatus>(row.at(2).get<int>());
+        if (status == BetStatus::CASHED_OUT) {
+            current_bets.back().cashout(row.at(3).get<uint32_t>() / 100.0);
+        } else if (status == BetStatus::CRASHED) {
+            current_bets.back().mark_as_crashed();
+        } else {
+            exposure.on_bet(current_round, amount);
+        }
+    }
+    rebuild_bet_index();
+    for (const auto& row : state.at("next_round_bets")) {
+        const std::string player_id = row.at(0).get<std::string>();
+        Money amount = row.at(1).get<Money>();
+        next_round_bets.emplace_back(next_round_arena.store(player_id), amount, current_round + 1,
+                                     next_round_arena.store(name_of(player_id)));
+        exposure.on_bet(current_round + 1, amount);
+    }
+    
+    const json& boards_json = state.at("leaderboards");
+    LeaderboardState boards;
+    boards.day = boards_json.at("day").get<int64_t>();
+    boards.settled_round = boards_json.at("settled_round").get<int>();
+    boards.version = boards_json.at("version").get<uint64_t>();
+    for (const auto& row : boards_json.at("round_totals")) {
+        std::string player_id = row.at(0).get<std::string>();
+        boards.round_totals.push_back(LeaderboardEntry{player_id, name_of(player_id), row.at(1).get<Money>()});
+    }
+    for (const auto& row : boards_json.at("daily_totals")) {
+        std::string player_id = row.at(0).get<std::string>();
+        boards.daily_totals.push_back(LeaderboardEntry{player_id, name_of(player_id), row.at(1).get<Money>()});
+    }
+    leaderboards.restore_state(boards);
+}
+
+std::shared_ptr<CommandJournal> CrashGame::get_command_journal() const {
+    return journal;
+}
+
+void CrashGame::set_hash_chain(std::shared_ptr<HashChain> chain) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    hash_chain = std::move(chain);
+    hash_chain_pending = false;
+}
+
+void CrashGame::set_hash_chain_pending(bool pending) {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    hash_chain_pending = pending;
+}
+
+std::shared_ptr<HashChain> CrashGame::get_hash_chain() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return hash_chain;
+}
+
+int64_t CrashGame::get_round_chain_index() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return round_chain_index;
+}
+
 void CrashGame::enable_test_mode() {
     test_mode = true;
+    log_actions = false;
 }
 
 bool CrashGame::is_test_mode() const {
@@ -277,6 +895,7 @@ bool CrashGame::is_test_mode() const {
 // 🔄 ADDITIONAL GETTER METHODS FOR JSON SERIALIZATION
 
 std::string CrashGame::get_phase_string() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     switch (phase) {
         case GamePhase::WAITING: return "waiting";
         case GamePhase::FLYING: return "flying";
@@ -286,24 +905,48 @@ std::string CrashGame::get_phase_string() const {
 }
 
 int CrashGame::get_round() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return current_round;
 }
 
 double CrashGame::get_multiplier() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return current_multiplier;
 }
 
 int CrashGame::get_active_bet_count() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     return static_cast<int>(current_bets.size());
 }
 
+uint64_t CrashGame::get_bets_version() const {
+    return bets_version.load();
+}
+
+uint64_t CrashGame::get_history_version() const {
+    return history_version.load();
+}
+
+uint64_t CrashGame::get_status_version() const {
+    return status_version.load();
+}
+
+const ExposureTracker& CrashGame::get_exposure() const {
+    return exposure;
+}
+
+uint64_t CrashGame::get_leaderboard_version() const {
+    return leaderboards.get_version();
+}
+
 void CrashGame::get_current_bets_json(json &resp) const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     json active_bet_array = json::array();
     for (const auto& bet : this->current_bets) {
         if (bet.get_status() != BetStatus::CRASHED) {
             json bet_json {};
-            bet_json["player_name"] = bet.get_player_name();
-            bet_json["amount"] = bet.get_amount();
+            bet_json["player_name"] = std::string(bet.get_player_name());
+            bet_json["amount"] = money_to_double(bet.get_amount());
 
             active_bet_array.push_back(bet_json);
         }
@@ -312,9 +955,62 @@ void CrashGame::get_current_bets_json(json &resp) const {
 }
 
 void CrashGame::get_old_crash_points_json(json &resp) const {
+    std::lock_guard<std::mutex> lock(game_mutex);
     json crash_points_array = json::array();
     for (const auto& point : this->old_crash_points.buffer_) {
         crash_points_array.push_back(point);
     }
     resp = crash_points_array;
 }
+
+
+std::vector<double> CrashGame::get_old_crash_points() const {
+    std::lock_guard<std::mutex> lock(game_mutex);
+    return std::vector<double>(old_crash_points.buffer_.begin(), old_crash_points.buffer_.end());
+}
+
+bool CrashGame::get_leaderboard_json(json &resp, uint64_t& version) const {
+    auto to_json = [](const std::vector<LeaderboardEntry>& entries) {
+        json board = json::array();
+        for (const auto& entry : entries) {
+            board.push_back({{"player_name", entry.name}, {"winnings", money_to_double(entry.value)}});
+        }
+        return board;
+    };
+    
+    // Tablolar tek seferde alınır: ayrı ayrı okumalar arasında settlement araya girebilir
+    LeaderboardSnapshot boards = leaderboards.snapshot();
+    resp = json::object();
+    resp["round"] = boards.settled_round;
+    resp["round_top"] = to_json(boards.round_top);
+    resp["daily"] = to_json(boards.daily_top);
+    resp["all_time"] = to_json(boards.all_time_top);
+    version = boards.version;
+    return !boards.settling;
+}
+
+bool CrashGame::get_bet_history_json(const std::string& player_id, uint64_t cursor, size_t limit, json &resp) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(players_mutex);
+        if (players.find(player_id) == players.end()) return false;
+    }
+    
+    HistoryPage page = bet_history->query(player_id, cursor, limit);
+    json bets = json::array();
+    for (const auto& record : page.records) {
+        json bet_json;
+        bet_json["round"] = record.round;
+        bet_json["amount"] = money_to_double(record.amount);
+        bet_json["cashout_multiplier"] = record.multiplier_x100 / 100.0;
+        bet_json["winnings"] = money_to_double(record.payout);
+        bet_json["status"] = record.status == static_cast<uint8_t>(BetStatus::CASHED_OUT) ? "cashed_out" : "crashed";
+        bet_json["settled_at"] = record.settled_at_ms;
+        bets.push_back(bet_json);
+    }
+    
+    resp = json::object();
+    resp["bets"] = bets;
+    // İmleç istemciye opak string olarak verilir
+    resp["next_cursor"] = page.next_cursor == 0 ? json(nullptr) : json(std::to_string(page.next_cursor));
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "handoff.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace handoff {
+
+namespace {
+
+struct MessageHeader {
+    uint32_t magic;
+    uint32_t type;    // MessageType
+    uint64_t length;  // Gövde byte sayısı
+};
+static_assert(sizeof(MessageHeader) == 16, "Handoff başlığı sabit boyutlu olmalı");
+
+constexpr uint32_t MAGIC = 0x46444e48;  // "HNDF"
+
+std::string errno_text() {
+    return std::strerror(errno);
+}
+
+sockaddr_un socket_address(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Handoff soket yolu geçersiz: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+using Clock = std::chrono::steady_clock;
+
+// Süre dolana kadar okunabilir olmasını bekler
+void wait_readable(int fd, Clock::time_point deadline) {
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (left <= 0) throw std::runtime_error("Handoff mesajı zaman aşımına uğradı");
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(left));
+        if (ready > 0) return;
+        if (ready < 0 && errno != EINTR) throw std::runtime_error("Handoff soketi beklenemedi: " + errno_text());
+    }
+}
+
+void receive_exact(int fd, char* data, size_t size, Clock::time_point deadline) {
+    size_t received = 0;
+    while (received < size) {
+        wait_readable(fd, deadline);
+        ssize_t n = ::recv(fd, data + received, size - received, 0);
+        if (n == 0) throw std::runtime_error("Handoff bağlantısı kapandı");
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            throw std::runtime_error("Handoff soketi okunamadı: " + errno_text());
+        }
+        received += static_cast<size_t>(n);
+    }
+}
+
+void send_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Handoff soketine yazılamadı: " + errno_text());
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+}  // namespace
+
+int listen(const std::string& path) {
+    sockaddr_un addr = socket_address(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw std::runtime_error("Handoff soketi açılamadı: " + errno_text());
+    // Önceki sürecin dosyası: o süreç zaten kendi bağlantısıyla devrediyor veya yok
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, 1) < 0) {
+        std::string error = errno_text();
+        ::close(fd);
+        throw std::runtime_error("Handoff soketi dinlenemiyor (" + path + "): " + error);
+    }
+    return fd;
+}
+
+int connect(const std::string& path) {
+    sockaddr_un addr = socket_address(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw std::runtime_error("Handoff soketi açılamadı: " + errno_text());
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        int error = errno;
+        ::close(fd);
+        // Dosya yok veya sahibi çıkmış: devralınacak süreç yok
+        if (error == ENOENT || error == ECONNREFUSED) return -1;
+        throw std::runtime_error("Handoff soketine bağlanılamadı (" + path + "): " + std::strerror(error));
+    }
+    return fd;
+}
+
+int accept(int listen_fd, int timeout_ms) {
+    pollfd pfd{listen_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, timeout_ms) <= 0) return -1;
+    return ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+}
+
+void send_message(int fd, MessageType type, std::string_view payload, const std::vector<int>& fds) {
+    if (fds.size() > MAX_FDS) throw std::runtime_error("Handoff mesajında çok fazla fd");
+    MessageHeader header{MAGIC, static_cast<uint32_t>(type), payload.size()};
+
+    // fd'ler başlığın ilk byte'ına bağlanır; alıcı başlığı recvmsg ile okur
+    iovec iov{&header, sizeof(header)};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)];
+    if (!fds.empty()) {
+        std::memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    }
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0) throw std::runtime_error("Handoff mesajı gönderilemedi: " + errno_text());
+
+    const char* rest = reinterpret_cast<const char*>(&header) + sent;
+    send_all(fd, rest, sizeof(header) - static_cast<size_t>(sent));
+    send_all(fd, payload.data(), payload.size());
+}
+
+MessageType receive_message(int fd, std::string& payload, std::vector<int>& fds, int timeout_ms) {
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    MessageHeader header{};
+    iovec iov{&header, sizeof(header)};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        wait_readable(fd, deadline);
+        received = ::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && (errno == EINTR || errno == EAGAIN));
+    if (received == 0) throw std::runtime_error("Handoff bağlantısı kapandı");
+    if (received < 0) throw std::runtime_error("Handoff soketi okunamadı: " + errno_text());
+
+    fds.clear();
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; i++) {
+            int passed;
+            std::memcpy(&passed, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            fds.push_back(passed);
+        }
+    }
+
+    // Hata olursa gelen fd'ler sızmasın
+    try {
+        if (msg.msg_flags & MSG_CTRUNC) throw std::runtime_error("Handoff mesajında çok fazla fd");
+        receive_exact(fd, reinterpret_cast<char*>(&header) + received, sizeof(header) - static_cast<size_t>(received),
+                      deadline);
+        if (header.magic != MAGIC || header.length > MAX_PAYLOAD) {
+            throw std::runtime_error("Handoff mesajı bozuk");
+        }
+        payload.resize(static_cast<size_t>(header.length));
+        receive_exact(fd, payload.data(), payload.size(), deadline);
+    } catch (...) {
+        for (int passed : fds) ::close(passed);
+        fds.clear();
+        throw;
+    }
+    return static_cast<MessageType>(header.type);
+}
+
+bool peer_alive(int fd) {
+    pollfd pfd{fd, POLLIN | POLLRDHUP, 0};
+    if (::poll(&pfd, 1, 0) <= 0) return true;
+    return (pfd.revents & (POLLHUP | POLLERR | POLLRDHUP | POLLIN)) == 0;
+}
+
+namespace {
+
+// Bu süreçte port'a bağlı TCP soketleri: listening true ise dinleyiciler, false ise kabul edilmiş bağlantılar
+template <typename F>
+size_t for_each_socket(uint16_t port, bool listening, F&& on_socket) {
+    // Önce listele: dizin okunurken açılan fd'ler listeyi değiştirmesin
+    std::vector<int> candidates;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/fd", error)) {
+        const std::string name = entry.path().filename().string();
+        candidates.push_back(std::atoi(name.c_str()));
+    }
+
+    size_t matched = 0;
+    for (int fd : candidates) {
+        int accepting = 0;
+        socklen_t length = sizeof(accepting);
+        if (::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &accepting, &length) < 0) continue;
+        if ((accepting != 0) != listening) continue;
+        int type = 0;
+        length = sizeof(type);
+        if (::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) < 0 || type != SOCK_STREAM) continue;
+
+        sockaddr_storage addr{};
+        length = sizeof(addr);
+        if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length) < 0) continue;
+        uint16_t bound_port = 0;
+        if (addr.ss_family == AF_INET) {
+            bound_port = ntohs(reinterpret_cast<sockaddr_in*>(&addr)->sin_port);
+        } else if (addr.ss_family == AF_INET6) {
+            bound_port = ntohs(reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port);
+        } else {
+            continue;
+        }
+        if (bound_port != port) continue;
+        if (!listening) {
+            // Bağlanmamış (ör. retire_listeners'ın yer tutucusu) sayılmaz
+            sockaddr_storage peer{};
+            length = sizeof(peer);
+            if (::getpeername(fd, reinterpret_cast<sockaddr*>(&peer), &length) < 0) continue;
+        }
+        if (on_socket(fd, addr)) matched++;
+    }
+    return matched;
+}
+
+}  // namespace
+
+size_t retire_listeners(uint16_t port) {
+    return for_each_socket(port, true, [](int fd, const sockaddr_storage& addr) {
+        // Son referans kapanınca soket epoll kümesinden de düşer; numara sahibinde geçerli kalır
+        int placeholder = ::socket(addr.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (placeholder < 0) return false;
+        bool retired = ::dup3(placeholder, fd, O_CLOEXEC) >= 0;
+        ::close(placeholder);
+        return retired;
+    });
+}
+
+size_t open_connections(uint16_t port) {
+    return for_each_socket(port, false, [](int, const sockaddr_storage&) { return true; });
+}
+
+size_t close_connections(uint16_t port) {
+    return for_each_socket(port, false, [](int fd, const sockaddr_storage&) {
+        // fd sahibinde (Pistache) kalır: EOF görüp bağlantıyı kendisi kapatır
+        return ::shutdown(fd, SHUT_RDWR) == 0;
+    });
+}
+
+}  // namespace handoff
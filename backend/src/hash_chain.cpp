@@ -0,0 +1,348 @@
+#include "hash_chain.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Crash noktası işçilerinin bir seferde aldığı link sayısı
+constexpr uint64_t BATCH = 4096;
+
+std::string errno_text() {
+    return std::strerror(errno);
+}
+
+}  // namespace
+
+HashChain::HashChain(const std::string& chain_path, void* memory, size_t size)
+    : path(chain_path),
+      mapping(memory),
+      mapping_size(size),
+      header(static_cast<Header*>(memory)),
+      links(static_cast<const uint8_t*>(memory) + sizeof(Header)),
+      crash_points(reinterpret_cast<const uint32_t*>(links + header->length * HASH_SIZE)),
+      rounds(const_cast<uint32_t*>(crash_points) + header->length) {}
+
+HashChain::~HashChain() {
+    ::munmap(mapping, mapping_size);
+}
+
+size_t HashChain::file_size(uint64_t length) {
+    return sizeof(Header) + static_cast<size_t>(length) * (HASH_SIZE + 2 * sizeof(uint32_t));
+}
+
+unsigned HashChain::worker_count(int threads) {
+    if (threads > 0) return static_cast<unsigned>(threads);
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::shared_ptr<HashChain> HashChain::open_or_generate(const HashChainConfig& config) {
+    if (!std::filesystem::exists(config.path)) {
+        generate(config);
+    }
+    std::shared_ptr<HashChain> chain = open(config.path, config.threads);
+    if (chain->salt() != config.salt) {
+        throw std::runtime_error("Hash zinciri farklı bir tuzla üretilmiş: " + config.path);
+    }
+    return chain;
+}
+
+void HashChain::generate(const HashChainConfig& config) {
+    if (config.length == 0) {
+        throw std::runtime_error("Hash zinciri uzunluğu 0 olamaz");
+    }
+    if (config.salt.size() > MAX_SALT) {
+        throw std::runtime_error("Hash zinciri tuzu en fazla 64 byte olabilir");
+    }
+
+    std::string temp_path = config.path + ".tmp";
+    int fd = ::open(temp_path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Hash zinciri dosyası açılamadı (" + temp_path + "): " + errno_text());
+    }
+    const uint64_t length = config.length;
+    const size_t size = file_size(length);
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        std::string error = errno_text();
+        ::close(fd);
+        throw std::runtime_error("Hash zinciri dosyası boyutlandırılamadı: " + error);
+    }
+    void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::string error = errno_text();
+        ::close(fd);
+        throw std::runtime_error("Hash zinciri dosyası map edilemedi: " + error);
+    }
+
+    Header* header = new (memory) Header();
+    uint8_t* links = static_cast<uint8_t*>(memory) + sizeof(Header);
+    uint32_t* points = reinterpret_cast<uint32_t*>(links + length * HASH_SIZE);
+
+    // Tohum sadece bellekte: link[length - 1] = sha256(tohum)
+    Hash link;
+    if (RAND_bytes(link.data(), static_cast<int>(link.size())) != 1) {
+        ::munmap(memory, size);
+        ::close(fd);
+        throw std::runtime_error("Hash zinciri tohumu üretilemedi");
+    }
+
+    // Zincir doğası gereği sıralıdır: tek thread sondan başa hash'ler ve her batch'ten sonra
+    // ilerlemeyi yayınlar. Crash noktaları linkten bağımsızdır; işçiler hazır olan batch'leri
+    // zincir ilerlerken paralel hesaplar.
+    std::atomic<uint64_t> chained_from{length};  // [chained_from, length) yazıldı
+    std::atomic<uint64_t> next_batch{0};
+    uint64_t batches = (length + BATCH - 1) / BATCH;
+    auto compute_points = [&]() {
+        for (uint64_t batch = next_batch.fetch_add(1); batch < batches; batch = next_batch.fetch_add(1)) {
+            // Batch'ler de sondan başa: zincirin önce bitirdiği kısım
+            uint64_t begin = (batches - 1 - batch) * BATCH;
+            uint64_t end = std::min(length, begin + BATCH);
+            while (chained_from.load(std::memory_order_acquire) > begin) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = begin; i < end; i++) {
+                Hash current;
+                std::memcpy(current.data(), links + i * HASH_SIZE, HASH_SIZE);
+                points[i] = crash_point_x100(current, config.salt);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < worker_count(config.threads); i++) {
+        workers.emplace_back(compute_points);
+    }
+
+    for (uint64_t i = length; i-- > 0;) {
+        link = sha256(link.data(), link.size());
+        std::memcpy(links + i * HASH_SIZE, link.data(), HASH_SIZE);
+        if (i % BATCH == 0) chained_from.store(i, std::memory_order_release);
+    }
+    for (auto& worker : workers) worker.join();
+
+    Hash terminal = sha256(links, HASH_SIZE);
+    std::memcpy(header->terminal, terminal.data(), HASH_SIZE);
+    header->length = length;
+    header->salt_length = static_cast<uint32_t>(config.salt.size());
+    std::memcpy(header->salt, config.salt.data(), config.salt.size());
+
+    // Önce veri, sonra magic: yarıda kesilen üretim açılışta reddedilir
+    bool synced = ::msync(memory, size, MS_SYNC) == 0;
+    header->magic = Header::MAGIC;
+    synced = synced && ::msync(memory, sizeof(Header), MS_SYNC) == 0;
+    ::munmap(memory, size);
+    ::close(fd);
+    if (!synced || std::rename(temp_path.c_str(), config.path.c_str()) != 0) {
+        std::string error = errno_text();
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Hash zinciri dosyası yazılamadı: " + error);
+    }
+}
+
+std::shared_ptr<HashChain> HashChain::open(const std::string& chain_path, int threads) {
+    int fd = ::open(chain_path.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Hash zinciri dosyası açılamadı (" + chain_path + "): " + errno_text());
+    }
+    struct stat info;
+    if (::fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Hash zinciri dosyası bozuk: " + chain_path);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("Hash zinciri dosyası map edilemedi: " + errno_text());
+    }
+
+    const Header* header = static_cast<const Header*>(memory);
+    if (header->magic != Header::MAGIC || header->length == 0 || file_size(header->length) != size ||
+        header->salt_length > MAX_SALT || header->next.load() > header->length ||
+        header->revealed.load() > header->next.load()) {
+        ::munmap(memory, size);
+        throw std::runtime_error("Hash zinciri dosyası bozuk: " + chain_path);
+    }
+
+    std::shared_ptr<HashChain> chain(new HashChain(chain_path, memory, size));
+    if (!chain->verify(worker_count(threads))) {
+        throw std::runtime_error("Hash zinciri doğrulanamadı: " + chain_path);
+    }
+    return chain;
+}
+
+uint32_t HashChain::last_taken_round(const std::string& chain_path) {
+    int fd = ::open(chain_path.c_str(), O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat info;
+    if (::fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return 0;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) return 0;
+
+    const Header* header = static_cast<const Header*>(memory);
+    uint32_t last = 0;
+    if (header->magic == Header::MAGIC && header->length > 0 && file_size(header->length) == size &&
+        header->next.load() <= header->length) {
+        const uint8_t* chain_links = static_cast<const uint8_t*>(memory) + sizeof(Header);
+        const uint32_t* chain_rounds = reinterpret_cast<const uint32_t*>(chain_links + header->length * HASH_SIZE) +
+                                       header->length;
+        for (uint64_t i = 0, taken = header->next.load(); i < taken; i++) {
+            last = std::max(last, chain_rounds[i]);
+        }
+    }
+    ::munmap(memory, size);
+    return last;
+}
+
+bool HashChain::verify(unsigned threads) const {
+    // Her link bir öncekine (ilki yayınlanan uca) bağlanmalı ve crash noktası tutmalı;
+    // kontroller birbirinden bağımsız olduğundan aralıklara bölünür
+    const uint64_t length = header->length;
+    const std::string chain_salt = salt();
+    std::atomic<bool> valid{true};
+    auto check = [&](uint64_t begin, uint64_t end) {
+        for (uint64_t i = begin; i < end && valid.load(std::memory_order_relaxed); i++) {
+            Hash link;
+            std::memcpy(link.data(), links + i * HASH_SIZE, HASH_SIZE);
+            Hash next = sha256(link.data(), link.size());
+            const uint8_t* expected = i == 0 ? header->terminal : links + (i - 1) * HASH_SIZE;
+            if (std::memcmp(next.data(), expected, HASH_SIZE) != 0 ||
+                crash_points[i] != crash_point_x100(link, chain_salt)) {
+                valid = false;
+            }
+        }
+    };
+
+    uint64_t per_thread = (length + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (uint64_t begin = 0; begin < length; begin += per_thread) {
+        workers.emplace_back(check, begin, std::min(length, begin + per_thread));
+    }
+    for (auto& worker : workers) worker.join();
+    return valid.load();
+}
+
+bool HashChain::take(uint64_t& index, uint32_t& crash_point_x100, uint32_t round) {
+    // Tek yazıcı: oyun thread'i (game_mutex altında)
+    uint64_t next = header->next.load(std::memory_order_relaxed);
+    if (next >= header->length) return false;
+    // Okuyucular sadece açıklanmış linklerin round'una bakar; reveal'in release'i yayınlar
+    rounds[next] = round;
+    header->next.store(next + 1, std::memory_order_release);
+    index = next;
+    crash_point_x100 = crash_points[next];
+    return true;
+}
+
+void HashChain::reveal(uint64_t index) {
+    uint64_t count = std::min(index + 1, header->next.load(std::memory_order_relaxed));
+    if (count > header->revealed.load(std::memory_order_relaxed)) {
+        header->revealed.store(count, std::memory_order_release);
+    }
+}
+
+bool HashChain::revealed_link(uint64_t index, Hash& link, uint32_t& crash_point_x100) const {
+    if (index >= header->revealed.load(std::memory_order_acquire)) return false;
+    std::memcpy(link.data(), links + index * HASH_SIZE, HASH_SIZE);
+    crash_point_x100 = crash_points[index];
+    return true;
+}
+
+uint32_t HashChain::link_round(uint64_t index) const {
+    if (index >= header->revealed.load(std::memory_order_acquire)) return 0;
+    return rounds[index];
+}
+
+bool HashChain::find_revealed_round(uint32_t round, uint64_t& index) const {
+    if (round == 0) return false;
+    // Round'lar linkleri sırayla aldığından arama sondan başlar; eşleşme genelde son birkaç linktedir
+    for (uint64_t i = header->revealed.load(std::memory_order_acquire); i-- > 0;) {
+        if (rounds[i] == round) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t HashChain::length() const {
+    return header->length;
+}
+
+uint64_t HashChain::next_index() const {
+    return header->next.load(std::memory_order_acquire);
+}
+
+uint64_t HashChain::revealed_count() const {
+    return header->revealed.load(std::memory_order_acquire);
+}
+
+HashChain::Hash HashChain::terminal_hash() const {
+    Hash terminal;
+    std::memcpy(terminal.data(), header->terminal, HASH_SIZE);
+    return terminal;
+}
+
+std::string HashChain::salt() const {
+    return std::string(header->salt, header->salt_length);
+}
+
+const std::string& HashChain::get_path() const {
+    return path;
+}
+
+HashChain::Hash HashChain::sha256(const uint8_t* data, size_t size) {
+    Hash hash;
+    SHA256(data, size, hash.data());
+    return hash;
+}
+
+uint32_t HashChain::crash_point_x100(const Hash& link, std::string_view salt) {
+    static const unsigned char empty = 0;
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    unsigned int mac_length = 0;
+    HMAC(EVP_sha256(), link.data(), static_cast<int>(link.size()),
+         salt.empty() ? &empty : reinterpret_cast<const unsigned char*>(salt.data()), salt.size(),
+         mac, &mac_length);
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 7; i++) bits = (bits << 8) | mac[i];
+    bits >>= 4;  // 52 bit: double'a kayıpsız sığar
+    double random_value = static_cast<double>(bits + 1) / 4503599627370496.0;  // (0, 1]
+
+    // calculate_crash_point ile aynı dağılım: %1 house edge, 1.01x - 10.00x
+    double crash_point = 0.99 / random_value;
+    if (crash_point < 1.01) crash_point = 1.01;
+    if (crash_point > 10.0) crash_point = 10.0;
+    return static_cast<uint32_t>(std::lround(crash_point * 100.0));
+}
+
+std::string HashChain::to_hex(const Hash& hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(HASH_SIZE * 2);
+    for (uint8_t byte : hash) {
+        hex += digits[byte >> 4];
+        hex += digits[byte & 0x0f];
+    }
+    return hex;
+}
@@ -0,0 +1,76 @@
+#include "http_helpers.h"
+#include "tick_protocol.h"
+#include <cstdlib>
+#include <strings.h>
+
+void HttpHelpers::enableCors(Http::ResponseWriter& response) {
+    response.headers()
+        .add<Http::Header::AccessControlAllowOrigin>("*")
+        .add<Http::Header::AccessControlAllowMethods>("GET, POST, PUT, OPTIONS")
+        .add<Http::Header::AccessControlAllowHeaders>("Content-Type, If-None-Match, Idempotency-Key")
+        .add<Http::Header::AccessControlExposeHeaders>("ETag, Idempotent-Replayed");
+}
+
+std::string HttpHelpers::getHeaderValue(const Rest::Request& request, const std::string& name) {
+    for (const auto& entry : request.headers().rawList()) {
+        if (strcasecmp(entry.first.c_str(), name.c_str()) == 0) {
+            return entry.second.value();
+        }
+    }
+    return "";
+}
+
+void HttpHelpers::sendCached(const Rest::Request& request, Http::ResponseWriter& response,
+                             const std::shared_ptr<const CachedResponse>& cached,
+                             const Http::Mime::MediaType& mime, const std::string& cache_control) {
+    ContentCoding coding = cached->effective_coding(
+        Compression::negotiate(getHeaderValue(request, "Accept-Encoding")));
+    std::string etag = cached->encoded_etag(coding);
+    
+    response.headers()
+        .addRaw(Http::Header::Raw("ETag", etag))
+        .addRaw(Http::Header::Raw("Vary", "Accept-Encoding"))
+        .addRaw(Http::Header::Raw("Cache-Control", cache_control));
+
+    // İstemcideki kopya hâlâ güncel: sadece header gönder
+    if (ResponseCache::etag_matches(getHeaderValue(request, "If-None-Match"), etag)) {
+        response.send(Http::Code::Not_Modified);
+        return;
+    }
+
+    if (coding != ContentCoding::IDENTITY) {
+        response.headers().addRaw(Http::Header::Raw("Content-Encoding", Compression::coding_name(coding)));
+    }
+    response.headers().add<Http::Header::ContentType>(mime);
+    response.send(Http::Code::Ok, cached->encoded_body(coding));
+}
+
+bool HttpHelpers::acceptsBinaryTick(const Rest::Request& request) {
+    return getHeaderValue(request, "Accept").find(tick_protocol::CONTENT_TYPE) != std::string::npos;
+}
+
+const Http::Mime::MediaType& HttpHelpers::binaryTickMime() {
+    static const Http::Mime::MediaType mime = Http::Mime::MediaType::fromString(tick_protocol::CONTENT_TYPE);
+    return mime;
+}
+
+bool HttpHelpers::getSinceVersion(const Rest::Request& request, uint64_t& since) {
+    auto value = request.query().get("since");
+    if (!value || value->empty()) return false;
+    char* end = nullptr;
+    since = std::strtoull(value->c_str(), &end, 10);
+    return *end == '\0';
+}
+
+void HttpHelpers::sendStatusToWaiters(std::vector<Http::ResponseWriter>& waiters, const std::string& body,
+                                      bool close_connection) {
+    for (auto& response : waiters) {
+        enableCors(response);
+        if (close_connection) response.headers().addRaw(Http::Header::Raw("Connection", "close"));
+        response.headers()
+            .addRaw(Http::Header::Raw("Vary", "Accept"))
+            .add<Http::Header::ContentType>(MIME(Application, Json));
+        // Bağlantı bu arada kapandıysa Pistache promise'i reddeder; beklemiyoruz
+        response.send(Http::Code::Ok, body);
+    }
+}
@@ -0,0 +1,135 @@
+#include "idempotency_cache.h"
+#include <algorithm>
+#include <cstring>
+
+IdempotencyCache::IdempotencyCache(const IdempotencyConfig& cache_config)
+    : config(cache_config), accepted(0), replayed(0), conflicts(0), evicted(0), full(0) {
+    size_t size = PROBE;
+    while (size < config.slots) size <<= 1;
+    slot_mask = size - 1;
+    entries.assign(size, Entry{0, 0, 0, 0});
+}
+
+uint64_t IdempotencyCache::hash_key(std::string_view player_id, std::string_view key) {
+    // FNV-1a + ayırıcı ("ab"+"c" ile "a"+"bc" çakışmasın); 0 boş slot için ayrılmış
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](std::string_view text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(player_id);
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+    mix(key);
+    return hash == 0 ? 1 : hash;
+}
+
+IdempotencyCache::Entry* IdempotencyCache::find_locked(uint64_t key_hash, int64_t now_ms) {
+    // Pozisyon hash'in üst bitlerinden: FNV'nin alt bitleri zayıf dağılır
+    size_t start = static_cast<size_t>((key_hash * 0x9E3779B97F4A7C15ULL) >> 16);
+    for (size_t i = 0; i < PROBE; i++) {
+        Entry& entry = entries[(start + i) & slot_mask];
+        if (entry.key_hash == key_hash && entry.expires_at_ms > now_ms) return &entry;
+    }
+    return nullptr;
+}
+
+IdempotencyStatus IdempotencyCache::begin(std::string_view player_id, std::string_view key,
+                                          uint64_t request_hash, int64_t now_ms) {
+    uint64_t key_hash = hash_key(player_id, key);
+    std::lock_guard<std::mutex> lock(table_mutex);
+    
+    if (Entry* existing = find_locked(key_hash, now_ms)) {
+        if (existing->request_hash != request_hash) {
+            conflicts++;
+            return IdempotencyStatus::MISMATCH;
+        }
+        auto status = static_cast<IdempotencyStatus>(existing->state);
+        if (status == IdempotencyStatus::IN_PROGRESS) conflicts++;
+        else replayed++;
+        return status;
+    }
+    
+    // Penceredeki ilk boş / süresi dolmuş slot; yoksa süresi en yakın tamamlanmış kaydın yerine
+    size_t start = static_cast<size_t>((key_hash * 0x9E3779B97F4A7C15ULL) >> 16);
+    Entry* victim = nullptr;
+    for (size_t i = 0; i < PROBE; i++) {
+        Entry& entry = entries[(start + i) & slot_mask];
+        if (entry.key_hash == 0 || entry.expires_at_ms <= now_ms) {
+            victim = &entry;
+            break;
+        }
+        if (entry.state == static_cast<uint8_t>(IdempotencyStatus::IN_PROGRESS)) continue;
+        if (!victim || entry.expires_at_ms < victim->expires_at_ms) victim = &entry;
+    }
+    if (!victim) {
+        full++;
+        return IdempotencyStatus::FULL;
+    }
+    if (victim->key_hash != 0 && victim->expires_at_ms > now_ms) evicted++;
+    
+    *victim = Entry{key_hash, request_hash, now_ms + config.ttl_ms, static_cast<uint8_t>(IdempotencyStatus::IN_PROGRESS)};
+    accepted++;
+    return IdempotencyStatus::NEW;
+}
+
+void IdempotencyCache::complete(std::string_view player_id, std::string_view key, bool success, int64_t now_ms) {
+    uint64_t key_hash = hash_key(player_id, key);
+    std::lock_guard<std::mutex> lock(table_mutex);
+    // Bu arada silindiyse yapacak bir şey yok: sonraki tekrar yeni istek sayılır
+    if (Entry* entry = find_locked(key_hash, now_ms)) {
+        entry->state = static_cast<uint8_t>(success ? IdempotencyStatus::SUCCEEDED : IdempotencyStatus::FAILED);
+    }
+}
+
+void IdempotencyCache::forget(std::string_view player_id, std::string_view key) {
+    uint64_t key_hash = hash_key(player_id, key);
+    std::lock_guard<std::mutex> lock(table_mutex);
+    if (Entry* entry = find_locked(key_hash, INT64_MIN)) {
+        *entry = Entry{0, 0, 0, 0};
+    }
+}
+
+std::string IdempotencyCache::save_entries(int64_t now_ms) const {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    std::string data;
+    for (const Entry& entry : entries) {
+        // Yarım kalan istek devredilmez: yeni süreçte tekrarı yeni istek sayılır
+        if (entry.key_hash == 0 || entry.expires_at_ms <= now_ms ||
+            entry.state == static_cast<uint8_t>(IdempotencyStatus::IN_PROGRESS)) continue;
+        data.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    return data;
+}
+
+size_t IdempotencyCache::restore_entries(std::string_view data, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    size_t restored = 0;
+    // Tablo boyutu değişmiş olabilir: her kayıt kendi penceresine yeniden yerleştirilir
+    for (size_t offset = 0; offset + sizeof(Entry) <= data.size(); offset += sizeof(Entry)) {
+        Entry incoming;
+        std::memcpy(&incoming, data.data() + offset, sizeof(Entry));
+        if (incoming.key_hash == 0 || incoming.expires_at_ms <= now_ms) continue;
+        size_t start = static_cast<size_t>((incoming.key_hash * 0x9E3779B97F4A7C15ULL) >> 16);
+        for (size_t i = 0; i < PROBE; i++) {
+            Entry& entry = entries[(start + i) & slot_mask];
+            if (entry.key_hash == 0 || entry.expires_at_ms <= now_ms) {
+                entry = incoming;
+                restored++;
+                break;
+            }
+        }
+    }
+    return restored;
+}
+
+IdempotencyStats IdempotencyCache::get_stats() const {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    return IdempotencyStats{accepted, replayed, conflicts, evicted, full};
+}
+
+size_t IdempotencyCache::capacity() const {
+    return entries.size();
+}
@@ -0,0 +1,96 @@
+#include "journal_replay.h"
+
+JournalReplayer::JournalReplayer() {
+    reset_game();
+}
+
+void JournalReplayer::reset_game() {
+    // Test modu sadece süreleri ve round log'larını etkiler; replay update() çağırmaz
+    game = std::make_unique<CrashGame>(true);
+    game->set_session_ttl_ms(0);  // Silmeler EVICT kayıtlarından gelir
+    game->set_action_logging(false);
+}
+
+const ReplayStats& JournalReplayer::run(JournalReader& reader) {
+    JournalEntry entry;
+    while (reader.next(entry)) {
+        if (stats.records == 0) stats.first_at_ms = entry.at_ms;
+        stats.last_at_ms = entry.at_ms;
+        stats.records++;
+        apply(entry);
+    }
+    return stats;
+}
+
+void JournalReplayer::apply(const JournalEntry& entry) {
+    player_id.assign(entry.player_id.data(), entry.player_id.size());
+    bool ok = true;
+
+    switch (entry.type) {
+        case JournalType::START:
+            if (stats.records > 1) reset_game();
+            game->set_first_round(static_cast<int>(entry.round));
+            stats.starts++;
+            break;
+        case JournalType::HANDOFF:
+            // Durum bellekten aktarıldı, sıfırlanmaz: kayıtlar önceki süreçten devam eder
+            stats.handoffs++;
+            break;
+        case JournalType::ADD_PLAYER:
+            name.assign(entry.name.data(), entry.name.size());
+            ok = game->add_player(player_id, name);
+            stats.commands++;
+            break;
+        case JournalType::BET:
+            ok = game->place_bet(player_id, entry.value);
+            stats.commands++;
+            break;
+        case JournalType::CASHOUT:
+            ok = game->cashout_at(player_id, entry.value / 100.0);
+            stats.commands++;
+            break;
+        case JournalType::LOAD_BALANCE:
+            ok = game->load_balance(player_id, entry.value);
+            stats.commands++;
+            break;
+        case JournalType::WITHDRAW:
+            ok = game->withdraw_balance(player_id, entry.value);
+            stats.commands++;
+            break;
+        case JournalType::EVICT:
+            ok = game->remove_player(player_id);
+            stats.commands++;
+            break;
+        case JournalType::RELOAD:
+            ok = game->get_player(player_id) != nullptr;
+            stats.commands++;
+            break;
+        case JournalType::FLY:
+            ok = game->get_phase() == GamePhase::WAITING;
+            game->start_flying_phase(entry.value / 100.0);
+            break;
+        case JournalType::CRASH:
+            ok = game->get_phase() == GamePhase::FLYING;
+            game->end_game();
+            break;
+        case JournalType::NEW_ROUND:
+            game->start_next_round();
+            ok = game->get_current_round() == static_cast<int>(entry.round);
+            stats.rounds++;
+            break;
+        case JournalType::CHECKPOINT:
+            stats.checkpoints++;
+            if (game->balance_checksum() != static_cast<uint64_t>(entry.value)) {
+                if (!stats.diverged()) stats.first_mismatch_round = entry.round;
+                stats.checkpoint_mismatches++;
+            }
+            break;
+    }
+
+    if (!ok) reject(entry);
+}
+
+void JournalReplayer::reject(const JournalEntry& entry) {
+    if (!stats.diverged()) stats.first_mismatch_round = entry.round;
+    stats.rejected++;
+}
@@ -1,5 +1,9 @@
 #include "json_utils.h"
 #include "game.h"
+#include "hash_chain.h"
+#include "balance_import.h"
+#include "trace.h"
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
@@ -47,6 +51,23 @@ json JsonUtils::parseRequest(const std::string& body) {
     }
 }
 
+std::string JsonUtils::peekString(const std::string& body, const std::string& key) {
+    const std::string quotedKey = "\"" + key + "\"";
+    size_t pos = body.find(quotedKey);
+    if (pos == std::string::npos) return "";
+    
+    pos = body.find_first_not_of(" \t\r\n", pos + quotedKey.size());
+    if (pos == std::string::npos || body[pos] != ':') return "";
+    
+    pos = body.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos || body[pos] != '"') return "";
+    
+    size_t end = body.find_first_of("\"\\", pos + 1);
+    if (end == std::string::npos || body[end] != '"') return "";
+    
+    return body.substr(pos + 1, end - pos - 1);
+}
+
 // 🔍 VALIDATION METHODS
 
 bool JsonUtils::validateJoinRequest(const json& request) {
@@ -59,12 +80,13 @@ bool JsonUtils::validateJoinRequest(const json& request) {
 }
 
 bool JsonUtils::validateBetRequest(const json& request) {
+    Money amount = 0;
     return request.contains("player_id") && 
            request.contains("amount") &&
            request["player_id"].is_string() &&
-           request["amount"].is_number() &&
            !request["player_id"].get<std::string>().empty() &&
-           request["amount"].get<double>() > 0;
+           getMoney(request, "amount", amount) &&
+           amount > 0;
 }
 
 bool JsonUtils::validateCashoutRequest(const json& request) {
@@ -103,9 +125,35 @@ bool JsonUtils::getBool(const json& obj, const std::string& key, bool defaultVal
     return defaultValue;
 }
 
+bool JsonUtils::getMoney(const json& obj, const std::string& key, Money& out) {
+    // 1e12 TL üstü hem anlamsız hem de kuruş çarpımında taşma riski
+    constexpr double MAX_TL = 1e12;
+    
+    if (!obj.contains(key) || !obj[key].is_number()) return false;
+    
+    if (obj[key].is_number_integer()) {
+        if (obj[key].is_number_unsigned()) {
+            if (obj[key].get<uint64_t>() > static_cast<uint64_t>(MAX_TL)) return false;
+        } else if (obj[key].get<int64_t>() < 0 || obj[key].get<int64_t>() > static_cast<int64_t>(MAX_TL)) {
+            return false;
+        }
+        out = obj[key].get<int64_t>() * MONEY_SCALE;
+        return true;
+    }
+    
+    double tl = obj[key].get<double>();
+    if (!(tl >= 0.0 && tl <= MAX_TL)) return false;  // NaN da buradan döner
+    Money amount = money_from_double(tl);
+    // 12.34 double'da tam temsil edilemez ama 1234/100 aynı double'a döner; 12.345 dönmez
+    if (money_to_double(amount) != tl) return false;
+    out = amount;
+    return true;
+}
+
 // 🎮 GAME STATE SERIALIZATION
 
 json GameStateSerializer::serializeGameState(const CrashGame& game) {
+    TRACE_SPAN("serialize.game_state");
     json gameState;
     
     // Ana oyun bilgileri
@@ -114,11 +162,17 @@ json GameStateSerializer::serializeGameState(const CrashGame& game) {
     gameState["multiplier"] = game.get_multiplier();
     gameState["remaining_time_ms"] = game.get_remaining_time_ms();
     gameState["active_bets"] = game.get_active_bet_count();
+    gameState["version"] = game.get_status_version();
     
     // Crash bilgisi (sadece crashed phase'de)
     if (game.get_phase_string() == "crashed") {
         gameState["crash_point"] = game.get_crash_point();
     }
+    // Uçan / crash olan round'un zincir linki; null ise crash noktası RNG'den (doğrulanamaz)
+    if (game.get_phase_string() != "waiting") {
+        int64_t chain_index = game.get_round_chain_index();
+        gameState["chain_index"] = chain_index >= 0 ? json(chain_index) : json(nullptr);
+    }
     
     // Timestamp
     gameState["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -128,22 +182,224 @@ json GameStateSerializer::serializeGameState(const CrashGame& game) {
     return gameState;
 }
 
+tick_protocol::Tick GameStateSerializer::serializeTick(const CrashGame& game) {
+    tick_protocol::Tick tick;
+    tick.round = static_cast<uint32_t>(game.get_round());
+    tick.multiplier_x100 = multiplier_to_x100(game.get_multiplier());
+    tick.remaining_time_ms = static_cast<uint32_t>(std::max(0, game.get_remaining_time_ms()));
+    tick.active_bets = static_cast<uint32_t>(game.get_active_bet_count());
+    tick.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    
+    switch (game.get_phase()) {
+        case GamePhase::WAITING: tick.phase = tick_protocol::Phase::WAITING; break;
+        case GamePhase::FLYING: tick.phase = tick_protocol::Phase::FLYING; break;
+        case GamePhase::CRASHED:
+            tick.phase = tick_protocol::Phase::CRASHED;
+            tick.crash_point_x100 = multiplier_to_x100(game.get_crash_point());
+            break;
+    }
+    return tick;
+}
+
+GameSnapshot GameStateSerializer::captureSnapshot(const CrashGame& game) {
+    tick_protocol::Tick tick = serializeTick(game);
+    
+    GameSnapshot snapshot{};
+    snapshot.round = tick.round;
+    snapshot.multiplier_x100 = tick.multiplier_x100;
+    snapshot.crash_point_x100 = tick.crash_point_x100;
+    snapshot.remaining_time_ms = tick.remaining_time_ms;
+    snapshot.active_bets = tick.active_bets;
+    snapshot.phase = static_cast<uint8_t>(tick.phase);
+    snapshot.bets_version = game.get_bets_version();
+    snapshot.history_version = game.get_history_version();
+    snapshot.status_version = game.get_status_version();
+    snapshot.chain_index = tick.phase == tick_protocol::Phase::WAITING ? -1 : game.get_round_chain_index();
+    snapshot.published_at_ms = CrashGame::now_ms();
+    
+    std::vector<double> crash_points = game.get_old_crash_points();
+    size_t skip = crash_points.size() > GameSnapshot::MAX_CRASH_POINTS ?
+        crash_points.size() - GameSnapshot::MAX_CRASH_POINTS : 0;
+    for (size_t i = skip; i < crash_points.size(); i++) {
+        snapshot.crash_points_x100[snapshot.crash_point_count++] = multiplier_to_x100(crash_points[i]);
+    }
+    return snapshot;
+}
+
+json GameStateSerializer::serializeSnapshot(const GameSnapshot& snapshot, int64_t now_ms) {
+    TRACE_SPAN("serialize.snapshot");
+    static const char* phase_names[] = {"waiting", "flying", "crashed"};
+    tick_protocol::Tick tick = serializeTick(snapshot, now_ms);
+    
+    json gameState;
+    gameState["round"] = tick.round;
+    gameState["phase"] = phase_names[snapshot.phase <= 2 ? snapshot.phase : 0];
+    gameState["multiplier"] = tick.multiplier_x100 / 100.0;
+    gameState["remaining_time_ms"] = tick.remaining_time_ms;
+    gameState["active_bets"] = tick.active_bets;
+    gameState["version"] = snapshot.status_version;
+    if (tick.phase == tick_protocol::Phase::CRASHED) {
+        gameState["crash_point"] = tick.crash_point_x100 / 100.0;
+    }
+    if (tick.phase != tick_protocol::Phase::WAITING) {
+        gameState["chain_index"] = snapshot.chain_index >= 0 ? json(snapshot.chain_index) : json(nullptr);
+    }
+    gameState["timestamp"] = tick.timestamp_ms;
+    return gameState;
+}
+
+json GameStateSerializer::serializeCrashPoints(const GameSnapshot& snapshot) {
+    json crashPoints = json::array();
+    for (size_t i = 0; i < snapshot.crash_point_count && i < GameSnapshot::MAX_CRASH_POINTS; i++) {
+        crashPoints.push_back(snapshot.crash_points_x100[i] / 100.0);
+    }
+    return crashPoints;
+}
+
+tick_protocol::Tick GameStateSerializer::serializeTick(const GameSnapshot& snapshot, int64_t now_ms) {
+    tick_protocol::Tick tick;
+    tick.round = snapshot.round;
+    tick.phase = static_cast<tick_protocol::Phase>(snapshot.phase);
+    tick.multiplier_x100 = snapshot.multiplier_x100;
+    tick.crash_point_x100 = snapshot.crash_point_x100;
+    tick.active_bets = snapshot.active_bets;
+    
+    // Yayından bu yana geçen süre kadar geri sayımı ilerlet
+    int64_t elapsed = std::max<int64_t>(0, now_ms - snapshot.published_at_ms);
+    tick.remaining_time_ms = static_cast<uint32_t>(std::max<int64_t>(0, snapshot.remaining_time_ms - elapsed));
+    tick.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    return tick;
+}
+
 json GameStateSerializer::serializePlayer(const Player& player) {
     json playerJson;
     playerJson["id"] = player.get_id();
     playerJson["name"] = player.get_name();
-    playerJson["balance"] = player.get_balance();
+    playerJson["balance"] = money_to_double(player.get_balance());
     
     return playerJson;
 }
 
 json GameStateSerializer::serializeBet(const Bet& bet) {
     json betJson;
-    betJson["player_id"] = bet.get_player_id();
-    betJson["amount"] = bet.get_amount();
+    betJson["player_id"] = std::string(bet.get_player_id());
+    betJson["amount"] = money_to_double(bet.get_amount());
     betJson["cashout_multiplier"] = bet.get_cashout_multiplier();
     betJson["status"] = static_cast<int>(bet.get_status());
     betJson["game_round"] = bet.get_game_round();
     
     return betJson;
-}
\ No newline at end of file
+}
+
+// 📊 EXPOSURE SERIALIZATION
+
+json GameStateSerializer::serializeRoundAggregates(const RoundAggregates& aggregates) {
+    json histogram = json::array();
+    for (size_t i = 0; i < EXPOSURE_BUCKETS; i++) {
+        json bucket;
+        bucket["min"] = (i == 0 ? 100 : EXPOSURE_BOUNDS_X100[i - 1]) / 100.0;
+        bucket["max"] = i < EXPOSURE_BOUNDS_X100.size() ? json(EXPOSURE_BOUNDS_X100[i] / 100.0) : json(nullptr);
+        bucket["count"] = aggregates.cashout_histogram[i];
+        histogram.push_back(bucket);
+    }
+    
+    json round;
+    round["round"] = aggregates.round;
+    round["bets"] = aggregates.bets;
+    round["wagered"] = money_to_double(aggregates.wagered);
+    round["active_stake"] = money_to_double(aggregates.active_stake);
+    round["cashouts"] = aggregates.cashouts;
+    round["paid_out"] = money_to_double(aggregates.paid_out);
+    round["lost"] = money_to_double(aggregates.lost);
+    round["cashout_histogram"] = histogram;
+    return round;
+}
+
+json GameStateSerializer::serializeExposure(const CrashGame& game) {
+    TRACE_SPAN("serialize.exposure");
+    const ExposureTracker& exposure = game.get_exposure();
+    int round = game.get_round();
+    uint32_t multiplier_x100 = multiplier_to_x100(game.get_multiplier());
+    RoundAggregates current = exposure.get_round(round);
+    
+    json result;
+    result["round"] = round;
+    result["phase"] = game.get_phase_string();
+    result["multiplier"] = multiplier_x100 / 100.0;
+    result["current"] = serializeRoundAggregates(current);
+    // Herkes şimdi cashout yapsa ödenecek tutar ve o durumda kasanın round sonucu
+    Money liability = game.get_phase() == GamePhase::FLYING ? current.liability(multiplier_x100) : 0;
+    result["current"]["liability"] = money_to_double(liability);
+    result["current"]["house_result"] = money_to_double(current.wagered - current.paid_out - liability);
+    result["next"] = serializeRoundAggregates(exposure.get_round(round + 1));
+    RoundAggregates last = exposure.get_last_round();
+    result["last"] = last.round > 0 ? serializeRoundAggregates(last) : json(nullptr);
+    return result;
+}
+
+// 📥 BALANCE IMPORT SERIALIZATION
+
+json GameStateSerializer::serializeImportReport(const BalanceImportReport& report) {
+    // Ayrıştırma hataları hemen, oyuncu bulunamadı hataları batch uygulanınca eklenir
+    std::vector<ImportRowError> errors = report.errors;
+    std::stable_sort(errors.begin(), errors.end(),
+                     [](const ImportRowError& a, const ImportRowError& b) { return a.line < b.line; });
+    json rows = json::array();
+    for (const auto& error : errors) {
+        rows.push_back({{"line", error.line}, {"error", error.error}});
+    }
+    
+    json result;
+    result["success"] = report.error_count == 0;
+    result["rows"] = report.rows;
+    result["credited"] = report.credited;
+    result["total_amount"] = money_to_double(report.total);
+    result["error_count"] = report.error_count;
+    result["errors"] = rows;
+    result["errors_truncated"] = report.error_count > errors.size();
+    return result;
+}
+
+// 🔗 PROVABLY-FAIR SERIALIZATION
+
+json GameStateSerializer::serializeFairness(const HashChain& chain, int64_t round_chain_index) {
+    json result;
+    result["terminal_hash"] = HashChain::to_hex(chain.terminal_hash());
+    result["salt"] = chain.salt();
+    result["length"] = chain.length();
+    result["next_index"] = chain.next_index();
+    result["revealed"] = chain.revealed_count();
+    // Uçan round'un linki crash olana kadar gizli; sadece sırası bilinir
+    result["round_index"] = round_chain_index >= 0 ? json(round_chain_index) : json(nullptr);
+    uint64_t revealed = chain.revealed_count();
+    result["last"] = revealed > 0 ? serializeChainLink(chain, revealed - 1) : json(nullptr);
+    return result;
+}
+
+json GameStateSerializer::serializeChainLink(const HashChain& chain, uint64_t index) {
+    HashChain::Hash link;
+    uint32_t stored_x100 = 0;
+    if (!chain.revealed_link(index, link, stored_x100)) return json(nullptr);
+    
+    // sha256(hash) bir önceki round'un hash'i (ilk link için terminal_hash) olmalı
+    HashChain::Hash expected = chain.terminal_hash();
+    uint32_t previous_x100 = 0;
+    if (index > 0) chain.revealed_link(index - 1, expected, previous_x100);
+    HashChain::Hash next = HashChain::sha256(link.data(), link.size());
+    // Önceden hesaplanan değere değil, link ve tuzdan yeniden hesaplanana güvenilir
+    uint32_t crash_point_x100 = HashChain::crash_point_x100(link, chain.salt());
+    
+    json result;
+    result["index"] = index;
+    uint32_t round = chain.link_round(index);
+    result["round"] = round > 0 ? json(round) : json(nullptr);
+    result["hash"] = HashChain::to_hex(link);
+    result["previous_hash"] = HashChain::to_hex(next);
+    result["chained"] = next == expected && crash_point_x100 == stored_x100;
+    result["crash_point"] = crash_point_x100 / 100.0;
+    return result;
+}
@@ -0,0 +1,164 @@
+#include "leaderboard.h"
+
+TopK::TopK(size_t k) : capacity(k) {
+}
+
+void TopK::offer(const std::string& player_id, const std::string& name, Money value) {
+    if (capacity == 0) return;
+    
+    auto it = members.find(player_id);
+    if (it != members.end()) {
+        // Zaten listede: eski değeri çıkar, yenisini ekle
+        ordered.erase({it->second.value, player_id});
+        it->second.value = value;
+        it->second.name = name;
+        ordered.insert({value, player_id});
+        return;
+    }
+    
+    if (members.size() >= capacity) {
+        auto lowest = ordered.begin();
+        if (value <= lowest->first) return;
+        members.erase(lowest->second);
+        ordered.erase(lowest);
+    }
+    
+    members.emplace(player_id, LeaderboardEntry{player_id, name, value});
+    ordered.insert({value, player_id});
+}
+
+std::vector<LeaderboardEntry> TopK::top() const {
+    std::vector<LeaderboardEntry> result;
+    result.reserve(ordered.size());
+    for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
+        result.push_back(members.at(it->second));
+    }
+    return result;
+}
+
+void TopK::clear() {
+    ordered.clear();
+    members.clear();
+}
+
+size_t TopK::size() const {
+    return members.size();
+}
+
+Leaderboards::Leaderboards(size_t k)
+    : round_board(k), daily_board(k), all_time_board(k), current_day(-1), settled_round(0), version(0),
+      settling(false) {
+}
+
+void Leaderboards::begin_settlement(int round, int64_t day) {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    round_board.clear();
+    round_totals.clear();
+    settled_round = round;
+    settling = true;
+    
+    if (day != current_day) {
+        daily_board.clear();
+        daily_totals.clear();
+        current_day = day;
+    }
+}
+
+void Leaderboards::record_win(const std::string& player_id, const std::string& name, Money winnings, Money all_time_total) {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    
+    // Aynı oyuncunun birden fazla bahsi olabilir; round içinde de toplanır
+    Money& round_total = round_totals[player_id];
+    round_total += winnings;
+    round_board.offer(player_id, name, round_total);
+    
+    Money& daily_total = daily_totals[player_id];
+    daily_total += winnings;
+    daily_board.offer(player_id, name, daily_total);
+    
+    all_time_board.offer(player_id, name, all_time_total);
+}
+
+void Leaderboards::end_settlement() {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    version++;
+    settling = false;
+}
+
+LeaderboardState Leaderboards::save_state() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    LeaderboardState state;
+    state.day = current_day;
+    state.settled_round = settled_round;
+    state.version = version;
+    auto collect = [](const std::unordered_map<std::string, Money>& totals, const TopK& board,
+                      std::vector<LeaderboardEntry>& out) {
+        std::unordered_map<std::string, std::string> names;
+        for (auto& entry : board.top()) names.emplace(entry.player_id, entry.name);
+        out.reserve(totals.size());
+        for (const auto& [player_id, total] : totals) {
+            auto name = names.find(player_id);
+            out.push_back(LeaderboardEntry{player_id, name != names.end() ? name->second : std::string(), total});
+        }
+    };
+    collect(round_totals, round_board, state.round_totals);
+    collect(daily_totals, daily_board, state.daily_totals);
+    return state;
+}
+
+void Leaderboards::restore_state(const LeaderboardState& state) {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    current_day = state.day;
+    settled_round = state.settled_round;
+    version = state.version;
+    for (const auto& entry : state.round_totals) {
+        round_totals[entry.player_id] = entry.value;
+        round_board.offer(entry.player_id, entry.name, entry.value);
+    }
+    for (const auto& entry : state.daily_totals) {
+        daily_totals[entry.player_id] = entry.value;
+        daily_board.offer(entry.player_id, entry.name, entry.value);
+    }
+}
+
+void Leaderboards::restore_all_time(const std::string& player_id, const std::string& name, Money all_time_total) {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    all_time_board.offer(player_id, name, all_time_total);
+}
+
+int Leaderboards::get_settled_round() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    return settled_round;
+}
+
+uint64_t Leaderboards::get_version() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    return version;
+}
+
+std::vector<LeaderboardEntry> Leaderboards::get_round_top() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    return round_board.top();
+}
+
+std::vector<LeaderboardEntry> Leaderboards::get_daily_top() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    return daily_board.top();
+}
+
+std::vector<LeaderboardEntry> Leaderboards::get_all_time_top() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    return all_time_board.top();
+}
+
+LeaderboardSnapshot Leaderboards::snapshot() const {
+    std::lock_guard<std::mutex> lock(boards_mutex);
+    LeaderboardSnapshot result;
+    result.version = version;
+    result.settling = settling;
+    result.settled_round = settled_round;
+    result.round_top = round_board.top();
+    result.daily_top = daily_board.top();
+    result.all_time_top = all_time_board.top();
+    return result;
+}
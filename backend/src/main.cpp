@@ -1,35 +1,66 @@
 #include "server.h"
+#include "replica_server.h"
+#include "trace.h"
 #include <iostream>
 #include <signal.h>
 #include <memory>
+#include <stdexcept>
 #include <pistache/endpoint.h>
 
 using namespace Pistache;
 
 std::unique_ptr<CrashGameServer> server_instance = nullptr;
+std::unique_ptr<ReplicaServer> replica_instance = nullptr;
 
 void signal_handler(int) {
     std::cout << "\nSunucu kapatılıyor..." << std::endl;
     if (server_instance) {
         server_instance->stop();
     }
+    if (replica_instance) {
+        replica_instance->stop();
+    }
     exit(0);
 }
 
+// kill -USR1 <pid>: oyun döngüsü iz dökümünü CRASH_TRACE_PATH'e yazar
+void trace_signal_handler(int) {
+    trace::request_dump();
+}
+
 int main() {
     std::cout << "=== 🚁 Crash Game REST API Server ===" << std::endl;
     
     // Signal handler kurulumu
     signal(SIGINT, signal_handler);
+    signal(SIGUSR1, trace_signal_handler);
     
     try {
-        // Server'ı localhost:5050'de başlat
-        Address address(Ipv4::any(), Port(5050));
-        server_instance = std::make_unique<CrashGameServer>(address);
+        // Server'ı localhost:5050'de başlat (CRASH_PORT ile değiştirilebilir)
+        ServerConfig config = ServerConfig::fromEnv();
+        
+        // Okuma replica'sı: oyun çalıştırmaz, primary'nin paylaşılan belleğinden okur
+        if (config.role == "replica") {
+            if (config.shm_name.empty()) {
+                throw std::runtime_error("Replica için CRASH_SHM_NAME gerekli");
+            }
+            Address readAddress(Ipv4::any(), Port(config.read_port));
+            replica_instance = std::make_unique<ReplicaServer>(readAddress, config);
+            std::cout << "🔗 Replica API: http://localhost:" << config.read_port
+                      << " (status, old-crash-points)" << std::endl;
+            replica_instance->start();
+            return 0;
+        }
+        
+        // Aynı devir soketini dinleyen bir süreç varsa oyun durumu ondan devralınır (deploy)
+        int predecessor_fd = config.handoff_socket.empty() ? -1 : handoff::connect(config.handoff_socket);
+        
+        Address address(Ipv4::any(), Port(config.port));
+        server_instance = std::make_unique<CrashGameServer>(address, config);
         
         std::cout << "✅ Server hazır!" << std::endl;
         std::cout << "🌐 Frontend: http://localhost:3000" << std::endl;
-        std::cout << "🔗 API: http://localhost:5050" << std::endl;
+        std::cout << "🔗 API: http://localhost:" << config.port << std::endl;
         std::cout << "\n📋 Endpoints:" << std::endl;
         std::cout << "  GET  /api/game/status      - Oyun durumu" << std::endl;
         std::cout << "  POST /api/game/join        - Oyuna katıl" << std::endl;
@@ -37,7 +68,7 @@ int main() {
         std::cout << "  POST /api/game/cashout     - Para çek" << std::endl;
         std::cout << "\n🛑 Durdurmak için Ctrl+C'ye basın\n" << std::endl;
         
-        server_instance->start();
+        server_instance->start(predecessor_fd);
         
     } catch (const std::exception& e) {
         std::cerr << "❌ Server hatası: " << e.what() << std::endl;
@@ -1,7 +1,7 @@
 #include "player.h"
 
-Player::Player(const std::string& id, const std::string& player_name, double initial_balance) 
-    : player_id(id), name(player_name), balance(initial_balance) {
+Player::Player(const std::string& id, const std::string& player_name, Money initial_balance, Money initial_winnings)
+    : player_id(id), name(player_name), balance(initial_balance), total_winnings(initial_winnings), last_activity_ms(0) {
 }
 
 std::string Player::get_id() const {
@@ -12,19 +12,38 @@ std::string Player::get_name() const {
     return name;
 }
 
-double Player::get_balance() const {
-    return balance;
+Money Player::get_balance() const {
+    return balance.load();
 }
 
-bool Player::deduct_balance(double amount) {
+Money Player::get_total_winnings() const {
+    return total_winnings.load();
+}
+
+int64_t Player::get_last_activity_ms() const {
+    return last_activity_ms.load(std::memory_order_relaxed);
+}
+
+bool Player::deduct_balance(Money amount) {
     if (amount < 0) return false;  // Negatif miktarları kabul etme
-    if (balance >= amount) {
-        balance -= amount;
-        return true;
-    }
-    return false;
+    
+    // Oku-kontrol et-yaz tek atomik adım: başka thread araya girerse tekrar dene
+    Money current = balance.load();
+    do {
+        if (current < amount) return false;
+    } while (!balance.compare_exchange_weak(current, current - amount));
+    return true;
 }
 
-void Player::add_balance(double amount) {
-    balance += amount;
-}
\ No newline at end of file
+void Player::add_balance(Money amount) {
+    balance.fetch_add(amount);
+}
+
+void Player::add_winnings(Money amount) {
+    balance.fetch_add(amount);
+    total_winnings.fetch_add(amount);
+}
+
+void Player::touch(int64_t now_ms) {
+    last_activity_ms.store(now_ms, std::memory_order_relaxed);
+}
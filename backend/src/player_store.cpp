@@ -0,0 +1,294 @@
+#include "player_store.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+uint64_t key_of(std::string_view value) {
+    return std::hash<std::string_view>{}(value);
+}
+
+void pwrite_all(int fd, const char* data, size_t size, uint64_t offset, const std::string& path) {
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            throw std::runtime_error("Uyuyan oyuncu dosyası yazılamadı: " + path + ": " + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+std::string encode(const DormantPlayer& player) {
+    DormantRecordHeader header{};
+    header.balance = player.balance;
+    header.total_winnings = player.total_winnings;
+    header.id_size = static_cast<uint16_t>(std::min<size_t>(player.player_id.size(), UINT16_MAX));
+    header.name_size = static_cast<uint16_t>(std::min<size_t>(player.name.size(), UINT16_MAX));
+    header.live = 1;
+
+    std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes.append(player.player_id.data(), header.id_size);
+    bytes.append(player.name.data(), header.name_size);
+    return bytes;
+}
+
+}
+
+PlayerStore::PlayerStore(const std::string& file_path, bool resume)
+    : path(file_path), fd(-1), end_offset(0), live_bytes(0), dead_bytes(0) {
+    if (path.empty()) return;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (resume ? 0 : O_TRUNC), 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Uyuyan oyuncu dosyası açılamadı: " + path);
+    }
+    load();
+}
+
+PlayerStore::~PlayerStore() {
+    if (fd >= 0) ::close(fd);
+}
+
+void PlayerStore::load() {
+    off_t file_size = ::lseek(fd, 0, SEEK_END);
+    uint64_t size = file_size > 0 ? static_cast<uint64_t>(file_size) : 0;
+
+    DormantRecordHeader header;
+    DormantPlayer player;
+    uint64_t offset = 0;
+    while (offset + sizeof(DormantRecordHeader) <= size) {
+        if (!read_record(offset, header, player)) break;
+        uint64_t record_size = sizeof(header) + header.id_size + header.name_size;
+        if (offset + record_size > size) break;
+        if (header.live) {
+            index_record(player, offset, record_size);
+        } else {
+            dead_bytes += record_size;
+        }
+        offset += record_size;
+    }
+    end_offset = offset;
+
+    // Yarım kalan son kayıt atılır ki sonraki eklemeler onu okumasın
+    if (end_offset < size && ::ftruncate(fd, static_cast<off_t>(end_offset)) != 0) {
+        throw std::runtime_error("Uyuyan oyuncu dosyası düzeltilemedi: " + path);
+    }
+}
+
+void PlayerStore::index_record(const DormantPlayer& player, uint64_t offset, uint64_t size) {
+    by_id.emplace(key_of(player.player_id), offset);
+    by_name.emplace(key_of(player.name), offset);
+    live_bytes += size;
+}
+
+bool PlayerStore::read_record(uint64_t offset, DormantRecordHeader& header, DormantPlayer& out) const {
+    if (fd < 0) {
+        if (offset + sizeof(header) > memory.size()) return false;
+        std::memcpy(&header, memory.data() + offset, sizeof(header));
+        if (offset + sizeof(header) + header.id_size + header.name_size > memory.size()) return false;
+        const char* strings = memory.data() + offset + sizeof(header);
+        out.player_id.assign(strings, header.id_size);
+        out.name.assign(strings + header.id_size, header.name_size);
+    } else {
+        if (::pread(fd, &header, sizeof(header), static_cast<off_t>(offset)) != static_cast<ssize_t>(sizeof(header))) {
+            return false;
+        }
+        std::string strings(header.id_size + header.name_size, '\0');
+        if (!strings.empty() &&
+            ::pread(fd, strings.data(), strings.size(), static_cast<off_t>(offset + sizeof(header))) !=
+                static_cast<ssize_t>(strings.size())) {
+            return false;
+        }
+        out.player_id.assign(strings.data(), header.id_size);
+        out.name.assign(strings.data() + header.id_size, header.name_size);
+    }
+    out.balance = header.balance;
+    out.total_winnings = header.total_winnings;
+    return true;
+}
+
+bool PlayerStore::find_locked(std::string_view player_id, uint64_t& offset, DormantPlayer& out) const {
+    DormantRecordHeader header;
+    auto range = by_id.equal_range(key_of(player_id));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (read_record(it->second, header, out) && header.live && out.player_id == player_id) {
+            offset = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PlayerStore::write_at(uint64_t offset, const char* data, size_t size) {
+    if (fd < 0) {
+        if (offset + size > memory.size()) memory.resize(offset + size);
+        std::memcpy(memory.data() + offset, data, size);
+        return;
+    }
+    pwrite_all(fd, data, size, offset, path);
+}
+
+void PlayerStore::put(const DormantPlayer& player) {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    uint64_t offset = 0;
+    DormantPlayer previous;
+    if (find_locked(player.player_id, offset, previous)) {
+        // Aynı oyuncu iki kez sayfalanmaz; olursa eski kayıt ölür
+        kill_locked(offset, previous);
+    }
+
+    std::string bytes = encode(player);
+    write_at(end_offset, bytes.data(), bytes.size());
+    index_record(player, end_offset, bytes.size());
+    end_offset += bytes.size();
+}
+
+bool PlayerStore::take(std::string_view player_id, DormantPlayer& out) {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    uint64_t offset = 0;
+    if (!find_locked(player_id, offset, out)) return false;
+
+    kill_locked(offset, out);
+    if (dead_bytes >= COMPACT_MIN_DEAD_BYTES && dead_bytes > live_bytes) {
+        compact_locked();
+    }
+    return true;
+}
+
+void PlayerStore::kill_locked(uint64_t offset, const DormantPlayer& player) {
+    uint8_t dead = 0;
+    write_at(offset + offsetof(DormantRecordHeader, live), reinterpret_cast<const char*>(&dead), 1);
+
+    auto erase_offset = [offset](std::unordered_multimap<uint64_t, uint64_t>& index, uint64_t key) {
+        auto range = index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == offset) {
+                index.erase(it);
+                return;
+            }
+        }
+    };
+    erase_offset(by_id, key_of(player.player_id));
+    erase_offset(by_name, key_of(player.name));
+
+    uint64_t size = sizeof(DormantRecordHeader) + player.player_id.size() + player.name.size();
+    live_bytes -= size;
+    dead_bytes += size;
+}
+
+bool PlayerStore::credit(std::string_view player_id, Money amount) {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    uint64_t offset = 0;
+    DormantPlayer player;
+    if (!find_locked(player_id, offset, player)) return false;
+    Money balance = player.balance + amount;
+    write_at(offset + offsetof(DormantRecordHeader, balance), reinterpret_cast<const char*>(&balance), sizeof(balance));
+    return true;
+}
+
+bool PlayerStore::contains(std::string_view player_id) const {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    uint64_t offset = 0;
+    DormantPlayer player;
+    return find_locked(player_id, offset, player);
+}
+
+bool PlayerStore::find_id_by_name(std::string_view name, std::string& player_id) const {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    DormantRecordHeader header;
+    DormantPlayer player;
+    auto range = by_name.equal_range(key_of(name));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (read_record(it->second, header, player) && header.live && player.name == name) {
+            player_id = player.player_id;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PlayerStore::size() const {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    return by_id.size();
+}
+
+uint64_t PlayerStore::file_bytes() const {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    return end_offset;
+}
+
+void PlayerStore::compact_locked() {
+    // Canlı kayıtlar dosya sırasıyla yeni dosyaya kopyalanır, rename ile yer değiştirir
+    std::vector<uint64_t> offsets;
+    offsets.reserve(by_id.size());
+    for (const auto& entry : by_id) offsets.push_back(entry.second);
+    std::sort(offsets.begin(), offsets.end());
+
+    std::string compact_path = path + ".compact";
+    int compact_fd = -1;
+    if (fd >= 0) {
+        compact_fd = ::open(compact_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (compact_fd < 0) return;  // Sıkıştırma ertelenir, kayıtlar geçerli kalır
+    }
+
+    struct Moved {
+        uint64_t id_key;
+        uint64_t name_key;
+        uint64_t offset;
+    };
+    std::string buffer;
+    std::vector<Moved> moved;
+    moved.reserve(offsets.size());
+    uint64_t written = 0;
+    DormantRecordHeader header;
+    DormantPlayer player;
+    try {
+        for (uint64_t offset : offsets) {
+            if (!read_record(offset, header, player)) continue;
+            moved.push_back(Moved{key_of(player.player_id), key_of(player.name), written + buffer.size()});
+            buffer += encode(player);
+            if (compact_fd >= 0 && buffer.size() >= 64 * 1024) {
+                pwrite_all(compact_fd, buffer.data(), buffer.size(), written, compact_path);
+                written += buffer.size();
+                buffer.clear();
+            }
+        }
+        if (compact_fd >= 0) {
+            pwrite_all(compact_fd, buffer.data(), buffer.size(), written, compact_path);
+            if (::rename(compact_path.c_str(), path.c_str()) != 0) {
+                throw std::runtime_error("Uyuyan oyuncu dosyası değiştirilemedi: " + path);
+            }
+        }
+    } catch (const std::exception&) {
+        if (compact_fd >= 0) {
+            ::close(compact_fd);
+            ::unlink(compact_path.c_str());
+        }
+        return;
+    }
+    written += buffer.size();
+
+    if (compact_fd >= 0) {
+        ::close(fd);
+        fd = compact_fd;
+    } else {
+        memory.swap(buffer);
+    }
+    by_id.clear();
+    by_name.clear();
+    for (const Moved& record : moved) {
+        by_id.emplace(record.id_key, record.offset);
+        by_name.emplace(record.name_key, record.offset);
+    }
+    live_bytes = written;
+    dead_bytes = 0;
+    end_offset = written;
+}
@@ -0,0 +1,59 @@
+#include "rate_limiter.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+RateLimiter::RateLimiter(const RateLimitConfig& config) : epoch(std::chrono::steady_clock::now()) {
+    size_t slots = 1;
+    while (slots < config.slots) slots <<= 1;
+    slot_mask = slots - 1;
+    buckets.reset(new std::atomic<uint64_t>[slots]);
+    for (size_t i = 0; i < slots; ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    
+    enabled = config.rate_per_sec > 0.0 && config.burst >= 1.0;
+    rate_milli_per_ms = config.rate_per_sec;  // (rate * 1000 milli-token) / 1000 ms
+    capacity_milli = std::min<uint64_t>(static_cast<uint64_t>(config.burst * MILLI), TOKEN_MASK);
+    retry_after = enabled ? std::max(1, static_cast<int>(std::ceil(1.0 / config.rate_per_sec))) : 0;
+}
+
+bool RateLimiter::try_acquire(const std::string& key) {
+    auto now = std::chrono::steady_clock::now();
+    return try_acquire(key, std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch).count());
+}
+
+bool RateLimiter::try_acquire(const std::string& key, uint64_t now_ms) {
+    if (!enabled) return true;
+    
+    std::atomic<uint64_t>& slot = buckets[std::hash<std::string>{}(key) & slot_mask];
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    
+    while (true) {
+        uint64_t last_ms = current >> TOKEN_BITS;
+        uint64_t spent = current & TOKEN_MASK;
+        
+        // Geçen süre kadar harcanan token'ı geri öde
+        if (now_ms > last_ms) {
+            uint64_t refill = static_cast<uint64_t>((now_ms - last_ms) * rate_milli_per_ms);
+            spent = refill >= spent ? 0 : spent - refill;
+        }
+        
+        if (spent + MILLI > capacity_milli) {
+            return false;
+        }
+        
+        uint64_t next = (std::max(now_ms, last_ms) << TOKEN_BITS) | (spent + MILLI);
+        if (slot.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+bool RateLimiter::is_enabled() const {
+    return enabled;
+}
+
+int RateLimiter::get_retry_after_seconds() const {
+    return retry_after;
+}
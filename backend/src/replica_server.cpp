@@ -0,0 +1,162 @@
+#include "replica_server.h"
+#include "http_helpers.h"
+#include "json_utils.h"
+#include "game.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+ReplicaServer::ReplicaServer(Address address, const ServerConfig& server_config)
+    : config(server_config), reader(server_config.shm_name), running(false),
+      long_poll(static_cast<size_t>(std::max(0, server_config.longpoll_max_waiters)),
+                server_config.longpoll_timeout_ms) {
+    httpEndpoint = std::make_shared<Http::Endpoint>(address);
+    
+    auto opts = Http::Endpoint::options()
+        .threads(config.http_threads)
+        .flags(Tcp::Options::ReuseAddr | Tcp::Options::ReusePort);
+    
+    httpEndpoint->init(opts);
+    setupRoutes();
+}
+
+ReplicaServer::~ReplicaServer() {
+    stop();
+}
+
+void ReplicaServer::setupRoutes() {
+    using namespace Rest;
+    
+    Routes::Get(router, "/api/game/status", 
+        Routes::bind(&ReplicaServer::getGameStatus, this));
+    Routes::Options(router, "/api/game/status", 
+        Routes::bind(&ReplicaServer::handleOptions, this));
+    
+    Routes::Get(router, "/api/game/old-crash-points", 
+        Routes::bind(&ReplicaServer::getOldCrashPoints, this));
+    Routes::Options(router, "/api/game/old-crash-points", 
+        Routes::bind(&ReplicaServer::handleOptions, this));
+    
+    httpEndpoint->setHandler(router.handler());
+}
+
+void ReplicaServer::start() {
+    running = true;
+    if (config.tick_stream_port > 0) {
+        tick_stream.start(static_cast<uint16_t>(config.tick_stream_port));
+    }
+    // Tick yayını kapalı olsa da long-poll bekleyenleri bu thread uyandırır
+    stream_thread = std::thread(&ReplicaServer::stream_loop, this);
+    
+    std::cout << "🪞 Okuma replica'sı başlatıldı (shm: " << config.shm_name << ")" << std::endl;
+    httpEndpoint->serve();
+}
+
+void ReplicaServer::stop() {
+    running = false;
+    if (stream_thread.joinable()) {
+        stream_thread.join();
+    }
+    if (httpEndpoint) {
+        httpEndpoint->shutdown();
+    }
+    tick_stream.stop();
+}
+
+void ReplicaServer::stream_loop() {
+    uint64_t last_published = 0;
+    while (running) {
+        GameSnapshot snapshot;
+        // Sadece primary yeni bir snapshot yayınladıysa ilet
+        if (readSnapshot(snapshot) && static_cast<uint64_t>(snapshot.published_at_ms) != last_published) {
+            last_published = static_cast<uint64_t>(snapshot.published_at_ms);
+            int64_t now = CrashGame::now_ms();
+            if (config.tick_stream_port > 0) {
+                uint8_t frame[tick_protocol::TICK_SIZE];
+                tick_protocol::encode_tick(GameStateSerializer::serializeTick(snapshot, now), frame);
+                tick_stream.publish(frame, sizeof(frame));
+            }
+            wakeLongPolls(snapshot, now);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void ReplicaServer::wakeLongPolls(const GameSnapshot& snapshot, int64_t now) {
+    std::vector<Http::ResponseWriter> waiters = long_poll.advance(snapshot.status_version);
+    std::vector<Http::ResponseWriter> expired = long_poll.expire(now);
+    if (waiters.empty() && expired.empty()) return;
+    
+    for (auto& response : expired) waiters.push_back(std::move(response));
+    HttpHelpers::sendStatusToWaiters(waiters, GameStateSerializer::serializeSnapshot(snapshot, now).dump());
+}
+
+bool ReplicaServer::readSnapshot(GameSnapshot& snapshot) {
+    if (!reader.read(snapshot)) return false;
+    if (CrashGame::now_ms() - snapshot.published_at_ms <= STALE_AFTER_MS) return true;
+    
+    // Primary yeniden başladıysa segment baştan oluşturulmuş olabilir
+    return reader.reattach() && reader.read(snapshot) &&
+           CrashGame::now_ms() - snapshot.published_at_ms <= STALE_AFTER_MS;
+}
+
+void ReplicaServer::sendUnavailable(Http::ResponseWriter& response) {
+    static const std::string unavailable = JsonUtils::createErrorResponse(
+        "Oyun durumu alınamadı", "Primary sunucu yayın yapmıyor").dump();
+    response.headers()
+        .addRaw(Http::Header::Raw("Retry-After", "1"))
+        .add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Service_Unavailable, unavailable);
+}
+
+void ReplicaServer::getGameStatus(const Rest::Request& request, Http::ResponseWriter response) {
+    GameSnapshot snapshot;
+    if (!readSnapshot(snapshot)) {
+        HttpHelpers::enableCors(response);
+        sendUnavailable(response);
+        return;
+    }
+    
+    // Primary'deki gibi: versiyon değişmediyse stream thread'i cevaplar
+    uint64_t since = 0;
+    if (!HttpHelpers::acceptsBinaryTick(request) && HttpHelpers::getSinceVersion(request, since) &&
+        long_poll.park(since, response, CrashGame::now_ms())) {
+        return;
+    }
+    
+    HttpHelpers::enableCors(response);
+    
+    int64_t now = CrashGame::now_ms();
+    response.headers().addRaw(Http::Header::Raw("Vary", "Accept"));
+    if (HttpHelpers::acceptsBinaryTick(request)) {
+        uint8_t frame[tick_protocol::TICK_SIZE];
+        tick_protocol::encode_tick(GameStateSerializer::serializeTick(snapshot, now), frame);
+        response.send(Http::Code::Ok, reinterpret_cast<const char*>(frame), sizeof(frame), HttpHelpers::binaryTickMime());
+        return;
+    }
+    
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Ok, GameStateSerializer::serializeSnapshot(snapshot, now).dump());
+}
+
+void ReplicaServer::getOldCrashPoints(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    GameSnapshot snapshot;
+    if (!readSnapshot(snapshot)) {
+        sendUnavailable(response);
+        return;
+    }
+    
+    auto cached = response_cache.get("old-crash-points", snapshot.history_version);
+    if (!cached) {
+        cached = response_cache.put("old-crash-points", snapshot.history_version,
+                                    GameStateSerializer::serializeCrashPoints(snapshot).dump());
+    }
+    HttpHelpers::sendCached(request, response, cached);
+}
+
+void ReplicaServer::handleOptions(const Rest::Request&, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.send(Http::Code::Ok, "");
+}
@@ -0,0 +1,79 @@
+#include "response_cache.h"
+#include <chrono>
+
+ContentCoding CachedResponse::effective_coding(ContentCoding requested) const {
+    return body.size() < Compression::MIN_COMPRESS_SIZE ? ContentCoding::IDENTITY : requested;
+}
+
+const std::string& CachedResponse::encoded_body(ContentCoding coding) const {
+    switch (coding) {
+        case ContentCoding::GZIP:
+            std::call_once(gzip_once, [this] { gzip_body = Compression::compress(body, ContentCoding::GZIP); });
+            return gzip_body;
+        case ContentCoding::DEFLATE:
+            std::call_once(deflate_once, [this] { deflate_body = Compression::compress(body, ContentCoding::DEFLATE); });
+            return deflate_body;
+        default:
+            return body;
+    }
+}
+
+std::string CachedResponse::encoded_etag(ContentCoding coding) const {
+    if (coding == ContentCoding::IDENTITY) return etag;
+    // Her temsil kendi ETag'ini taşır: "key-...-7" -> "key-...-7-gzip"
+    return etag.substr(0, etag.size() - 1) + "-" + Compression::coding_name(coding) + "\"";
+}
+
+ResponseCache::ResponseCache() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    instance_tag = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+std::shared_ptr<const CachedResponse> ResponseCache::get(const std::string& key, uint64_t version) const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second->version == version) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const CachedResponse> ResponseCache::put(const std::string& key, uint64_t version, std::string body) {
+    auto entry = std::make_shared<CachedResponse>();
+    entry->version = version;
+    entry->etag = make_etag(key, version);
+    entry->body = std::move(body);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = entries.find(key);
+    // Daha yeni bir versiyonu eskisiyle ezme
+    if (it == entries.end() || it->second->version <= version) {
+        entries[key] = entry;
+    }
+    return entry;
+}
+
+std::string ResponseCache::make_etag(const std::string& key, uint64_t version) const {
+    return "\"" + key + "-" + instance_tag + "-" + std::to_string(version) + "\"";
+}
+
+bool ResponseCache::etag_matches(const std::string& if_none_match, const std::string& etag) {
+    size_t pos = 0;
+    while (pos < if_none_match.size()) {
+        size_t end = if_none_match.find(',', pos);
+        if (end == std::string::npos) end = if_none_match.size();
+
+        std::string candidate = if_none_match.substr(pos, end - pos);
+        size_t first = candidate.find_first_not_of(" \t");
+        size_t last = candidate.find_last_not_of(" \t");
+        if (first != std::string::npos) {
+            candidate = candidate.substr(first, last - first + 1);
+            if (candidate == "*") return true;
+            // Zayıf karşılaştırma: W/ öneki yok sayılır
+            if (candidate.compare(0, 2, "W/") == 0) candidate = candidate.substr(2);
+            if (candidate == etag) return true;
+        }
+        pos = end + 1;
+    }
+    return false;
+}
@@ -2,131 +2,847 @@
 #include "json_utils.h"
 #include <iostream>
 #include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
 #include <thread>
+#include <algorithm>
+#include <fstream>
 #include <nlohmann/json.hpp>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 using json = nlohmann::json;
 
-CrashGameServer::CrashGameServer(Address address) : running(false) {
-    httpEndpoint = std::make_shared<Http::Endpoint>(address);
+namespace {
+
+// Settlement dışa aktarımında HTTP chunk başına hedef boyut
+constexpr size_t EXPORT_CHUNK_BYTES = 256 * 1024;
+
+// Süreç devri: ardıl HELLO'yu hemen yollar; durum için uçan round'un bitmesi beklenir
+// (10x crash ~17 sn), ACK için ardılın geçmiş dosyasını yüklemesi
+constexpr int HANDOFF_HELLO_TIMEOUT_MS = 5000;
+constexpr int HANDOFF_STATE_TIMEOUT_MS = 60000;
+constexpr int HANDOFF_ACK_TIMEOUT_MS = 30000;
+// Drain: işlenen istek kalmayınca bu kadar beklenir (gönderilen cevaplar yazılsın), sonra boştaki
+// keep-alive bağlantılar kapatılır
+constexpr int HANDOFF_IDLE_MS = 50;
+
+// Kuyruğa giren istek işlenince (handler exception atsa da) sayaçtan düşer
+struct InFlightGuard {
+    std::atomic<int>& count;
+    ~InFlightGuard() { count--; }
+};
+
+// Aynı Idempotency-Key başka bir komut veya miktarla gelirse tekrar sayılmaz
+uint64_t commandFingerprint(bool is_bet, Money amount) {
+    return is_bet ? (static_cast<uint64_t>(amount) << 1) | 1 : 0;
+}
+
+}  // namespace
+
+CrashGameServer::CrashGameServer(Address address, const ServerConfig& server_config)
+    : listen_address(address),
+      running(false),
+      config(server_config),
+      player_limiter(server_config.player_rate_limit),
+      ip_limiter(server_config.ip_rate_limit),
+      dispatcher(server_config.dispatcher),
+      export_dispatcher(DispatcherConfig{1, 0, static_cast<size_t>(std::max(1, server_config.export_queue)), SIZE_MAX}),
+      import_dispatcher(DispatcherConfig{1, static_cast<size_t>(std::max(1, server_config.import_queue)), 0, SIZE_MAX}),
+      import_uploads([this](const std::vector<BalanceCredit>& batch, BalanceImportReport& report) {
+          game.load_balances(batch, report);
+      }),
+      tick_policy(server_config.tick_policy),
+      long_poll(static_cast<size_t>(std::max(0, server_config.longpoll_max_waiters)),
+                server_config.longpoll_timeout_ms),
+      spectator_poll(static_cast<size_t>(std::max(0, server_config.longpoll_max_waiters)),
+                     server_config.longpoll_timeout_ms),
+      idempotency_cache(server_config.idempotency) {
+    trace::configure(config.trace_events);
     
-    // HTTP ayarları
-    auto opts = Http::Endpoint::options()
-        .threads(2)  // 2 thread kullan
-        .flags(Tcp::Options::ReuseAddr);
+    createEndpoint();
+    
+    if (config.synthetic.players > 0) {
+        // Bahisler WAITING tick'lerine yayıldığından sentetik oyuncular o fazın aralığını bilmeli
+        config.synthetic.tick_ms = tick_policy.get_config().waiting_tick_ms;
+        synthetic_players = std::make_unique<SyntheticPlayers>(config.synthetic);
+        synthetic_players->attach(game);
+    }
+    
+    game.set_session_ttl_ms(static_cast<int64_t>(config.session_ttl_sec) * 1000);
+    
+    if (!config.static_dir.empty()) {
+        static_assets.load(config.static_dir);
+        std::cout << "🗂️ Statik dosyalar bellekte: " << config.static_dir << " (" << static_assets.size()
+                  << " dosya, " << static_assets.total_bytes() / 1024 << " KB)" << std::endl;
+    }
     
-    httpEndpoint->init(opts);
     setupRoutes();
+    setupWebSocket();
 }
 
 CrashGameServer::~CrashGameServer() {
     stop();
 }
 
+void CrashGameServer::createEndpoint() {
+    httpEndpoint = std::make_shared<Http::Endpoint>(listen_address);
+    
+    // HTTP ayarları; devir açıksa eski ve yeni süreç portu kısa süre birlikte dinler
+    Flags<Tcp::Options> flags = Tcp::Options::ReuseAddr;
+    if (!config.handoff_socket.empty()) {
+        flags = Tcp::Options::ReuseAddr | Tcp::Options::ReusePort;
+    }
+    auto opts = Http::Endpoint::options()
+        .threads(config.http_threads)
+        .flags(flags)
+        .maxRequestSize(static_cast<size_t>(config.max_request_bytes));
+    
+    httpEndpoint->init(opts);
+}
+
 void CrashGameServer::setupRoutes() {
     using namespace Rest;
     
     // CORS için OPTIONS handler
     Routes::Options(router, "*", [this](const Request&, Http::ResponseWriter res) {
-        enableCors(res);
+        HttpHelpers::enableCors(res);
         res.send(Http::Code::Ok);
         return Route::Result::Ok;
     });
     
     // Game status endpoint
     Routes::Get(router, "/api/game/status", 
-        Routes::bind(&CrashGameServer::getGameStatus, this));
+        queued("http.getGameStatus", WorkPriority::READ, &CrashGameServer::getGameStatus));
     
     // Join game endpoint
     Routes::Post(router, "/api/game/join", 
-        Routes::bind(&CrashGameServer::joinGame, this));
+        queued("http.joinGame", WorkPriority::COMMAND, &CrashGameServer::joinGame));
     Routes::Options(router, "/api/game/join", 
         Routes::bind(&CrashGameServer::handleOptions, this));
     
     // Place bet endpoint
     Routes::Post(router, "/api/game/bet", 
-        Routes::bind(&CrashGameServer::placeBet, this));
+        queued("http.placeBet", WorkPriority::COMMAND, &CrashGameServer::placeBet, true));
     Routes::Options(router, "/api/game/bet", 
         Routes::bind(&CrashGameServer::handleOptions, this));
     
     // Cashout endpoint
     Routes::Post(router, "/api/game/cashout", 
-        Routes::bind(&CrashGameServer::cashout, this));
+        queued("http.cashout", WorkPriority::COMMAND, &CrashGameServer::cashout, true));
     Routes::Options(router, "/api/game/cashout", 
         Routes::bind(&CrashGameServer::handleOptions, this));
+    
+    // İkili bet/cashout komutları (bot'lar için)
+    Routes::Post(router, "/api/game/command", 
+        queued("http.binaryCommand", WorkPriority::COMMAND, &CrashGameServer::binaryCommand, true));
+    Routes::Options(router, "/api/game/command", 
+        Routes::bind(&CrashGameServer::handleOptions, this));
 
     // bringBeko endpoint
     Routes::Post(router, "/api/game/bring-beko", 
-        Routes::bind(&CrashGameServer::bringBeko, this));
+        queued("http.bringBeko", WorkPriority::COMMAND, &CrashGameServer::bringBeko));
     Routes::Options(router, "/api/game/bring-beko", 
         Routes::bind(&CrashGameServer::handleOptions, this));
 
     // Load balance endpoint
     Routes::Post(router, "/api/game/load-balance", 
-        Routes::bind(&CrashGameServer::loadBalance, this));
+        queued("http.loadBalance", WorkPriority::COMMAND, &CrashGameServer::loadBalance));
     Routes::Options(router, "/api/game/load-balance", 
         Routes::bind(&CrashGameServer::handleOptions, this));
+    
+    // Admin: CSV / NDJSON toplu bakiye yükleme (satır başına hata raporu, ?upload=&part=&last=1 ile parçalı)
+    Routes::Post(router, "/api/admin/balances/import", 
+        queuedOn(import_dispatcher, "http.importBalances", WorkPriority::COMMAND, &CrashGameServer::importBalances, false));
+    Routes::Options(router, "/api/admin/balances/import", 
+        Routes::bind(&CrashGameServer::handleOptions, this));
+    
+    // Admin: settle edilmiş bahisler NDJSON olarak, chunked (?from=&to= ms, ?from_round=&to_round=)
+    Routes::Get(router, "/api/admin/settlements/export", 
+        queuedOn(export_dispatcher, "http.exportSettlements", WorkPriority::READ, &CrashGameServer::exportSettlements, false));
 
     // Get players info endpoint
     Routes::Put(router, "/api/game/players", 
-        Routes::bind(&CrashGameServer::getPlayersInfo, this));
+        queued("http.getPlayersInfo", WorkPriority::READ, &CrashGameServer::getPlayersInfo));
     Routes::Options(router, "/api/game/players", 
         Routes::bind(&CrashGameServer::handleOptions, this));
 
     // Get active bets endpoint
     Routes::Get(router, "/api/game/active-bets", 
-        Routes::bind(&CrashGameServer::getActiveBets, this));
+        queued("http.getActiveBets", WorkPriority::READ, &CrashGameServer::getActiveBets));
 
     // Get old crash points endpoint
     Routes::Get(router, "/api/game/old-crash-points", 
-        Routes::bind(&CrashGameServer::getOldCrashPoints, this));
+        queued("http.getOldCrashPoints", WorkPriority::READ, &CrashGameServer::getOldCrashPoints));
+
+    // Liderlik tabloları (round, günlük, tüm zamanlar)
+    Routes::Get(router, "/api/game/leaderboard", 
+        queued("http.getLeaderboard", WorkPriority::READ, &CrashGameServer::getLeaderboard));
+
+    // Oyuncunun geçmiş bahisleri (imleç ile sayfalı)
+    Routes::Put(router, "/api/game/bet-history", 
+        queued("http.getBetHistory", WorkPriority::READ, &CrashGameServer::getBetHistory));
+    Routes::Options(router, "/api/game/bet-history", 
+        Routes::bind(&CrashGameServer::handleOptions, this));
+
+    // Admin: kuyruk metrikleri (kuyruğa girmez, yük altında da cevap verir)
+    Routes::Get(router, "/api/admin/metrics", 
+        Routes::bind(&CrashGameServer::getMetrics, this));
+    
+    // Admin: anlık kasa riski ve round toplamları (O(1), bahisleri taramaz)
+    Routes::Get(router, "/api/admin/exposure", 
+        Routes::bind(&CrashGameServer::getExposure, this));
+    
+    // Provably-fair: zincir taahhüdü ve crash olmuş round'ların doğrulaması
+    Routes::Get(router, "/api/fair", 
+        Routes::bind(&CrashGameServer::getFairness, this));
+    Routes::Get(router, "/api/fair/verify", 
+        Routes::bind(&CrashGameServer::verifyRound, this));
+    
+    // Admin: thread başına son span'ler (Chrome / Perfetto trace-event JSON)
+    Routes::Get(router, "/api/admin/trace", 
+        Routes::bind(&CrashGameServer::getTrace, this));
+    
+    // Eşleşmeyen her şey: frontend dosyaları ve SPA route'ları (sadece CRASH_STATIC_DIR ile)
+    if (static_assets.size() > 0) {
+        router.addNotFoundHandler(Routes::bind(&CrashGameServer::serveStatic, this));
+    }
 
     httpEndpoint->setHandler(router.handler());
 }
 
-void CrashGameServer::enableCors(Http::ResponseWriter& response) {
+void CrashGameServer::setupWebSocket() {
+    auto balanceOf = [this](const std::string& playerId) -> int64_t {
+        auto player = game.get_player(playerId);
+        return player ? player->get_balance() : 0;
+    };
+    websocket.set_handlers(WebSocketHandlers{
+        [this](const std::string& playerId) { return game.get_player(playerId) != nullptr; },
+        [this, balanceOf](const std::string& playerId, const tick_protocol::Command& command, int64_t& balance) {
+            TRACE_SPAN("websocket.command");
+            // Aynı oyuncu limiti: WebSocket, HTTP uçlarının yanında bir kaçış yolu olmasın
+            bool success = player_limiter.try_acquire(playerId) &&
+                (command.type == tick_protocol::MessageType::BET ? game.place_bet(playerId, command.amount)
+                                                                 : game.cashout(playerId));
+            balance = balanceOf(playerId);
+            return success;
+        },
+        balanceOf
+    });
+}
+
+std::string CrashGameServer::getClientAddress(const Rest::Request& request) const {
+    std::string peer = request.address().host();
+    // nginx arkasındayken gerçek istemci adresi X-Real-IP'de; sadece yerel proxy'ye güven
+    if (peer == "127.0.0.1" || peer == "::1") {
+        std::string forwarded = HttpHelpers::getHeaderValue(request, "X-Real-IP");
+        if (!forwarded.empty()) return forwarded;
+    }
+    return peer;
+}
+
+bool CrashGameServer::admitMutation(const Rest::Request& request, Http::ResponseWriter& response) {
+    int retryAfter = 0;
+    if (!ip_limiter.try_acquire(getClientAddress(request))) {
+        retryAfter = ip_limiter.get_retry_after_seconds();
+    } else {
+        std::string playerId;
+        tick_protocol::Command command;
+        const std::string& body = request.body();
+        if (tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(body.data()), body.size(), command)) {
+            playerId = std::string(command.player_id);
+        } else {
+            playerId = JsonUtils::peekString(body, "player_id");
+        }
+        if (!playerId.empty() && !player_limiter.try_acquire(playerId)) {
+            retryAfter = player_limiter.get_retry_after_seconds();
+        }
+    }
+    if (retryAfter == 0) return true;
+    
+    // Ucuz red: body bir kez üretilir, log basılmaz
+    static const std::string tooManyRequests = JsonUtils::createErrorResponse(
+        "Çok fazla istek", "Lütfen biraz bekleyip tekrar deneyin").dump();
+    HttpHelpers::enableCors(response);
     response.headers()
-        .add<Http::Header::AccessControlAllowOrigin>("*")
-        .add<Http::Header::AccessControlAllowMethods>("GET, POST, PUT, OPTIONS")
-        .add<Http::Header::AccessControlAllowHeaders>("Content-Type");
+        .addRaw(Http::Header::Raw("Retry-After", std::to_string(retryAfter)))
+        .add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Too_Many_Requests, tooManyRequests);
+    return false;
 }
 
-void CrashGameServer::start() {
+bool CrashGameServer::runIdempotent(const Rest::Request& request, const std::string& playerId, uint64_t fingerprint,
+                                    Http::ResponseWriter& response, const std::function<bool()>& action, bool& success) {
+    std::string key = HttpHelpers::getHeaderValue(request, "Idempotency-Key");
+    if (key.empty()) {
+        success = action();
+        return true;
+    }
+    
+    Http::Code code = Http::Code::Bad_Request;
+    json errorResponse;
+    if (key.size() > IdempotencyCache::MAX_KEY_LENGTH) {
+        errorResponse = JsonUtils::createErrorResponse("Geçersiz Idempotency-Key", "En fazla 255 karakter");
+    } else {
+        IdempotencyStatus status = idempotency_cache.begin(playerId, key, fingerprint, CrashGame::now_ms());
+        switch (status) {
+            case IdempotencyStatus::NEW:
+                try {
+                    success = action();
+                } catch (...) {
+                    idempotency_cache.forget(playerId, key);
+                    throw;
+                }
+                idempotency_cache.complete(playerId, key, success, CrashGame::now_ms());
+                return true;
+            case IdempotencyStatus::SUCCEEDED:
+            case IdempotencyStatus::FAILED:
+                // Tekrar: oyuna dokunmadan ilk sonuç
+                success = status == IdempotencyStatus::SUCCEEDED;
+                response.headers().addRaw(Http::Header::Raw("Idempotent-Replayed", "true"));
+                return true;
+            case IdempotencyStatus::IN_PROGRESS:
+                code = Http::Code::Conflict;
+                errorResponse = JsonUtils::createErrorResponse("İstek zaten işleniyor", "Lütfen biraz sonra tekrar deneyin");
+                response.headers().addRaw(Http::Header::Raw("Retry-After", "1"));
+                break;
+            case IdempotencyStatus::MISMATCH:
+                code = Http::Code::Unprocessable_Entity;
+                errorResponse = JsonUtils::createErrorResponse("Idempotency-Key farklı bir istekle kullanılmış");
+                break;
+            case IdempotencyStatus::FULL:
+                // Kaydı açılamayan istek işlenmez: tekrarı tanınmazdı
+                code = Http::Code::Service_Unavailable;
+                errorResponse = JsonUtils::createErrorResponse("Çok fazla eşzamanlı istek", "Lütfen biraz sonra tekrar deneyin");
+                response.headers().addRaw(Http::Header::Raw("Retry-After", "1"));
+                break;
+        }
+    }
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(code, errorResponse.dump());
+    return false;
+}
+
+Rest::Route::Handler CrashGameServer::queued(const char* trace_name, WorkPriority priority, RequestHandler handler, bool rate_limited) {
+    return queuedOn(dispatcher, trace_name, priority, handler, rate_limited);
+}
+
+Rest::Route::Handler CrashGameServer::queuedOn(WorkDispatcher& target, const char* trace_name, WorkPriority priority,
+                                               RequestHandler handler, bool rate_limited) {
+    return [this, &target, trace_name, priority, handler, rate_limited](const Rest::Request& request, Http::ResponseWriter response) {
+        // Limit aşan istekler kuyruğa hiç girmez
+        if (rate_limited && !admitMutation(request, response)) {
+            return Rest::Route::Result::Ok;
+        }
+        
+        struct PendingRequest {
+            Rest::Request request;
+            Http::ResponseWriter response;
+        };
+        auto pending = std::make_shared<PendingRequest>(PendingRequest{request, std::move(response)});
+        int64_t submitted_ns = trace::enabled() ? trace::now_ns() : 0;
+        
+        http_in_flight++;
+        bool accepted = target.submit(priority, [this, trace_name, handler, pending, submitted_ns] {
+            InFlightGuard guard{http_in_flight};
+            if (submitted_ns != 0) trace::record("http.queue_wait", submitted_ns, trace::now_ns());
+            TRACE_SPAN(trace_name);
+            // Devir sürüyor: istemci sonraki isteğini yeni bağlantıyla (ardıla) açsın
+            if (handoff_draining) pending->response.headers().addRaw(Http::Header::Raw("Connection", "close"));
+            (this->*handler)(pending->request, std::move(pending->response));
+        });
+        if (!accepted) {
+            http_in_flight--;
+            sendOverloaded(pending->response);
+        }
+        return Rest::Route::Result::Ok;
+    };
+}
+
+void CrashGameServer::sendOverloaded(Http::ResponseWriter& response) {
+    static const std::string overloaded = JsonUtils::createErrorResponse(
+        "Sunucu yoğun", "Lütfen biraz sonra tekrar deneyin").dump();
+    HttpHelpers::enableCors(response);
+    response.headers()
+        .addRaw(Http::Header::Raw("Retry-After", "1"))
+        .add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Service_Unavailable, overloaded);
+}
+
+void CrashGameServer::start(int predecessor_fd) {
     running = true;
+    // Ardıl süreç önce dinlemeye başlar: eski süreç dinleyicisini kapatınca gelen istekler
+    // worker'lar başlayana (durum yüklenene) kadar kuyrukta bekler
+    httpEndpoint->serveThreaded();
+    
+    int tick_fd = -1;
+    int websocket_fd = -1;
+    if (predecessor_fd >= 0) {
+        takeOver(predecessor_fd, tick_fd, websocket_fd);
+    }
+    attachStores(predecessor_fd >= 0);
+    if (predecessor_fd >= 0) {
+        // ACK'tan sonra oyun bu süreçte: eski süreç ACK'ı görmeden kapattıysa (zaman aşımı,
+        // devam ediyor) gönderim EPIPE ile başarısız olur ve bu süreç oyunu açmadan çıkar
+        try {
+            handoff::send_message(predecessor_fd, handoff::MessageType::ACK, {});
+        } catch (...) {
+            // Paylaşılan bellek segmenti eski sürecin: çıkarken silinmesin
+            if (state_publisher) state_publisher->release();
+            ::close(predecessor_fd);
+            throw;
+        }
+        ::close(predecessor_fd);
+    }
+    
+    dispatcher.start();
+    export_dispatcher.start();
+    import_dispatcher.start();
+    if (config.tick_stream_port > 0) {
+        if (tick_fd >= 0) {
+            tick_stream.start_on(tick_fd);
+        } else {
+            tick_stream.start(static_cast<uint16_t>(config.tick_stream_port));
+        }
+        std::cout << "📡 İkili tick yayını: tcp://0.0.0.0:" << tick_stream.get_port() << std::endl;
+    } else if (tick_fd >= 0) {
+        ::close(tick_fd);
+    }
+    if (config.websocket_port > 0) {
+        if (websocket_fd >= 0) {
+            websocket.start_on(websocket_fd);
+        } else {
+            websocket.start(static_cast<uint16_t>(config.websocket_port));
+        }
+        std::cout << "🔌 Oyuncu WebSocket'i: ws://0.0.0.0:" << websocket.get_port() << "/ws" << std::endl;
+    } else if (websocket_fd >= 0) {
+        ::close(websocket_fd);
+    }
+    if (!config.hash_chain.path.empty()) {
+        // Milyonlarca link üretmek / doğrulamak saniyeler sürebilir: o sırada round uçmaz,
+        // bahisler WAITING'de alınmaya devam eder (yeniden başlatma ve devir sonrası da)
+        game.set_hash_chain_pending(true);
+    }
     game_thread = std::thread(&CrashGameServer::game_loop, this);
+    if (!config.hash_chain.path.empty()) {
+        chain_thread = std::thread(&CrashGameServer::prepareHashChain, this);
+    }
+    
+    if (!config.handoff_socket.empty()) {
+        handoff_thread = std::thread(&CrashGameServer::handoffLoop, this);
+    }
     
     std::cout << "🚀 Crash Game REST API Server başlatıldı!" << std::endl;
-    std::cout << "📡 http://localhost:8080" << std::endl;
+    std::cout << "📡 http://localhost:" << config.port << std::endl;
     
-    httpEndpoint->serve();
+    std::unique_lock<std::mutex> lock(lifecycle_mutex);
+    lifecycle_cv.wait(lock, [this] { return !running; });
 }
 
 void CrashGameServer::stop() {
-    running = false;
+    {
+        std::lock_guard<std::mutex> lock(lifecycle_mutex);
+        running = false;
+    }
+    lifecycle_cv.notify_all();
     if (game_thread.joinable()) {
         game_thread.join();
     }
+    if (chain_thread.joinable()) {
+        chain_thread.join();
+    }
+    if (handoff_thread.joinable()) {
+        handoff_thread.join();
+    }
     if (httpEndpoint) {
         httpEndpoint->shutdown();
     }
+    dispatcher.stop();
+    export_dispatcher.stop();
+    import_dispatcher.stop();
+    tick_stream.stop();
+    websocket.stop();
+}
+
+void CrashGameServer::attachStores(bool resumed) {
+    // Devirde eski süreç durduktan sonra açılır: dosyalara son yazan o
+    if (!config.history_path.empty()) {
+        game.set_bet_history(std::make_shared<BetHistoryStore>(config.history_path));
+        std::cout << "📜 Bahis geçmişi: " << config.history_path
+                  << " (" << game.get_bet_history()->size() << " kayıt)" << std::endl;
+    }
+    
+    if (!config.player_store_path.empty()) {
+        game.set_player_store(std::make_shared<PlayerStore>(config.player_store_path, resumed));
+        std::cout << "💤 Sayfalanan oyuncular: " << config.player_store_path
+                  << " (" << game.get_player_store()->size() << " oyuncu)" << std::endl;
+    }
+    
+    if (!resumed) {
+        // Round id'leri geçmişte ve zincirde kalıcı: soğuk başlangıç en büyüğünden devam eder
+        uint32_t last_round = game.get_bet_history()->last_round();
+        if (!config.hash_chain.path.empty()) {
+            last_round = std::max(last_round, HashChain::last_taken_round(config.hash_chain.path));
+        }
+        if (last_round > 0) {
+            game.set_first_round(static_cast<int>(last_round) + 1);
+            std::cout << "🔢 Round numaraları " << last_round + 1 << "'den devam ediyor" << std::endl;
+        }
+    }
+    
+    if (!config.journal_path.empty()) {
+        game.set_command_journal(std::make_shared<CommandJournal>(config.journal_path), resumed);
+        std::cout << "📼 Komut günlüğü: " << config.journal_path << std::endl;
+    }
+    
+    if (!config.shm_name.empty()) {
+        state_publisher = std::make_unique<ShmStatePublisher>(config.shm_name);
+        std::cout << "🪞 Oyun durumu paylaşılan belleğe yayınlanıyor: " << config.shm_name << std::endl;
+    }
+}
+
+void CrashGameServer::handoffLoop() {
+    trace::set_thread_name("handoff");
+    int listen_fd = -1;
+    try {
+        listen_fd = handoff::listen(config.handoff_socket);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Devir soketi açılamadı, kesintisiz yeniden başlatma kapalı: " << e.what() << std::endl;
+        return;
+    }
+    std::cout << "🔄 Devir soketi: " << config.handoff_socket << std::endl;
+    
+    while (running) {
+        int successor_fd = handoff::accept(listen_fd, 200);
+        if (successor_fd < 0) continue;
+        bool handed_off = handOff(successor_fd);
+        ::close(successor_fd);
+        if (handed_off) {
+            // start() döner, main çıkar; dosya artık ardılın soketini gösteriyor, silinmez
+            {
+                std::lock_guard<std::mutex> lock(lifecycle_mutex);
+                running = false;
+            }
+            lifecycle_cv.notify_all();
+            break;
+        }
+    }
+    ::close(listen_fd);
+}
+
+bool CrashGameServer::handOff(int successor_fd) {
+    std::string payload;
+    std::vector<int> fds;
+    try {
+        if (handoff::receive_message(successor_fd, payload, fds, HANDOFF_HELLO_TIMEOUT_MS) != handoff::MessageType::HELLO) {
+            throw std::runtime_error("HELLO bekleniyordu");
+        }
+    } catch (const std::exception& e) {
+        for (int fd : fds) ::close(fd);
+        std::cerr << "❌ Geçersiz devir isteği: " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "🔄 Yeni süreç bağlandı: round bitince durum devredilecek" << std::endl;
+    
+    // 1) Uçan round oynanıp biter, sonra oyun döngüsü durur. Ardıl bu sırada çökerse hiçbir şey
+    //    kapatılmadan oyuna devam edilir.
+    handoff_requested = true;
+    while (running && !game_frozen && handoff::peer_alive(successor_fd)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!running || !handoff::peer_alive(successor_fd)) {
+        if (running) std::cerr << "❌ Ardıl süreç durum gelmeden kapandı, devir iptal" << std::endl;
+        handoff_requested = false;
+        game_frozen = false;
+        return false;
+    }
+    
+    // 2) Yeni bağlantılar ardıla gider. Açık keep-alive bağlantılardaki istekler burada işlenir ve
+    //    Connection: close ile cevaplanır; işlenen istek kalmayınca boştaki bağlantılar kapatılır.
+    //    Dispatcher'lar bağlantılar boşalınca (en fazla handoff_drain_ms) durur: sonrasında gelen
+    //    istek 503 alırdı
+    handoff_draining = true;
+    size_t retired = handoff::retire_listeners(static_cast<uint16_t>(config.port));
+    auto drain_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, config.handoff_drain_ms));
+    auto idle_since = std::chrono::steady_clock::time_point::max();
+    size_t closed = 0;
+    while (std::chrono::steady_clock::now() < drain_deadline) {
+        flushLongPolls(true);
+        if (handoff::open_connections(static_cast<uint16_t>(config.port)) == 0) break;
+        auto now = std::chrono::steady_clock::now();
+        if (http_in_flight > 0) {
+            idle_since = std::chrono::steady_clock::time_point::max();
+        } else if (idle_since == std::chrono::steady_clock::time_point::max()) {
+            idle_since = now;
+        } else if (now - idle_since >= std::chrono::milliseconds(HANDOFF_IDLE_MS)) {
+            closed = handoff::close_connections(static_cast<uint16_t>(config.port));
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    dispatcher.stop();
+    export_dispatcher.stop();
+    import_dispatcher.stop();
+    // WebSocket komutları kuyruğa girmeden oyunu değiştirir: oturumlar da kapanır (istemciler
+    // ardıla yeniden bağlanır), dinleme soketinin kopyası devredilir
+    int websocket_fd = websocket.get_listen_fd() >= 0 ? ::fcntl(websocket.get_listen_fd(), F_DUPFD_CLOEXEC, 0) : -1;
+    websocket.stop();
+    
+    // Drain'de park edilmiş long-poll kalmadı; süre dolduysa kalanlar son durumla cevaplanır
+    flushLongPolls(true);
+    
+    // 3) Durum (CBOR) + tick yayını ve WebSocket dinleme soketleri; ardıl ACK verince çıkılır
+    bool state_sent = false;
+    size_t state_bytes = 0;
+    try {
+        json state;
+        game.export_state(state);
+        std::string idempotency = idempotency_cache.save_entries(CrashGame::now_ms());
+        state["idempotency"] = json::binary(std::vector<uint8_t>(idempotency.begin(), idempotency.end()));
+        std::vector<int> passed;
+        state["sockets"] = json::array();
+        if (tick_stream.get_listen_fd() >= 0) {
+            passed.push_back(tick_stream.get_listen_fd());
+            state["sockets"].push_back("tick");
+        }
+        if (websocket_fd >= 0) {
+            passed.push_back(websocket_fd);
+            state["sockets"].push_back("websocket");
+        }
+        std::vector<uint8_t> encoded = json::to_cbor(state);
+        state_bytes = encoded.size();
+        
+        if (!handoff::peer_alive(successor_fd)) throw std::runtime_error("Ardıl süreç kapandı");
+        state_sent = true;
+        handoff::send_message(successor_fd, handoff::MessageType::STATE,
+            std::string_view(reinterpret_cast<const char*>(encoded.data()), encoded.size()), passed);
+        if (handoff::receive_message(successor_fd, payload, fds, HANDOFF_ACK_TIMEOUT_MS) != handoff::MessageType::ACK) {
+            throw std::runtime_error("ACK bekleniyordu");
+        }
+    } catch (const std::exception& e) {
+        // Ardıl ACK'ı bu kapanıştan önce yazdıysa tampondadır: devir tamamlanmış sayılır.
+        // Sonrasında yazamaz (EPIPE) ve kendisi çıkar; iki süreç aynı anda oynamaz.
+        bool late_ack = false;
+        if (state_sent) {
+            ::shutdown(successor_fd, SHUT_RDWR);
+            try {
+                late_ack = handoff::receive_message(successor_fd, payload, fds, 100) == handoff::MessageType::ACK;
+            } catch (const std::exception&) {
+            }
+        }
+        if (!late_ack) {
+            std::cerr << "❌ Devir tamamlanamadı, bu süreç devam ediyor: " << e.what() << std::endl;
+            return resumeAfterHandoff(retired, websocket_fd);
+        }
+    }
+    
+    // Soketler ardılda yaşıyor; bu süreçteki kopyalar kapanır, bağlı istemciler yeniden bağlanır
+    tick_stream.stop();
+    if (websocket_fd >= 0) ::close(websocket_fd);
+    if (state_publisher) state_publisher->release();
+    std::cout << "✅ Durum devredildi: round " << game.get_current_round() << ", "
+              << game.get_player_count() << " oyuncu, " << state_bytes / 1024 << " KB, "
+              << retired << " dinleyici, " << closed << " boştaki bağlantı kapatıldı" << std::endl;
+    return true;
+}
+
+bool CrashGameServer::resumeAfterHandoff(size_t retired, int websocket_fd) {
+    try {
+        // Kapatılan dinleyici geri alınamaz: HTTP endpoint'i yeniden kurulur. Açık bağlantılar
+        // drain sırasında cevaplandı, bekleyen long-poll'lar da yukarıda.
+        if (retired > 0) {
+            httpEndpoint->shutdown();
+            createEndpoint();
+            httpEndpoint->setHandler(router.handler());
+            httpEndpoint->serveThreaded();
+        }
+        dispatcher.start();
+        export_dispatcher.start();
+        import_dispatcher.start();
+        if (websocket_fd >= 0) websocket.start_on(websocket_fd);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Devir sonrası servis yeniden açılamadı, süreç kapanıyor: " << e.what() << std::endl;
+        return true;
+    }
+    handoff_draining = false;
+    handoff_requested = false;
+    game_frozen = false;
+    std::cout << "🔄 Devir iptal edildi, oyun bu süreçte sürüyor" << std::endl;
+    return false;
+}
+
+void CrashGameServer::takeOver(int predecessor_fd, int& tick_fd, int& websocket_fd) {
+    handoff::send_message(predecessor_fd, handoff::MessageType::HELLO, {});
+    std::cout << "🔄 Çalışan süreçten devralınıyor (uçan round bitince)..." << std::endl;
+    
+    std::string payload;
+    std::vector<int> fds;
+    if (handoff::receive_message(predecessor_fd, payload, fds, HANDOFF_STATE_TIMEOUT_MS) != handoff::MessageType::STATE) {
+        for (int fd : fds) ::close(fd);
+        throw std::runtime_error("Devir: STATE bekleniyordu");
+    }
+    
+    // Yarım yüklenmiş durumla oyun açılmaz: hata main'e kadar çıkar
+    json state = json::from_cbor(payload);
+    // fd'lerin sırası "sockets" listesinde; listesiz eski sürüm sadece tick soketini gönderir
+    std::vector<std::string> sockets = state.contains("sockets") ?
+        state["sockets"].get<std::vector<std::string>>() : std::vector<std::string>{"tick"};
+    for (size_t i = 0; i < fds.size(); i++) {
+        if (i < sockets.size() && sockets[i] == "tick") {
+            tick_fd = fds[i];
+        } else if (i < sockets.size() && sockets[i] == "websocket") {
+            websocket_fd = fds[i];
+        } else {
+            ::close(fds[i]);
+        }
+    }
+    game.import_state(state);
+    if (state.contains("idempotency")) {
+        const auto& entries = state["idempotency"].get_binary();
+        idempotency_cache.restore_entries(
+            std::string_view(reinterpret_cast<const char*>(entries.data()), entries.size()), CrashGame::now_ms());
+    }
+    std::cout << "✅ Durum devralındı: round " << game.get_current_round() << ", "
+              << game.get_player_count() << " oyuncu, " << payload.size() / 1024 << " KB" << std::endl;
+}
+
+void CrashGameServer::prepareHashChain() {
+    trace::set_thread_name("hash-chain");
+    try {
+        auto started = std::chrono::steady_clock::now();
+        std::shared_ptr<HashChain> chain = HashChain::open_or_generate(config.hash_chain);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started).count();
+        game.set_hash_chain(chain);
+        std::cout << "🔗 Hash zinciri hazır: " << chain->get_path() << " (" << chain->next_index() << "/"
+                  << chain->length() << " kullanıldı, " << elapsed << " ms), uç: "
+                  << HashChain::to_hex(chain->terminal_hash()) << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Hash zinciri hazırlanamadı, crash noktaları RNG'den: " << e.what() << std::endl;
+        game.set_hash_chain_pending(false);
+    }
 }
 
 void CrashGameServer::game_loop() {
+    trace::set_thread_name("game");
     while (running) {
-        game.update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms update rate
+        // Devir istendi: uçan round bitene kadar oynanır, sonra durum değişmesin diye durulur
+        if (handoff_requested && game.get_phase() != GamePhase::FLYING) {
+            game_frozen = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        tick();
+        if (trace::take_dump_request()) {
+            writeTraceDump();
+        }
+        // WAITING / CRASHED seyrek, FLYING sık tick'ler; faz bitişi hiç kaçırılmaz
+        int sleep_ms = tick_policy.next_tick_ms(game.get_phase(), game.get_remaining_time_ms());
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    }
+}
+
+void CrashGameServer::tick() {
+    TRACE_SPAN("tick");
+    game.update();
+    if (synthetic_players) {
+        synthetic_players->on_tick(game);
+    }
+    
+    TRACE_SPAN("publish");
+    GameSnapshot snapshot = GameStateSerializer::captureSnapshot(game);
+    // Kuyruk versiyonu ilerlemeden önce: yeni versiyonu alan istemci en fazla bir kez hemen cevaplanır
+    latest_snapshot.store(snapshot);
+    if (state_publisher) {
+        state_publisher->publish(snapshot);
     }
+    if (config.tick_stream_port > 0 || config.websocket_port > 0) {
+        uint8_t frame[tick_protocol::TICK_SIZE];
+        tick_protocol::encode_tick(GameStateSerializer::serializeTick(snapshot, snapshot.published_at_ms), frame);
+        if (config.tick_stream_port > 0) tick_stream.publish(frame, sizeof(frame));
+        if (config.websocket_port > 0) websocket.publish(frame, sizeof(frame));
+    }
+    wakeLongPolls(snapshot, game.get_phase());
 }
 
-void CrashGameServer::getGameStatus(const Rest::Request&, Http::ResponseWriter response) {
-    enableCors(response);
+void CrashGameServer::wakeLongPolls(const GameSnapshot& snapshot, GamePhase phase) {
+    int64_t now = snapshot.published_at_ms;
+    std::vector<Http::ResponseWriter> waiters = long_poll.advance(snapshot.status_version);
+    std::vector<Http::ResponseWriter> spectators =
+        spectator_poll.advance(snapshot.status_version, tick_policy.spectator_cutoff_ms(phase, now));
+    std::vector<Http::ResponseWriter> expired = long_poll.expire(now);
+    std::vector<Http::ResponseWriter> expired_spectators = spectator_poll.expire(now);
+    if (waiters.empty() && spectators.empty() && expired.empty() && expired_spectators.empty()) return;
+    
+    // Gövde bekleyen sayısından bağımsız olarak tek kez serialize edilir
+    TRACE_SPAN("long_poll.wake");
+    for (auto* group : {&spectators, &expired, &expired_spectators}) {
+        for (auto& response : *group) waiters.push_back(std::move(response));
+    }
+    HttpHelpers::sendStatusToWaiters(waiters,
+        GameStateSerializer::serializeSnapshot(snapshot, snapshot.published_at_ms).dump());
+}
+
+void CrashGameServer::flushLongPolls(bool close_connection) {
+    // Bekleyenler son durumla cevaplanır; tekrar sorduklarında ardıla gelirler
+    std::vector<Http::ResponseWriter> waiters = long_poll.expire(std::numeric_limits<int64_t>::max());
+    for (auto& response : spectator_poll.expire(std::numeric_limits<int64_t>::max())) {
+        waiters.push_back(std::move(response));
+    }
+    if (waiters.empty()) return;
+    GameSnapshot snapshot = GameStateSerializer::captureSnapshot(game);
+    HttpHelpers::sendStatusToWaiters(waiters,
+        GameStateSerializer::serializeSnapshot(snapshot, snapshot.published_at_ms).dump(), close_connection);
+}
+
+void CrashGameServer::writeTraceDump() {
+    std::ofstream out(config.trace_path, std::ios::trunc);
+    out << trace::dump_json();
+    if (out) {
+        std::cout << "🔬 İz dökümü yazıldı: " << config.trace_path << std::endl;
+    } else {
+        std::cerr << "❌ İz dökümü yazılamadı: " << config.trace_path << std::endl;
+    }
+}
+
+void CrashGameServer::getGameStatus(const Rest::Request& request, Http::ResponseWriter response) {
+    // Long-poll: istemcinin bildiği versiyon hâlâ güncelse cevap oyun thread'ine bırakılır.
+    // Header'lar cevaplanırken eklenir; burada worker thread'i hemen serbest kalır.
+    // Açık bahsi olmayan (player_id yok / cashout yapmış) istemciler seyrek kuyruğa düşer.
+    // Cevap canlı oyundan değil son yayınlanan snapshot'tan: tick'ler arası bahis / cashout
+    // versiyonu kuyruğun önüne geçirip istemciyi hemen-cevap döngüsüne sokmasın (replica ile aynı)
+    uint64_t since = 0;
+    if (!HttpHelpers::acceptsBinaryTick(request) && HttpHelpers::getSinceVersion(request, since)) {
+        auto playerId = request.query().get("player_id");
+        bool bettor = playerId && game.has_active_bet(*playerId);
+        // Devirde park edilmez: bağlantı hemen cevaplanıp kapanmalı
+        if (!handoff_draining && (bettor ? long_poll : spectator_poll).park(since, response, CrashGame::now_ms())) {
+            return;
+        }
+    }
+    
+    HttpHelpers::enableCors(response);
     
     try {
-        // 🎮 Modern JSON serialization ile oyun durumunu döndür
-        json gameState = GameStateSerializer::serializeGameState(game);
+        GameSnapshot snapshot;
+        if (!latest_snapshot.load(snapshot)) {
+            snapshot = GameStateSerializer::captureSnapshot(game);  // İlk tick'ten önce
+        }
+        int64_t now = CrashGame::now_ms();
+        
+        // Bot'lar Accept: application/x-crash-tick ile 32 byte'lık ikili tick alır
+        response.headers().addRaw(Http::Header::Raw("Vary", "Accept"));
+        if (HttpHelpers::acceptsBinaryTick(request)) {
+            uint8_t frame[tick_protocol::TICK_SIZE];
+            tick_protocol::encode_tick(GameStateSerializer::serializeTick(snapshot, now), frame);
+            response.send(Http::Code::Ok, reinterpret_cast<const char*>(frame), sizeof(frame), HttpHelpers::binaryTickMime());
+            return;
+        }
         
         response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
-        response.send(Http::Code::Ok, gameState.dump());
+        response.send(Http::Code::Ok, GameStateSerializer::serializeSnapshot(snapshot, now).dump());
         
     } catch (const std::exception& e) {
         std::cerr << "❌ Game status error: " << e.what() << std::endl;
@@ -142,7 +858,7 @@ void CrashGameServer::getGameStatus(const Rest::Request&, Http::ResponseWriter r
 }
 
 void CrashGameServer::joinGame(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     
     try {
         // 🔍 Request'i parse et ve validate et
@@ -195,7 +911,7 @@ void CrashGameServer::joinGame(const Rest::Request& request, Http::ResponseWrite
 }
 
 void CrashGameServer::placeBet(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     
     try {
         // 🔍 Request'i parse et ve validate et
@@ -204,7 +920,7 @@ void CrashGameServer::placeBet(const Rest::Request& request, Http::ResponseWrite
         if (!JsonUtils::validateBetRequest(requestJson)) {
             json errorResponse = JsonUtils::createErrorResponse(
                 "Geçersiz bahis formatı",
-                "player_id ve pozitif amount gerekli"
+                "player_id ve en fazla 2 ondalıklı pozitif amount gerekli"
             );
             response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
             response.send(Http::Code::Bad_Request, errorResponse.dump());
@@ -213,11 +929,17 @@ void CrashGameServer::placeBet(const Rest::Request& request, Http::ResponseWrite
         
         // 🎮 Type-safe JSON parsing
         std::string playerId = JsonUtils::getString(requestJson, "player_id");
-        double amount = JsonUtils::getDouble(requestJson, "amount");
+        Money amount = 0;
+        JsonUtils::getMoney(requestJson, "amount", amount);  // validateBetRequest zaten kontrol etti
         
-        std::cout << "💰 Bet request: " << playerId << " -> " << amount << " TL" << std::endl;
-        
-        bool success = game.place_bet(playerId, amount);
+        bool success = false;
+        auto execute = [&]() {
+            std::cout << "💰 Bet request: " << playerId << " -> " << money_to_string(amount) << " TL" << std::endl;
+            return game.place_bet(playerId, amount);
+        };
+        if (!runIdempotent(request, playerId, commandFingerprint(true, amount), response, execute, success)) {
+            return;
+        }
         
         json responseJson = success ? 
             JsonUtils::createSuccessResponse("Bahis başarıyla yerleştirildi") :
@@ -240,7 +962,7 @@ void CrashGameServer::placeBet(const Rest::Request& request, Http::ResponseWrite
 }
 
 void CrashGameServer::cashout(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     
     try {
         // 🔍 Request'i parse et ve validate et
@@ -259,9 +981,14 @@ void CrashGameServer::cashout(const Rest::Request& request, Http::ResponseWriter
         // 🎮 Type-safe JSON parsing
         std::string playerId = JsonUtils::getString(requestJson, "player_id");
         
-        std::cout << "💸 Cashout request: " << playerId << std::endl;
-        
-        bool success = game.cashout(playerId);
+        bool success = false;
+        auto execute = [&]() {
+            std::cout << "💸 Cashout request: " << playerId << std::endl;
+            return game.cashout(playerId);
+        };
+        if (!runIdempotent(request, playerId, commandFingerprint(false, 0), response, execute, success)) {
+            return;
+        }
         
         json responseJson = success ? 
             JsonUtils::createSuccessResponse("Başarıyla cashout yapıldı") :
@@ -283,13 +1010,43 @@ void CrashGameServer::cashout(const Rest::Request& request, Http::ResponseWriter
     }
 }
 
+void CrashGameServer::binaryCommand(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    const std::string& body = request.body();
+    tick_protocol::Command command;
+    if (!tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(body.data()), body.size(), command) ||
+        (command.type == tick_protocol::MessageType::BET && command.amount <= 0)) {
+        json errorResponse = JsonUtils::createErrorResponse("Geçersiz ikili komut", "BET veya CASHOUT çerçevesi bekleniyor");
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Bad_Request, errorResponse.dump());
+        return;
+    }
+    
+    std::string playerId(command.player_id);
+    bool isBet = command.type == tick_protocol::MessageType::BET;
+    bool success = false;
+    auto execute = [&]() {
+        return isBet ? game.place_bet(playerId, command.amount) : game.cashout(playerId);
+    };
+    if (!runIdempotent(request, playerId, commandFingerprint(isBet, isBet ? command.amount : 0), response, execute, success)) {
+        return;
+    }
+    
+    // Cevap da ikili: sonuç + güncel bakiye (oyuncu yoksa 0)
+    auto player = game.get_player(playerId);
+    uint8_t ack[tick_protocol::ACK_SIZE];
+    tick_protocol::encode_ack(success, player ? player->get_balance() : 0, ack);
+    response.send(Http::Code::Ok, reinterpret_cast<const char*>(ack), sizeof(ack), HttpHelpers::binaryTickMime());
+}
+
 void CrashGameServer::handleOptions(const Rest::Request&, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     response.send(Http::Code::Ok, "");
 }
 
 void CrashGameServer::bringBeko(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     try {
         json requestJson = JsonUtils::parseRequest(request.body());
         std::string playerId = JsonUtils::getString(requestJson, "player_id");
@@ -300,14 +1057,20 @@ void CrashGameServer::bringBeko(const Rest::Request& request, Http::ResponseWrit
             response.send(Http::Code::Bad_Request, errorResponse.dump());
             return;
         }
-        double balance = player->get_balance();
-        if (balance <= 2000) {
+        Money balance = player->get_balance();
+        if (balance <= 2000 * MONEY_SCALE) {
             json errorResponse = JsonUtils::createErrorResponse("Bakiye 2000 TL'den fazla olmalı");
             response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
             response.send(Http::Code::Ok, errorResponse.dump());
             return;
         }
-        player->deduct_balance(balance);
+        // Okuma ile çekme arasında bahis / cashout bakiyeyi değiştirmiş olabilir
+        if (!game.withdraw_balance(playerId, balance)) {
+            json errorResponse = JsonUtils::createErrorResponse("Bakiye çekilemedi", "Bakiye değişti, tekrar deneyin");
+            response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+            response.send(Http::Code::Conflict, errorResponse.dump());
+            return;
+        }
         std::vector<std::string> ulkeler = {"türkiye", "kuzey irak", "fildisi sahilleri"};
         std::random_device rd;
         std::mt19937 gen(rd());
@@ -324,14 +1087,20 @@ void CrashGameServer::bringBeko(const Rest::Request& request, Http::ResponseWrit
 }
 
 void CrashGameServer::loadBalance(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
     
     try {
         json requestJson = JsonUtils::parseRequest(request.body());
         std::string playerName = JsonUtils::getString(requestJson, "player_name");
-        double amount = JsonUtils::getDouble(requestJson, "amount");
+        Money amount = 0;
+        if (!JsonUtils::getMoney(requestJson, "amount", amount) || amount <= 0) {
+            json errorResponse = JsonUtils::createErrorResponse("Geçersiz miktar", "En fazla 2 ondalıklı pozitif amount gerekli");
+            response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+            response.send(Http::Code::Bad_Request, errorResponse.dump());
+            return;
+        }
 
-        std::cout << "💳 Load balance request: " << playerName << " -> " << amount << " TL" << std::endl;
+        std::cout << "💳 Load balance request: " << playerName << " -> " << money_to_string(amount) << " TL" << std::endl;
         
         std::shared_ptr<Player> _player =  nullptr;
         game.get_player_by_name(playerName, _player);
@@ -364,8 +1133,143 @@ void CrashGameServer::loadBalance(const Rest::Request& request, Http::ResponseWr
     }
 }
 
+void CrashGameServer::importBalances(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    
+    // Gövde en fazla max_request_bytes; satırlar kopyalanmadan ayrıştırılır. Her 1000 kredi oyuna
+    // tek kilitle uygulanır, aradaki boşlukta oyun döngüsü tick atabilir
+    auto upload = request.query().get("upload");
+    if (!upload || upload->empty()) {
+        BalanceImportReport report;
+        BalanceImportParser parser(report, [this, &report](const std::vector<BalanceCredit>& batch) {
+            game.load_balances(batch, report);
+        });
+        parser.feed(request.body());
+        parser.finish();
+        
+        std::cout << "💳 Toplu bakiye yükleme: " << report.credited << "/" << report.rows << " satır, "
+                  << money_to_string(report.total) << " TL" << std::endl;
+        response.send(report.rows == 0 ? Http::Code::Bad_Request : Http::Code::Ok,
+                      GameStateSerializer::serializeImportReport(report).dump());
+        return;
+    }
+    
+    // 📦 Büyük dosya: istemci parçaları sırayla yollar, ayrıştırıcı yüklemeler arasında saklanır
+    auto part_text = request.query().get("part");
+    char* end = nullptr;
+    unsigned long part = part_text && !part_text->empty() ? std::strtoul(part_text->c_str(), &end, 10) : 0;
+    if (upload->size() > 64 || (part_text && (part_text->empty() || *end != '\0' || part > UINT32_MAX))) {
+        json errorResponse;
+        errorResponse["success"] = false;
+        errorResponse["error"] = "Geçersiz upload / part";
+        response.send(Http::Code::Bad_Request, errorResponse.dump());
+        return;
+    }
+    auto last = request.query().get("last");
+    bool is_last = last && *last == "1";
+    
+    BalanceImportUploads::Progress progress = import_uploads.feed(
+        *upload, static_cast<uint32_t>(part), is_last, request.body(), CrashGame::now_ms());
+    
+    json result;
+    switch (progress.result) {
+        case BalanceImportUploads::Result::DONE:
+            std::cout << "💳 Toplu bakiye yükleme (" << progress.next_part << " parça): "
+                      << progress.report.credited << "/" << progress.report.rows << " satır, "
+                      << money_to_string(progress.report.total) << " TL" << std::endl;
+            response.send(progress.report.rows == 0 ? Http::Code::Bad_Request : Http::Code::Ok,
+                          GameStateSerializer::serializeImportReport(progress.report).dump());
+            return;
+        case BalanceImportUploads::Result::ACCEPTED:
+            result = GameStateSerializer::serializeImportReport(progress.report);
+            result["next_part"] = progress.next_part;
+            response.send(Http::Code::Accepted, result.dump());
+            return;
+        case BalanceImportUploads::Result::OUT_OF_ORDER:
+            // Tekrarlanan parça tekrar uygulanmaz; istemci next_part'tan devam eder
+            result["success"] = false;
+            result["error"] = "Parça sırası bozuk";
+            result["next_part"] = progress.next_part;
+            response.send(Http::Code::Conflict, result.dump());
+            return;
+        case BalanceImportUploads::Result::UNKNOWN_UPLOAD:
+            result["success"] = false;
+            result["error"] = "Yükleme bulunamadı veya zaman aşımına uğradı";
+            response.send(Http::Code::Not_Found, result.dump());
+            return;
+        case BalanceImportUploads::Result::TOO_MANY:
+            result["success"] = false;
+            result["error"] = "Çok fazla eşzamanlı yükleme";
+            response.send(Http::Code::Service_Unavailable, result.dump());
+            return;
+    }
+}
+
+void CrashGameServer::exportSettlements(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    ExportRange range;
+    bool valid = true;
+    auto parse = [&request, &valid](const char* name, auto& out) {
+        auto value = request.query().get(name);
+        if (!value || value->empty()) return;
+        char* end = nullptr;
+        long long parsed = std::strtoll(value->c_str(), &end, 10);
+        using Target = std::decay_t<decltype(out)>;
+        if (*end != '\0' || parsed < 0 ||
+            static_cast<unsigned long long>(parsed) > static_cast<unsigned long long>(std::numeric_limits<Target>::max())) {
+            valid = false;
+            return;
+        }
+        out = static_cast<Target>(parsed);
+    };
+    parse("from", range.from_ms);
+    parse("to", range.to_ms);
+    parse("from_round", range.from_round);
+    parse("to_round", range.to_round);
+    if (!valid) {
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Bad_Request, JsonUtils::createErrorResponse(
+            "Geçersiz aralık", "from/to: Unix epoch ms, from_round/to_round: round numarası").dump());
+        return;
+    }
+    
+    // Her parça ayrı bir HTTP chunk'ı: bellekte en fazla bir parça ve bir batch kayıt durur
+    std::shared_ptr<BetHistoryStore> history = game.get_bet_history();
+    SettlementExporter exporter(*history, range, EXPORT_CHUNK_BYTES);
+    response.headers().add<Http::Header::ContentType>(Http::Mime::MediaType::fromString("application/x-ndjson"));
+    Http::ResponseStream stream = response.stream(Http::Code::Ok, EXPORT_CHUNK_BYTES * 2);
+    std::string chunk;
+    chunk.reserve(EXPORT_CHUNK_BYTES * 2);
+    std::string error;
+    try {
+        while (running && exporter.next_chunk(chunk)) {
+            stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            stream.flush();
+        }
+        if (!exporter.is_complete()) {
+            error = running ? "Bahis geçmişi okunamadı" : "Sunucu kapanıyor";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Settlement dışa aktarımı hatası: " << e.what() << std::endl;
+        error = e.what();
+    }
+    
+    // Chunked sonlandırıcı yarım cevapta da yazılır: bütünlüğü son satır söyler
+    chunk.clear();
+    SettlementExporter::append_trailer(chunk, error.empty(), exporter.get_rows(), error);
+    stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    stream.ends();
+    if (error.empty()) {
+        std::cout << "🧾 Settlement dışa aktarımı: " << exporter.get_rows() << " satır" << std::endl;
+    } else {
+        std::cerr << "❌ Settlement dışa aktarımı yarım kaldı (" << exporter.get_rows() << " satır): " << error << std::endl;
+    }
+}
+
 void CrashGameServer::getPlayersInfo(const Rest::Request& request, Http::ResponseWriter response) {
-    enableCors(response);
+    HttpHelpers::enableCors(response);
 
     try {
         json requestJson = JsonUtils::parseRequest(request.body());
@@ -382,7 +1286,7 @@ void CrashGameServer::getPlayersInfo(const Rest::Request& request, Http::Respons
         json playerJson;
         playerJson["player_id"] = player->get_id();
         playerJson["name"] = player->get_name();
-        playerJson["balance"] = player->get_balance();
+        playerJson["balance"] = money_to_double(player->get_balance());
         
         json responseJson = JsonUtils::createSuccessResponse("Oyuncu bilgileri alındı", playerJson);
 
@@ -402,17 +1306,20 @@ void CrashGameServer::getPlayersInfo(const Rest::Request& request, Http::Respons
     }
 }
 
-void CrashGameServer::getActiveBets(const Rest::Request&, Http::ResponseWriter response) {
-    enableCors(response);
+void CrashGameServer::getActiveBets(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
     
     try {
-        // 🎮 Modern JSON serialization ile aktif bahisleri döndür
+        // 🎮 Aynı versiyon için body bir kez üretilir, sonraki istekler önbellekten döner
+        uint64_t version = game.get_bets_version();
+        auto cached = response_cache.get("active-bets", version);
+        if (!cached) {
+            json activeBets {};
+            game.get_current_bets_json(activeBets);
+            cached = response_cache.put("active-bets", version, activeBets.dump());
+        }
 
-        json activeBets {};
-        game.get_current_bets_json(activeBets);
-
-        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
-        response.send(Http::Code::Ok, activeBets.dump());
+        HttpHelpers::sendCached(request, response, cached);
 
     } catch (const std::exception& e) {
         std::cerr << "❌ Game status error: " << e.what() << std::endl;
@@ -427,16 +1334,20 @@ void CrashGameServer::getActiveBets(const Rest::Request&, Http::ResponseWriter r
     }
 }
 
-void CrashGameServer::getOldCrashPoints(const Rest::Request&, Http::ResponseWriter response) {
-    enableCors(response);
+void CrashGameServer::getOldCrashPoints(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
     
     try {
-        // 🎮 Modern JSON serialization ile eski crash noktalarını döndür
-        json oldCrashPoints {};
-        game.get_old_crash_points_json(oldCrashPoints);
+        // 🎮 Geçmiş sadece round başına bir kez değişir; versiyon bazlı önbellek
+        uint64_t version = game.get_history_version();
+        auto cached = response_cache.get("old-crash-points", version);
+        if (!cached) {
+            json oldCrashPoints {};
+            game.get_old_crash_points_json(oldCrashPoints);
+            cached = response_cache.put("old-crash-points", version, oldCrashPoints.dump());
+        }
         
-        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
-        response.send(Http::Code::Ok, oldCrashPoints.dump());
+        HttpHelpers::sendCached(request, response, cached);
         
     } catch (const std::exception& e) {
         std::cerr << "❌ Old crash points error: " << e.what() << std::endl;
@@ -449,4 +1360,255 @@ void CrashGameServer::getOldCrashPoints(const Rest::Request&, Http::ResponseWrit
         response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
         response.send(Http::Code::Internal_Server_Error, errorResponse.dump());
     }
-}
\ No newline at end of file
+}
+
+void CrashGameServer::getLeaderboard(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    try {
+        // Tablolar sadece settlement'ta değişir; okuma O(K) ve versiyon başına bir kez
+        uint64_t version = game.get_leaderboard_version();
+        auto cached = response_cache.get("leaderboard", version);
+        if (!cached) {
+            // Önbellek anahtarı gövdeyle aynı anda okunan versiyon: arada settlement olduysa
+            // yeni tablo eski versiyonla saklanmaz. Yarıdaki settlement hiç saklanmaz
+            json leaderboard {};
+            uint64_t built_version = 0;
+            if (!game.get_leaderboard_json(leaderboard, built_version)) {
+                response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+                response.send(Http::Code::Ok, leaderboard.dump());
+                return;
+            }
+            cached = response_cache.get("leaderboard", built_version);
+            if (!cached) cached = response_cache.put("leaderboard", built_version, leaderboard.dump());
+        }
+        
+        HttpHelpers::sendCached(request, response, cached);
+        
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Leaderboard error: " << e.what() << std::endl;
+        
+        json errorResponse = JsonUtils::createErrorResponse(
+            "Liderlik tablosu alınamadı", 
+            e.what()
+        );
+        
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Internal_Server_Error, errorResponse.dump());
+    }
+}
+
+void CrashGameServer::getBetHistory(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    try {
+        json requestJson = JsonUtils::parseRequest(request.body());
+        std::string playerId = JsonUtils::getString(requestJson, "player_id");
+        std::string cursor = JsonUtils::getString(requestJson, "cursor");
+        int limit = JsonUtils::getInt(requestJson, "limit", 20);
+        limit = std::max(1, std::min(limit, 100));
+        
+        json history;
+        if (!game.get_bet_history_json(playerId, cursor.empty() ? 0 : std::stoull(cursor), limit, history)) {
+            json errorResponse = JsonUtils::createErrorResponse("Oyuncu bulunamadı");
+            response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+            response.send(Http::Code::Bad_Request, errorResponse.dump());
+            return;
+        }
+        
+        json responseJson = JsonUtils::createSuccessResponse("Bahis geçmişi alındı", history);
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Ok, responseJson.dump());
+        
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Bet history error: " << e.what() << std::endl;
+        
+        json errorResponse = JsonUtils::createErrorResponse(
+            "Bahis geçmişi alınamadı", 
+            e.what()
+        );
+        
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Bad_Request, errorResponse.dump());
+    }
+}
+
+void CrashGameServer::getExposure(const Rest::Request&, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Ok, GameStateSerializer::serializeExposure(game).dump());
+}
+
+void CrashGameServer::getFairness(const Rest::Request&, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    std::shared_ptr<HashChain> chain = game.get_hash_chain();
+    if (!chain) {
+        response.send(Http::Code::Service_Unavailable, JsonUtils::createErrorResponse(
+            "Hash zinciri hazır değil", "Crash noktaları şu an RNG'den üretiliyor").dump());
+        return;
+    }
+    response.send(Http::Code::Ok,
+                  GameStateSerializer::serializeFairness(*chain, game.get_round_chain_index()).dump());
+}
+
+void CrashGameServer::verifyRound(const Rest::Request& request, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    std::shared_ptr<HashChain> chain = game.get_hash_chain();
+    if (!chain) {
+        response.send(Http::Code::Service_Unavailable, JsonUtils::createErrorResponse(
+            "Hash zinciri hazır değil", "Crash noktaları şu an RNG'den üretiliyor").dump());
+        return;
+    }
+    
+    // ?round=<round numarası> veya ?index=<zincir sırası>
+    auto by_round = request.query().get("round");
+    auto value = by_round ? by_round : request.query().get("index");
+    char* end = nullptr;
+    uint64_t number = value && !value->empty() ? std::strtoull(value->c_str(), &end, 10) : 0;
+    if (!value || value->empty() || *end != '\0' || (by_round && (number == 0 || number > UINT32_MAX))) {
+        response.send(Http::Code::Bad_Request, JsonUtils::createErrorResponse(
+            "Geçersiz round / index", "?round=<round numarası> veya ?index=<zincir sırası> gerekli").dump());
+        return;
+    }
+    
+    uint64_t index = number;
+    if (by_round && !chain->find_revealed_round(static_cast<uint32_t>(number), index)) {
+        // Uçan, henüz oynanmamış veya zincir bağlanmadan RNG ile oynanmış round
+        response.send(Http::Code::Not_Found, JsonUtils::createErrorResponse(
+            "Round zincirde yok", "Sadece zincirden crash noktası almış ve crash olmuş round'lar doğrulanabilir").dump());
+        return;
+    }
+    
+    json link = GameStateSerializer::serializeChainLink(*chain, index);
+    if (link.is_null()) {
+        // Henüz oynanmamış veya uçmakta olan round'un hash'i açıklanmaz
+        response.send(Http::Code::Not_Found, JsonUtils::createErrorResponse(
+            "Round henüz açıklanmadı", "Sadece crash olmuş round'lar doğrulanabilir").dump());
+        return;
+    }
+    response.send(Http::Code::Ok, link.dump());
+}
+
+void CrashGameServer::serveStatic(const Rest::Request& request, Http::ResponseWriter response) {
+    // Kuyruğa girmez: cevap hazır bellekte, Pistache thread'inde gönderilir
+    TRACE_SPAN("http.serveStatic");
+    std::string path = request.resource();
+    const StaticAsset* asset = request.method() == Http::Method::Get && path.compare(0, 5, "/api/") != 0 ?
+        static_assets.find(path) : nullptr;
+    if (!asset) {
+        json errorResponse = JsonUtils::createErrorResponse("Bulunamadı", path);
+        response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+        response.send(Http::Code::Not_Found, errorResponse.dump());
+        return;
+    }
+    HttpHelpers::sendCached(request, response, asset->response,
+                            Http::Mime::MediaType::fromString(asset->content_type), asset->cache_control);
+}
+
+void CrashGameServer::getTrace(const Rest::Request&, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    if (!trace::enabled()) {
+        json errorResponse = JsonUtils::createErrorResponse("İzleme kapalı", "CRASH_TRACE_EVENTS > 0 ile başlatın");
+        response.send(Http::Code::Not_Found, errorResponse.dump());
+        return;
+    }
+    response.send(Http::Code::Ok, trace::dump_json());
+}
+
+void CrashGameServer::getMetrics(const Rest::Request&, Http::ResponseWriter response) {
+    HttpHelpers::enableCors(response);
+    
+    DispatcherStats stats = dispatcher.get_stats();
+    json metrics;
+    metrics["queues"] = {
+        {"command_depth", stats.command_depth},
+        {"read_depth", stats.read_depth},
+        {"command_accepted", stats.command_accepted},
+        {"command_rejected", stats.command_rejected},
+        {"read_accepted", stats.read_accepted},
+        {"read_rejected", stats.read_rejected}
+    };
+    DispatcherStats exportStats = export_dispatcher.get_stats();
+    metrics["exports"] = {
+        {"waiting", exportStats.read_depth},
+        {"accepted", exportStats.read_accepted},
+        {"rejected", exportStats.read_rejected}
+    };
+    DispatcherStats importStats = import_dispatcher.get_stats();
+    metrics["imports"] = {
+        {"waiting", importStats.command_depth},
+        {"accepted", importStats.command_accepted},
+        {"rejected", importStats.command_rejected},
+        {"uploads", import_uploads.active()}
+    };
+    TickStreamStats streamStats = tick_stream.get_stats();
+    metrics["tick_stream"] = {
+        {"clients", streamStats.clients},
+        {"connections", streamStats.connections},
+        {"frames_sent", streamStats.frames_sent},
+        {"frames_dropped", streamStats.frames_dropped},
+        {"refused", streamStats.refused}
+    };
+    WebSocketStats websocketStats = websocket.get_stats();
+    metrics["websocket"] = {
+        {"sessions", websocketStats.sessions},
+        {"connections", websocketStats.connections},
+        {"rejected", websocketStats.rejected},
+        {"commands", websocketStats.commands},
+        {"frames_sent", websocketStats.frames_sent},
+        {"frames_dropped", websocketStats.frames_dropped}
+    };
+    if (synthetic_players) {
+        SyntheticStats syntheticStats = synthetic_players->get_stats();
+        metrics["synthetic"] = {
+            {"players", syntheticStats.players},
+            {"rounds", syntheticStats.rounds},
+            {"bets_placed", syntheticStats.bets_placed},
+            {"cashouts", syntheticStats.cashouts}
+        };
+    }
+    IdempotencyStats idempotencyStats = idempotency_cache.get_stats();
+    metrics["idempotency"] = {
+        {"slots", idempotency_cache.capacity()},
+        {"accepted", idempotencyStats.accepted},
+        {"replayed", idempotencyStats.replayed},
+        {"conflicts", idempotencyStats.conflicts},
+        {"evicted", idempotencyStats.evicted},
+        {"full", idempotencyStats.full}
+    };
+    auto longPollJson = [](const LongPollStats& pollStats) {
+        return json{
+            {"parked", pollStats.parked},
+            {"woken", pollStats.woken},
+            {"timed_out", pollStats.timed_out},
+            {"rejected", pollStats.rejected}
+        };
+    };
+    metrics["long_poll"] = {
+        {"bettors", longPollJson(long_poll.get_stats())},
+        {"spectators", longPollJson(spectator_poll.get_stats())}
+    };
+    const TickPolicyConfig& policy = tick_policy.get_config();
+    TickPolicyStats tickStats = tick_policy.get_stats();
+    metrics["tick_policy"] = {
+        {"waiting_tick_ms", policy.waiting_tick_ms},
+        {"flying_tick_ms", policy.flying_tick_ms},
+        {"crashed_tick_ms", policy.crashed_tick_ms},
+        {"spectator_interval_ms", policy.spectator_interval_ms},
+        {"waiting_ticks", tickStats.waiting_ticks},
+        {"flying_ticks", tickStats.flying_ticks},
+        {"crashed_ticks", tickStats.crashed_ticks}
+    };
+    metrics["sessions"] = {
+        {"active", game.get_player_count()},
+        {"evicted", game.get_evicted_session_count()},
+        {"dormant", game.get_player_store()->size()},
+        {"dormant_file_bytes", game.get_player_store()->file_bytes()}
+    };
+    
+    response.headers().add<Http::Header::ContentType>(MIME(Application, Json));
+    response.send(Http::Code::Ok, metrics.dump());
+}
@@ -0,0 +1,88 @@
+#include "server_config.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+int envInt(const char* name, int defaultValue) {
+    const char* value = std::getenv(name);
+    return value ? std::atoi(value) : defaultValue;
+}
+
+std::string envString(const char* name, const std::string& defaultValue) {
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : defaultValue;
+}
+
+double envDouble(const char* name, double defaultValue) {
+    const char* value = std::getenv(name);
+    return value ? std::atof(value) : defaultValue;
+}
+
+}
+
+ServerConfig ServerConfig::fromEnv() {
+    ServerConfig config;
+    config.port = envInt("CRASH_PORT", config.port);
+    config.http_threads = envInt("CRASH_HTTP_THREADS", config.http_threads);
+    config.max_request_bytes = envInt("CRASH_MAX_REQUEST_BYTES", config.max_request_bytes);
+    
+    config.player_rate_limit.rate_per_sec = envDouble("CRASH_PLAYER_RATE", config.player_rate_limit.rate_per_sec);
+    config.player_rate_limit.burst = envDouble("CRASH_PLAYER_BURST", config.player_rate_limit.burst);
+    config.ip_rate_limit.rate_per_sec = envDouble("CRASH_IP_RATE", config.ip_rate_limit.rate_per_sec);
+    config.ip_rate_limit.burst = envDouble("CRASH_IP_BURST", config.ip_rate_limit.burst);
+    
+    config.dispatcher.workers = envInt("CRASH_WORKERS", static_cast<int>(config.dispatcher.workers));
+    config.dispatcher.command_capacity = envInt("CRASH_COMMAND_QUEUE", static_cast<int>(config.dispatcher.command_capacity));
+    config.dispatcher.read_capacity = envInt("CRASH_READ_QUEUE", static_cast<int>(config.dispatcher.read_capacity));
+    config.dispatcher.read_shed_threshold = envInt("CRASH_READ_SHED_DEPTH", static_cast<int>(config.dispatcher.read_shed_threshold));
+    
+    config.history_path = envString("CRASH_HISTORY_PATH", config.history_path);
+    config.session_ttl_sec = envInt("CRASH_SESSION_TTL_SEC", config.session_ttl_sec);
+    config.player_store_path = envString("CRASH_PLAYER_STORE_PATH", config.player_store_path);
+    config.tick_stream_port = envInt("CRASH_TICK_PORT", config.tick_stream_port);
+    config.websocket_port = envInt("CRASH_WS_PORT", config.websocket_port);
+    
+    config.role = envString("CRASH_ROLE", config.role);
+    config.read_port = envInt("CRASH_READ_PORT", config.read_port);
+    config.shm_name = envString("CRASH_SHM_NAME", config.shm_name);
+    
+    config.static_dir = envString("CRASH_STATIC_DIR", config.static_dir);
+    
+    config.export_queue = envInt("CRASH_EXPORT_QUEUE", config.export_queue);
+    config.import_queue = envInt("CRASH_IMPORT_QUEUE", config.import_queue);
+    
+    config.hash_chain.path = envString("CRASH_CHAIN_PATH", config.hash_chain.path);
+    config.hash_chain.length = static_cast<uint64_t>(
+        std::max(1, envInt("CRASH_CHAIN_LENGTH", static_cast<int>(config.hash_chain.length))));
+    config.hash_chain.salt = envString("CRASH_CHAIN_SALT", config.hash_chain.salt);
+    config.hash_chain.threads = envInt("CRASH_CHAIN_THREADS", config.hash_chain.threads);
+    
+    config.idempotency.slots = envInt("CRASH_IDEMPOTENCY_SLOTS", static_cast<int>(config.idempotency.slots));
+    config.idempotency.ttl_ms = static_cast<int64_t>(envInt("CRASH_IDEMPOTENCY_TTL_SEC",
+        static_cast<int>(config.idempotency.ttl_ms / 1000))) * 1000;
+    
+    config.tick_policy.waiting_tick_ms = envInt("CRASH_TICK_WAITING_MS", config.tick_policy.waiting_tick_ms);
+    config.tick_policy.flying_tick_ms = envInt("CRASH_TICK_FLYING_MS", config.tick_policy.flying_tick_ms);
+    config.tick_policy.crashed_tick_ms = envInt("CRASH_TICK_CRASHED_MS", config.tick_policy.crashed_tick_ms);
+    config.tick_policy.spectator_interval_ms = envInt("CRASH_SPECTATOR_INTERVAL_MS", config.tick_policy.spectator_interval_ms);
+    
+    config.longpoll_timeout_ms = envInt("CRASH_LONGPOLL_TIMEOUT_MS", config.longpoll_timeout_ms);
+    config.longpoll_max_waiters = envInt("CRASH_LONGPOLL_MAX", config.longpoll_max_waiters);
+    
+    config.handoff_socket = envString("CRASH_HANDOFF_SOCKET", config.handoff_socket);
+    config.handoff_drain_ms = envInt("CRASH_HANDOFF_DRAIN_MS", config.handoff_drain_ms);
+    
+    config.journal_path = envString("CRASH_JOURNAL_PATH", config.journal_path);
+    
+    config.trace_events = envInt("CRASH_TRACE_EVENTS", config.trace_events);
+    config.trace_path = envString("CRASH_TRACE_PATH", config.trace_path);
+    
+    config.synthetic.players = envInt("CRASH_SYNTHETIC_PLAYERS", static_cast<int>(config.synthetic.players));
+    config.synthetic.min_bet = money_from_double(envDouble("CRASH_SYNTHETIC_MIN_BET", money_to_double(config.synthetic.min_bet)));
+    config.synthetic.max_bet = money_from_double(envDouble("CRASH_SYNTHETIC_MAX_BET", money_to_double(config.synthetic.max_bet)));
+    config.synthetic.bet_probability = envDouble("CRASH_SYNTHETIC_BET_PROBABILITY", config.synthetic.bet_probability);
+    config.synthetic.cashout_mean = envDouble("CRASH_SYNTHETIC_CASHOUT_MEAN", config.synthetic.cashout_mean);
+    
+    return config;
+}
@@ -0,0 +1,125 @@
+#include "settlement_export.h"
+#include "bet.h"
+#include "money.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+void append_string(std::string& out, std::string_view value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+}  // namespace
+
+SettlementExporter::SettlementExporter(const BetHistoryStore& history, const ExportRange& export_range,
+                                       size_t chunk_size, size_t batch_records)
+    : store(history),
+      range(export_range),
+      chunk_bytes(chunk_size),
+      records(batch_records > 0 ? batch_records : 1),
+      segment_index(history.find_segment(export_range.from_ms)),
+      next_record(0),
+      segment_end(0),
+      rows(0),
+      finished(false),
+      complete(false) {}
+
+bool SettlementExporter::advance_segment() {
+    RoundSegment segment;
+    while (store.get_segment(segment_index, segment)) {
+        // Segmentler zamana göre sıralı: aralığın sonu geçildiyse gerisine bakılmaz
+        if (segment.settled_at_ms >= range.to_ms) return false;
+        segment_index++;
+        if (segment.round < range.from_round || segment.round > range.to_round) continue;
+        next_record = segment.first;
+        segment_end = segment.first + segment.count;
+        return true;
+    }
+    return false;
+}
+
+bool SettlementExporter::next_chunk(std::string& out) {
+    out.clear();
+    while (!finished && out.size() < chunk_bytes) {
+        if (next_record == segment_end && !advance_segment()) {
+            finished = true;
+            complete = true;
+            break;
+        }
+        size_t wanted = static_cast<size_t>(std::min<uint64_t>(records.size(), segment_end - next_record));
+        size_t count = store.read_records(next_record, wanted, records.data());
+        if (count == 0) {
+            // Dosya okunamadı: yarım kalan segment atlanmaz, dışa aktarım burada biter
+            finished = true;
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            std::string_view player_id;
+            std::string_view player_name;
+            store.get_player(records[i].player, player_id, player_name);
+            append_record(out, records[i], player_id, player_name);
+        }
+        next_record += count;
+        rows += count;
+    }
+    return !out.empty();
+}
+
+uint64_t SettlementExporter::get_rows() const {
+    return rows;
+}
+
+bool SettlementExporter::is_complete() const {
+    return complete;
+}
+
+void SettlementExporter::append_trailer(std::string& out, bool complete, uint64_t rows, std::string_view error) {
+    out += complete ? "{\"export\":\"complete\"" : "{\"export\":\"incomplete\"";
+    out += ",\"rows\":";
+    out += std::to_string(rows);
+    if (!complete) {
+        out += ",\"error\":";
+        append_string(out, error);
+    }
+    out += "}\n";
+}
+
+void SettlementExporter::append_record(std::string& out, const BetRecord& record,
+                                       std::string_view player_id, std::string_view player_name) {
+    bool cashed_out = record.status == static_cast<uint8_t>(BetStatus::CASHED_OUT);
+    out += "{\"round\":";
+    out += std::to_string(record.round);
+    out += ",\"settled_at\":";
+    out += std::to_string(record.settled_at_ms);
+    out += ",\"player_id\":";
+    append_string(out, player_id);
+    out += ",\"player_name\":";
+    append_string(out, player_name);
+    out += ",\"amount\":";
+    out += money_to_string(record.amount);
+    out += ",\"status\":\"";
+    out += cashed_out ? "cashed_out" : "crashed";
+    // Kaybedilen bahiste çarpan 0 (oyuncu bahis geçmişi ile aynı alanlar)
+    char multiplier[24];
+    std::snprintf(multiplier, sizeof(multiplier), "%u.%02u",
+                  record.multiplier_x100 / 100, record.multiplier_x100 % 100);
+    out += "\",\"cashout_multiplier\":";
+    out += multiplier;
+    out += ",\"winnings\":";
+    out += money_to_string(record.payout);
+    out += "}\n";
+}
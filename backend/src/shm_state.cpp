@@ -0,0 +1,124 @@
+#include "shm_state.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+ShmStatePublisher::ShmStatePublisher(const std::string& shm_name) : name(shm_name), layout(nullptr) {
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Paylaşılan bellek açılamadı (" + name + "): " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, sizeof(ShmStateLayout)) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Paylaşılan bellek boyutlandırılamadı: " + error);
+    }
+    void* memory = ::mmap(nullptr, sizeof(ShmStateLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("Paylaşılan bellek map edilemedi: " + std::string(std::strerror(errno)));
+    }
+    
+    // Önceki bir çalışmadan kalan segment olabilir: sıfırdan kur
+    layout = new (memory) ShmStateLayout();
+    layout->magic = ShmStateLayout::MAGIC;
+    layout->layout_version = ShmStateLayout::LAYOUT_VERSION;
+    layout->sequence.store(0, std::memory_order_release);
+}
+
+ShmStatePublisher::~ShmStatePublisher() {
+    if (layout) {
+        ::munmap(layout, sizeof(ShmStateLayout));
+        ::shm_unlink(name.c_str());
+    }
+}
+
+void ShmStatePublisher::release() {
+    if (layout) {
+        ::munmap(layout, sizeof(ShmStateLayout));
+        layout = nullptr;
+    }
+}
+
+void ShmStatePublisher::publish(const GameSnapshot& snapshot) {
+    uint64_t words[ShmStateLayout::WORDS];
+    std::memcpy(words, &snapshot, sizeof(words));
+    
+    // Seqlock: tek sayı = yazım sürüyor; okuyucu aynı çift sayıyı iki kez görmezse tekrar dener
+    uint64_t sequence = layout->sequence.load(std::memory_order_relaxed);
+    layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Kelimeler release ile yazılır: yeni bir kelimeyi gören okuyucu tek sayıyı da görür.
+    // Fence yerine: ThreadSanitizer fence'leri modellemez (-Wtsan)
+    for (size_t i = 0; i < ShmStateLayout::WORDS; i++) {
+        layout->words[i].store(words[i], std::memory_order_release);
+    }
+    layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+ShmStateReader::ShmStateReader(const std::string& shm_name) : name(shm_name), layout(nullptr) {
+    attach();
+}
+
+ShmStateReader::~ShmStateReader() {
+    detach();
+}
+
+void ShmStateReader::detach() {
+    if (layout) {
+        ::munmap(const_cast<ShmStateLayout*>(layout), sizeof(ShmStateLayout));
+        layout = nullptr;
+    }
+}
+
+bool ShmStateReader::reattach() {
+    detach();
+    return attach();
+}
+
+bool ShmStateReader::attach() {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    if (::fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(ShmStateLayout)) {
+        ::close(fd);
+        return false;
+    }
+    void* memory = ::mmap(nullptr, sizeof(ShmStateLayout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) return false;
+    
+    layout = static_cast<const ShmStateLayout*>(memory);
+    if (layout->magic != ShmStateLayout::MAGIC || layout->layout_version != ShmStateLayout::LAYOUT_VERSION) {
+        ::munmap(memory, sizeof(ShmStateLayout));
+        layout = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool ShmStateReader::read(GameSnapshot& out) {
+    // Primary replica'dan sonra başlamış olabilir: her okumada tekrar bağlanmayı dene
+    if (!layout && !attach()) return false;
+    
+    uint64_t words[ShmStateLayout::WORDS];
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        uint64_t before = layout->sequence.load(std::memory_order_acquire);
+        if (before == 0) return false;
+        if (before & 1) continue;  // Yazım ortasında
+        
+        for (size_t i = 0; i < ShmStateLayout::WORDS; i++) {
+            words[i] = layout->words[i].load(std::memory_order_acquire);
+        }
+        if (layout->sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&out, words, sizeof(out));
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,141 @@
+#include "static_assets.h"
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string content_etag(const std::string& content) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    char text[24];
+    std::snprintf(text, sizeof(text), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+bool compressible(const std::string& content_type) {
+    return content_type.compare(0, 5, "text/") == 0 || content_type == "application/javascript" ||
+           content_type == "application/json" || content_type == "image/svg+xml";
+}
+
+}  // namespace
+
+StaticAssets::StaticAssets() : index(nullptr), bytes(0) {
+}
+
+size_t StaticAssets::load(const std::string& root) {
+    if (!fs::is_directory(root)) {
+        throw std::runtime_error("Statik dosya dizini bulunamadı: " + root);
+    }
+    
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.good() && !in.eof()) {
+            throw std::runtime_error("Statik dosya okunamadı: " + entry.path().string());
+        }
+        
+        std::string url = "/" + fs::relative(entry.path(), root).generic_string();
+        std::string filename = entry.path().filename().string();
+        
+        auto response = std::make_shared<CachedResponse>();
+        response->etag = content_etag(content);
+        response->body = std::move(content);
+        
+        StaticAsset asset;
+        asset.content_type = content_type_for(url);
+        if (filename == "index.html") {
+            asset.cache_control = "no-cache";
+        } else if (is_fingerprinted(filename)) {
+            asset.cache_control = "public, max-age=31536000, immutable";
+        } else {
+            asset.cache_control = "public, max-age=3600";
+        }
+        // Sıkıştırılmış halleri şimdi üret: istek yolunda zlib çalışmasın
+        if (compressible(asset.content_type)) {
+            response->encoded_body(ContentCoding::GZIP);
+            response->encoded_body(ContentCoding::DEFLATE);
+        }
+        bytes += response->body.size();
+        asset.response = std::move(response);
+        assets[url] = std::move(asset);
+    }
+    
+    auto it = assets.find("/index.html");
+    index = it != assets.end() ? &it->second : nullptr;
+    return assets.size();
+}
+
+const StaticAsset* StaticAssets::find(std::string_view path) const {
+    if (path.empty() || path == "/") return index;
+    // Dosyalar bellekte olduğundan dışarı çıkılamaz ama "/../" yollarına index.html de verilmez
+    if (path.find("..") != std::string_view::npos) return nullptr;
+    
+    auto it = assets.find(std::string(path));
+    if (it != assets.end()) return &it->second;
+    
+    // İstemci tarafı route'lar (/game, /profile/...) index.html alır; eksik dosyalar 404
+    std::string_view last = path.substr(path.rfind('/') + 1);
+    return last.find('.') == std::string_view::npos ? index : nullptr;
+}
+
+size_t StaticAssets::size() const {
+    return assets.size();
+}
+
+size_t StaticAssets::total_bytes() const {
+    return bytes;
+}
+
+std::string StaticAssets::content_type_for(std::string_view path) {
+    static const std::unordered_map<std::string, std::string> types = {
+        {"html", "text/html; charset=utf-8"},
+        {"js", "application/javascript"},
+        {"css", "text/css"},
+        {"json", "application/json"},
+        {"map", "application/json"},
+        {"txt", "text/plain; charset=utf-8"},
+        {"svg", "image/svg+xml"},
+        {"png", "image/png"},
+        {"jpg", "image/jpeg"},
+        {"jpeg", "image/jpeg"},
+        {"gif", "image/gif"},
+        {"webp", "image/webp"},
+        {"ico", "image/x-icon"},
+        {"woff2", "font/woff2"},
+    };
+    size_t dot = path.rfind('.');
+    if (dot != std::string_view::npos) {
+        std::string extension(path.substr(dot + 1));
+        for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        auto it = types.find(extension);
+        if (it != types.end()) return it->second;
+    }
+    return "application/octet-stream";
+}
+
+bool StaticAssets::is_fingerprinted(std::string_view filename) {
+    // Webpack [contenthash]: "bundle.3f9a2c1d4e5b.js", "plane.8c1e2f3a.png"
+    size_t start = filename.find('.');
+    while (start != std::string_view::npos) {
+        size_t end = filename.find('.', start + 1);
+        if (end == std::string_view::npos) return false;
+        size_t length = end - start - 1;
+        bool hex = length >= 8;
+        for (size_t i = start + 1; hex && i < end; i++) {
+            hex = std::isxdigit(static_cast<unsigned char>(filename[i])) != 0;
+        }
+        if (hex) return true;
+        start = end;
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#include "string_arena.h"
+#include <algorithm>
+#include <cstring>
+
+StringArena::StringArena(size_t block_bytes) : block_size(block_bytes), current_block(0), offset(0) {
+}
+
+std::string_view StringArena::store(std::string_view value) {
+    if (value.empty()) return std::string_view();
+    
+    // Mevcut blokta yer yoksa sıradaki (daha önce ayrılmış) bloğa geç
+    while (current_block < blocks.size() && offset + value.size() > block_sizes[current_block]) {
+        current_block++;
+        offset = 0;
+    }
+    if (current_block == blocks.size()) {
+        size_t size = std::max(block_size, value.size());
+        blocks.emplace_back(new char[size]);
+        block_sizes.push_back(size);
+        offset = 0;
+    }
+    
+    char* destination = blocks[current_block].get() + offset;
+    std::memcpy(destination, value.data(), value.size());
+    offset += value.size();
+    return std::string_view(destination, value.size());
+}
+
+void StringArena::reset() {
+    current_block = 0;
+    offset = 0;
+}
+
+size_t StringArena::block_count() const {
+    return blocks.size();
+}
+
+size_t StringArena::bytes_reserved() const {
+    size_t total = 0;
+    for (size_t size : block_sizes) total += size;
+    return total;
+}
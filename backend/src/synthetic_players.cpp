@@ -0,0 +1,105 @@
+#include "synthetic_players.h"
+#include "game.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SyntheticPlayers::SyntheticPlayers(const SyntheticConfig& synthetic_config)
+    : config(synthetic_config), rng(synthetic_config.seed), current_round(-1), next_to_bet(0),
+      next_bucket(0) {
+    config.min_bet = std::max<Money>(1, config.min_bet);
+    config.max_bet = std::max(config.min_bet, config.max_bet);
+    config.max_cashout = std::max(1.01, config.max_cashout);
+    cashout_buckets.resize(multiplier_to_x100(config.max_cashout) + 1);
+}
+
+void SyntheticPlayers::attach(CrashGame& game) {
+    game.set_action_logging(false);
+    player_ids.reserve(config.players);
+    for (size_t i = 0; i < config.players; i++) {
+        player_ids.push_back("bot-" + std::to_string(i));
+        game.add_player(player_ids.back(), "Bot " + std::to_string(i));
+    }
+    std::cout << "🤖 " << config.players << " sentetik oyuncu eklendi" << std::endl;
+}
+
+void SyntheticPlayers::on_tick(CrashGame& game) {
+    if (player_ids.empty()) return;
+    TRACE_SPAN("synthetic.tick");
+    
+    if (game.get_current_round() != current_round) {
+        start_round(game.get_current_round());
+    }
+    
+    switch (game.get_phase()) {
+        case GamePhase::WAITING: {
+            // Kalan bahisleri kalan tick'lere böl; son tick'e yığılmasın diye bir tick pay bırak
+            size_t remaining = player_ids.size() - next_to_bet;
+            size_t ticks_left = static_cast<size_t>(std::max(1, game.get_remaining_time_ms() / config.tick_ms - 1));
+            place_bets(game, remaining / ticks_left + 1);
+            break;
+        }
+        case GamePhase::FLYING:
+            cash_out(game, multiplier_to_x100(game.get_current_multiplier()));
+            break;
+        case GamePhase::CRASHED:
+            break;
+    }
+}
+
+void SyntheticPlayers::start_round(int round) {
+    current_round = round;
+    next_to_bet = 0;
+    next_bucket = 0;
+    for (auto& bucket : cashout_buckets) bucket.clear();
+    rounds++;
+}
+
+void SyntheticPlayers::place_bets(CrashGame& game, size_t budget) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    size_t end = std::min(player_ids.size(), next_to_bet + budget);
+    
+    for (; next_to_bet < end; next_to_bet++) {
+        if (config.bet_probability < 1.0 && coin(rng) >= config.bet_probability) continue;
+        
+        const std::string& player_id = player_ids[next_to_bet];
+        Money amount = sample_bet();
+        if (!game.place_bet(player_id, amount)) {
+            // Bakiye bitti (veya oturum silindi): yeniden doldur ve tekrar dene
+            if (!game.load_balance(player_id, 1000 * config.max_bet)) {
+                game.add_player(player_id, "Bot " + player_id.substr(4));
+            }
+            if (!game.place_bet(player_id, amount)) continue;
+        }
+        bets_placed++;
+        cashout_buckets[sample_cashout_x100()].push_back(static_cast<uint32_t>(next_to_bet));
+    }
+}
+
+void SyntheticPlayers::cash_out(CrashGame& game, uint32_t multiplier_x100) {
+    size_t last = std::min<size_t>(multiplier_x100, cashout_buckets.size() - 1);
+    for (; next_bucket <= last; next_bucket++) {
+        for (uint32_t index : cashout_buckets[next_bucket]) {
+            if (game.cashout(player_ids[index])) cashouts++;
+        }
+    }
+}
+
+Money SyntheticPlayers::sample_bet() {
+    if (config.min_bet == config.max_bet) return config.min_bet;
+    // Log-uniform: küçük bahisler çok, büyük bahisler az
+    std::uniform_real_distribution<double> dist(std::log(static_cast<double>(config.min_bet)),
+                                                std::log(static_cast<double>(config.max_bet)));
+    return static_cast<Money>(std::llround(std::exp(dist(rng))));
+}
+
+uint32_t SyntheticPlayers::sample_cashout_x100() {
+    std::exponential_distribution<double> dist(1.0 / std::max(0.01, config.cashout_mean - 1.01));
+    double target = std::min(config.max_cashout, 1.01 + dist(rng));
+    return multiplier_to_x100(target);
+}
+
+SyntheticStats SyntheticPlayers::get_stats() const {
+    return SyntheticStats{player_ids.size(), rounds.load(), bets_placed.load(), cashouts.load()};
+}
@@ -0,0 +1,38 @@
+#include "tick_policy.h"
+#include "game.h"
+#include <algorithm>
+
+TickPolicy::TickPolicy(const TickPolicyConfig& policy_config) : config(policy_config) {
+    config.waiting_tick_ms = std::max(1, config.waiting_tick_ms);
+    config.flying_tick_ms = std::max(1, config.flying_tick_ms);
+    config.crashed_tick_ms = std::max(1, config.crashed_tick_ms);
+    config.spectator_interval_ms = std::max(0, config.spectator_interval_ms);
+}
+
+int TickPolicy::next_tick_ms(GamePhase phase, int remaining_time_ms) {
+    switch (phase) {
+        case GamePhase::WAITING:
+            waiting_ticks++;
+            return std::max(1, std::min(config.waiting_tick_ms, remaining_time_ms));
+        case GamePhase::FLYING:
+            flying_ticks++;
+            return config.flying_tick_ms;
+        case GamePhase::CRASHED:
+            crashed_ticks++;
+            return std::max(1, std::min(config.crashed_tick_ms, remaining_time_ms));
+    }
+    return config.flying_tick_ms;
+}
+
+int64_t TickPolicy::spectator_cutoff_ms(GamePhase phase, int64_t now_ms) const {
+    // Diğer fazlarda tick zaten seyrek; izleyiciler bahisçilerle aynı anda cevaplanır
+    return phase == GamePhase::FLYING ? now_ms - config.spectator_interval_ms : now_ms;
+}
+
+const TickPolicyConfig& TickPolicy::get_config() const {
+    return config;
+}
+
+TickPolicyStats TickPolicy::get_stats() const {
+    return TickPolicyStats{waiting_ticks.load(), flying_ticks.load(), crashed_ticks.load()};
+}
@@ -0,0 +1,212 @@
+#include "tick_stream.h"
+#include "trace.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+TickStream::TickStream() : listen_fd(-1), epoll_fd(-1), wake_fd(-1), reserve_fd(-1), listener_paused(false), port(0) {
+}
+
+TickStream::~TickStream() {
+    stop();
+}
+
+void TickStream::start(uint16_t listen_port) {
+    listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        throw std::runtime_error("Tick stream soketi açılamadı: " + std::string(std::strerror(errno)));
+    }
+    int one = 1;
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    // Primary ve replica'lar aynı portu paylaşır; çekirdek bağlantıları dağıtır
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(listen_port);
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listen_fd, 128) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(listen_fd);
+        listen_fd = -1;
+        throw std::runtime_error("Tick stream portu dinlenemiyor (" + std::to_string(listen_port) + "): " + error);
+    }
+    
+    start_on(listen_fd);
+}
+
+void TickStream::start_on(int listening_fd) {
+    listen_fd = listening_fd;
+    // Devralınan soket bloklayan modda olabilir; accept döngüsü EAGAIN'e güvenir
+    ::fcntl(listen_fd, F_SETFL, ::fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+    
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+    
+    epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    listener_paused = false;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    ev.data.fd = wake_fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+    
+    loop_thread = std::thread(&TickStream::event_loop, this);
+}
+
+void TickStream::stop() {
+    if (loop_thread.joinable()) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_fd, &one, sizeof(one));
+        (void)ignored;
+        loop_thread.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(clients_mutex);
+    for (int fd : clients) ::close(fd);
+    clients.clear();
+    for (int* fd : {&listen_fd, &epoll_fd, &wake_fd, &reserve_fd}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+}
+
+void TickStream::event_loop() {
+    trace::set_thread_name("tick-stream");
+    epoll_event events[64];
+    char discard[1024];
+    
+    while (true) {
+        int n = ::epoll_wait(epoll_fd, events, 64, listener_paused ? 1000 : -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "❌ Tick stream epoll hatası: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        if (listener_paused) {
+            // Bekleme bitti (veya bir istemci kapandı): yedek fd'yi yeniden dene, dinleyiciyi geri ekle
+            if (reserve_fd < 0) reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = listen_fd;
+            ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+            listener_paused = false;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd) return;
+            if (fd == listen_fd) {
+                accept_clients();
+                continue;
+            }
+            
+            bool closed = (events[i].events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) != 0;
+            if (!closed) {
+                // Tek yönlü protokol: gelen veriyi at, sadece kapanışı tespit et
+                ssize_t received = ::recv(fd, discard, sizeof(discard), MSG_DONTWAIT);
+                closed = received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+            }
+            if (closed) remove_client(fd);
+        }
+    }
+}
+
+void TickStream::accept_clients() {
+    while (true) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN: kuyruk boşaldı. fd sınırında bağlantı kuyrukta kalırsa level-triggered
+            // epoll hemen tekrar uyanır ve thread boşa döner: bağlantı kabul edilip kapatılır
+            if ((errno == EMFILE || errno == ENFILE) && shed_connection()) continue;
+            return;
+        }
+        
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        clients.push_back(fd);
+        connections++;
+        if (!last_frame.empty()) {
+            ssize_t ignored = ::send(fd, last_frame.data(), last_frame.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            (void)ignored;
+        }
+    }
+}
+
+bool TickStream::shed_connection() {
+    if (reserve_fd >= 0) {
+        ::close(reserve_fd);
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        bool exhausted = fd < 0 && (errno == EMFILE || errno == ENFILE);
+        if (fd >= 0) {
+            refused++;
+            ::close(fd);
+        }
+        reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (reserve_fd >= 0 && !exhausted) return fd >= 0;  // fd < 0: kuyruk boşaldı
+    }
+    // Yedek fd de yok (başka bir thread kaptı) veya sistem geneli sınır: dinleyici bir süre epoll dışında
+    std::cerr << "❌ Tick stream fd sınırında, yeni bağlantılar 1 sn bekletiliyor" << std::endl;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, listen_fd, nullptr);
+    listener_paused = true;
+    return false;
+}
+
+void TickStream::remove_client(int fd) {
+    std::lock_guard<std::mutex> lock(clients_mutex);
+    auto it = std::find(clients.begin(), clients.end(), fd);
+    if (it == clients.end()) return;
+    clients.erase(it);
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+}
+
+void TickStream::publish(const uint8_t* frame, size_t size) {
+    std::lock_guard<std::mutex> lock(clients_mutex);
+    last_frame.assign(reinterpret_cast<const char*>(frame), size);
+    
+    for (int fd : clients) {
+        ssize_t sent = ::send(fd, frame, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent == static_cast<ssize_t>(size)) {
+            frames_sent++;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            frames_dropped++;
+        } else {
+            // Yarım yazılan çerçeve akışı bozar: bağlantıyı kapat, loop thread temizler
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    }
+}
+
+int TickStream::get_listen_fd() const {
+    return listen_fd;
+}
+
+uint16_t TickStream::get_port() const {
+    return port;
+}
+
+TickStreamStats TickStream::get_stats() {
+    std::lock_guard<std::mutex> lock(clients_mutex);
+    return TickStreamStats{clients.size(), connections.load(), frames_sent.load(), frames_dropped.load(), refused.load()};
+}
@@ -0,0 +1,183 @@
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+
+namespace detail {
+std::atomic<size_t> capacity{0};
+}
+
+namespace {
+
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> begin_ns{0};
+    std::atomic<int64_t> end_ns{0};
+};
+
+// Tek yazıcı (sahibi olan thread), dökümde çok okuyucu
+struct ThreadBuffer {
+    size_t mask;
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint64_t> head{0};  // Yazılan toplam olay
+    uint32_t tid;
+    std::string name;
+
+    ThreadBuffer(size_t size, uint32_t thread_id)
+        : mask(size - 1), events(new Event[size]), tid(thread_id) {}
+};
+
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+std::atomic<bool> dump_requested{false};
+
+thread_local ThreadBuffer* local_buffer = nullptr;
+thread_local const char* pending_name = nullptr;
+
+ThreadBuffer* buffer_for_thread() {
+    if (local_buffer) return local_buffer;
+    size_t size = detail::capacity.load(std::memory_order_relaxed);
+    if (size == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto buffer = std::make_shared<ThreadBuffer>(size, static_cast<uint32_t>(registry.size() + 1));
+    buffer->name = pending_name ? pending_name : "thread-" + std::to_string(buffer->tid);
+    registry.push_back(buffer);
+    local_buffer = buffer.get();  // Registry buffer'ı process sonuna kadar tutar
+    return local_buffer;
+}
+
+void append_escaped(std::string& out, const char* value) {
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+void append_micros(std::string& out, int64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%lld.%03lld",
+                  static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+    out += text;
+}
+
+}  // namespace
+
+void configure(size_t events_per_thread) {
+    size_t size = 0;
+    if (events_per_thread > 0) {
+        size = 1;
+        while (size < events_per_thread) size <<= 1;
+    }
+    detail::capacity.store(size, std::memory_order_relaxed);
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char* name, int64_t begin_ns, int64_t end_ns) {
+    ThreadBuffer* buffer = buffer_for_thread();
+    if (!buffer) return;
+
+    uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[index & buffer->mask];
+    // Slot, index - size'daki olayın üzerine yazılacak. Alanlar release ile yazılır: yeni
+    // alanlardan birini (acquire ile) gören okuyucu önceki head yazısını, yani head >= index'i
+    // görür ve eski olayı atar. Relaxed yazıda zayıf sıralı CPU'larda (ARM, POWER) slot yazısı
+    // önceki head yazısından önce görünebilir ve karışık olay dökülür. Fence yerine tek tek
+    // release/acquire: ThreadSanitizer fence'leri modellemez (-Wtsan), x86'da maliyeti yok
+    event.name.store(name, std::memory_order_release);
+    event.begin_ns.store(begin_ns, std::memory_order_release);
+    event.end_ns.store(end_ns, std::memory_order_release);
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void set_thread_name(const char* name) {
+    pending_name = name;
+    if (local_buffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        local_buffer->name = name;
+    }
+}
+
+std::string dump_json() {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffers = registry;
+    }
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out += ',';
+        first = false;
+    };
+
+    for (const auto& buffer : buffers) {
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            name = buffer->name;
+        }
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(buffer->tid) +
+               ",\"args\":{\"name\":\"";
+        append_escaped(out, name.c_str());
+        out += "\"}}";
+
+        size_t size = buffer->mask + 1;
+        uint64_t end = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = end > size ? end - size : 0;
+        struct Copy {
+            const char* name;
+            int64_t begin_ns;
+            int64_t end_ns;
+        };
+        std::vector<Copy> copies;
+        copies.reserve(static_cast<size_t>(end - begin));
+        for (uint64_t i = begin; i < end; i++) {
+            const Event& event = buffer->events[i & buffer->mask];
+            copies.push_back(Copy{event.name.load(std::memory_order_acquire),
+                                  event.begin_ns.load(std::memory_order_acquire),
+                                  event.end_ns.load(std::memory_order_acquire)});
+        }
+        // Kopyalarken yazıcı ilerlediyse üzerine yazılmış olabilecek baştaki olayları at.
+        // record'daki release yazılarla eşleşir: kopyada yeni yazılmış bir alan varsa aşağıdaki
+        // head okuması o yazıdan önceki head'i görür (seqlock okuyucusu)
+        uint64_t after = buffer->head.load(std::memory_order_relaxed);
+        uint64_t valid_from = after >= size ? after - size + 1 : 0;
+
+        for (uint64_t i = begin; i < end; i++) {
+            if (i < valid_from) continue;
+            const Copy& event = copies[static_cast<size_t>(i - begin)];
+            if (!event.name) continue;
+            separator();
+            out += "{\"name\":\"";
+            append_escaped(out, event.name);
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(buffer->tid) + ",\"ts\":";
+            append_micros(out, event.begin_ns);
+            out += ",\"dur\":";
+            append_micros(out, event.end_ns - event.begin_ns);
+            out += '}';
+        }
+    }
+    out += "],\"displayTimeUnit\":\"ms\"}";
+    return out;
+}
+
+void request_dump() {
+    dump_requested.store(true, std::memory_order_relaxed);
+}
+
+bool take_dump_request() {
+    return dump_requested.exchange(false, std::memory_order_relaxed);
+}
+
+}  // namespace trace
@@ -0,0 +1,615 @@
+#include "websocket_gateway.h"
+#include "trace.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace websocket {
+
+namespace {
+
+constexpr const char* GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+std::string to_lower(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool url_decode(std::string_view text, std::string& out) {
+    out.clear();
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            out.push_back(' ');
+        } else if (text[i] == '%') {
+            if (i + 2 >= text.size()) return false;
+            int high = hex_value(text[i + 1]);
+            int low = hex_value(text[i + 2]);
+            if (high < 0 || low < 0) return false;
+            out.push_back(static_cast<char>(high * 16 + low));
+            i += 2;
+        } else {
+            out.push_back(text[i]);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+std::string accept_key(std::string_view client_key) {
+    std::string input(client_key);
+    input += GUID;
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+    unsigned char encoded[4 * ((SHA_DIGEST_LENGTH + 2) / 3) + 1];
+    int length = EVP_EncodeBlock(encoded, digest, SHA_DIGEST_LENGTH);
+    return std::string(reinterpret_cast<const char*>(encoded), static_cast<size_t>(length));
+}
+
+bool parse_handshake(std::string_view request, Handshake& handshake) {
+    size_t line_end = request.find("\r\n");
+    if (line_end == std::string_view::npos) return false;
+    std::string_view request_line = request.substr(0, line_end);
+    if (request_line.substr(0, 4) != "GET ") return false;
+    size_t target_end = request_line.find(' ', 4);
+    if (target_end == std::string_view::npos || request_line.substr(target_end + 1, 5) != "HTTP/") return false;
+    std::string_view target = request_line.substr(4, target_end - 4);
+
+    // Oturum oyuncusu: /ws?player_id=<id>
+    size_t query_start = target.find('?');
+    if (target.substr(0, query_start) != "/ws") return false;
+    handshake.player_id.clear();
+    std::string_view query = query_start == std::string_view::npos ? std::string_view() : target.substr(query_start + 1);
+    while (!query.empty()) {
+        size_t amp = query.find('&');
+        std::string_view param = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view() : query.substr(amp + 1);
+        if (param.substr(0, 10) == "player_id=" && !url_decode(param.substr(10), handshake.player_id)) return false;
+    }
+    if (handshake.player_id.empty() || handshake.player_id.size() > tick_protocol::MAX_PLAYER_ID) return false;
+
+    bool upgrade = false;
+    bool connection = false;
+    bool version = false;
+    handshake.key.clear();
+    std::string_view headers = request.substr(line_end + 2);
+    while (!headers.empty()) {
+        size_t end = headers.find("\r\n");
+        std::string_view line = headers.substr(0, end);
+        headers = end == std::string_view::npos ? std::string_view() : headers.substr(end + 2);
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string name = to_lower(trim(line.substr(0, colon)));
+        std::string_view value = trim(line.substr(colon + 1));
+        if (name == "upgrade") {
+            upgrade = to_lower(value).find("websocket") != std::string::npos;
+        } else if (name == "connection") {
+            connection = to_lower(value).find("upgrade") != std::string::npos;
+        } else if (name == "sec-websocket-version") {
+            version = value == "13";
+        } else if (name == "sec-websocket-key") {
+            handshake.key = std::string(value);
+        }
+    }
+    return upgrade && connection && version && !handshake.key.empty();
+}
+
+std::string handshake_response(std::string_view client_key) {
+    return "HTTP/1.1 101 Switching Protocols\r\n"
+           "Upgrade: websocket\r\n"
+           "Connection: Upgrade\r\n"
+           "Sec-WebSocket-Accept: " + accept_key(client_key) + "\r\n\r\n";
+}
+
+size_t encode_frame(Opcode opcode, const uint8_t* payload, size_t size, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(0x80 | static_cast<uint8_t>(opcode));
+    size_t header;
+    if (size < 126) {
+        out[1] = static_cast<uint8_t>(size);
+        header = 2;
+    } else if (size <= 0xFFFF) {
+        out[1] = 126;
+        out[2] = static_cast<uint8_t>(size >> 8);
+        out[3] = static_cast<uint8_t>(size);
+        header = 4;
+    } else {
+        out[1] = 127;
+        for (int i = 0; i < 8; i++) out[2 + i] = static_cast<uint8_t>(static_cast<uint64_t>(size) >> (8 * (7 - i)));
+        header = 10;
+    }
+    if (size > 0) std::memcpy(out + header, payload, size);
+    return header + size;
+}
+
+std::string encode_frame(Opcode opcode, std::string_view payload) {
+    std::string out(payload.size() + MAX_FRAME_HEADER, '\0');
+    out.resize(encode_frame(opcode, reinterpret_cast<const uint8_t*>(payload.data()), payload.size(),
+                            reinterpret_cast<uint8_t*>(&out[0])));
+    return out;
+}
+
+std::string encode_close(uint16_t code) {
+    const char payload[2] = {static_cast<char>(code >> 8), static_cast<char>(code & 0xFF)};
+    return encode_frame(Opcode::CLOSE, std::string_view(payload, sizeof(payload)));
+}
+
+long decode_frame(const uint8_t* in, size_t size, Frame& frame, size_t max_payload) {
+    if (size < 2) return 0;
+    if (in[0] & 0x70) return -CLOSE_PROTOCOL_ERROR;  // Uzantı müzakere edilmedi: RSV bitleri 0 olmalı
+    uint8_t opcode = in[0] & 0x0F;
+    bool control = (opcode & 0x08) != 0;
+    if ((opcode > 0x2 && !control) || opcode > 0xA) return -CLOSE_PROTOCOL_ERROR;
+    if (!(in[1] & 0x80)) return -CLOSE_PROTOCOL_ERROR;  // İstemci çerçeveleri maskeli olmalı
+    frame.fin = (in[0] & 0x80) != 0;
+    frame.opcode = static_cast<Opcode>(opcode);
+
+    uint64_t length = in[1] & 0x7F;
+    size_t header = 2;
+    if (length == 126) {
+        if (size < 4) return 0;
+        length = (static_cast<uint64_t>(in[2]) << 8) | in[3];
+        header = 4;
+    } else if (length == 127) {
+        if (size < 10) return 0;
+        length = 0;
+        for (int i = 0; i < 8; i++) length = (length << 8) | in[2 + i];
+        header = 10;
+    }
+    if (control && (!frame.fin || length > 125)) return -CLOSE_PROTOCOL_ERROR;
+    if (length > max_payload) return -CLOSE_TOO_BIG;
+
+    const uint8_t* mask = in + header;
+    header += 4;
+    if (size < header + length) return 0;
+    frame.payload.resize(static_cast<size_t>(length));
+    for (size_t i = 0; i < length; i++) {
+        frame.payload[i] = static_cast<char>(in[header + i] ^ mask[i & 3]);
+    }
+    return static_cast<long>(header + length);
+}
+
+}  // namespace websocket
+
+namespace {
+
+int64_t steady_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+WebSocketGateway::WebSocketGateway()
+    : listen_fd(-1), epoll_fd(-1), wake_fd(-1), reserve_fd(-1), listener_paused(false), port(0),
+      upgraded_count(0), last_phase(0xFF) {
+}
+
+WebSocketGateway::~WebSocketGateway() {
+    stop();
+}
+
+void WebSocketGateway::set_handlers(WebSocketHandlers session_handlers) {
+    handlers = std::move(session_handlers);
+}
+
+void WebSocketGateway::start(uint16_t listen_port) {
+    listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        throw std::runtime_error("WebSocket soketi açılamadı: " + std::string(std::strerror(errno)));
+    }
+    int one = 1;
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(listen_port);
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listen_fd, 128) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(listen_fd);
+        listen_fd = -1;
+        throw std::runtime_error("WebSocket portu dinlenemiyor (" + std::to_string(listen_port) + "): " + error);
+    }
+
+    start_on(listen_fd);
+}
+
+void WebSocketGateway::start_on(int listening_fd) {
+    listen_fd = listening_fd;
+    ::fcntl(listen_fd, F_SETFL, ::fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+
+    epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    listener_paused = false;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    ev.data.fd = wake_fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+
+    loop_thread = std::thread(&WebSocketGateway::event_loop, this);
+}
+
+void WebSocketGateway::stop() {
+    if (loop_thread.joinable()) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_fd, &one, sizeof(one));
+        (void)ignored;
+        loop_thread.join();
+    }
+
+    // İstemciler kapanış kodunu görür ve yeniden bağlanır (devirde ardıl sürece)
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    const std::string going_away = websocket::encode_close(websocket::CLOSE_GOING_AWAY);
+    for (const auto& [fd, session] : sessions) {
+        if (session.upgraded) send_locked(fd, going_away.data(), going_away.size());
+        ::close(fd);
+    }
+    sessions.clear();
+    upgraded_count = 0;
+    for (int* fd : {&listen_fd, &epoll_fd, &wake_fd, &reserve_fd}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+}
+
+void WebSocketGateway::event_loop() {
+    trace::set_thread_name("websocket");
+    epoll_event events[64];
+    int64_t last_expire_ms = steady_ms();
+
+    while (true) {
+        int n = ::epoll_wait(epoll_fd, events, 64, 1000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "❌ WebSocket epoll hatası: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd) return;
+            if (fd == listen_fd) {
+                accept_clients();
+            } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                remove_session(fd);
+            } else {
+                on_readable(fd);
+            }
+        }
+
+        int64_t now = steady_ms();
+        if (now - last_expire_ms >= 1000) {
+            last_expire_ms = now;
+            expire_handshakes();
+            if (listener_paused) {
+                if (reserve_fd < 0) reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                epoll_event ev{};
+                ev.events = EPOLLIN;
+                ev.data.fd = listen_fd;
+                ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+                listener_paused = false;
+            }
+        }
+    }
+}
+
+void WebSocketGateway::accept_clients() {
+    while (true) {
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // fd sınırında bağlantı kuyrukta kalırsa level-triggered epoll boşa döner
+            if ((errno == EMFILE || errno == ENFILE) && shed_connection()) continue;
+            return;
+        }
+
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        sessions[fd].accepted_at_ms = steady_ms();
+        connections++;
+    }
+}
+
+bool WebSocketGateway::shed_connection() {
+    if (reserve_fd >= 0) {
+        ::close(reserve_fd);
+        int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        bool exhausted = fd < 0 && (errno == EMFILE || errno == ENFILE);
+        if (fd >= 0) {
+            rejected++;
+            ::close(fd);
+        }
+        reserve_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (reserve_fd >= 0 && !exhausted) return fd >= 0;  // fd < 0: kuyruk boşaldı
+    }
+    std::cerr << "❌ WebSocket fd sınırında, yeni bağlantılar 1 sn bekletiliyor" << std::endl;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, listen_fd, nullptr);
+    listener_paused = true;
+    return false;
+}
+
+void WebSocketGateway::expire_handshakes() {
+    // Bağlanıp el sıkışmayı bitirmeyenler fd tutmasın
+    int64_t deadline = steady_ms() - HANDSHAKE_TIMEOUT_MS;
+    std::vector<int> expired;
+    for (const auto& [fd, session] : sessions) {
+        if (!session.upgraded && session.accepted_at_ms < deadline) expired.push_back(fd);
+    }
+    for (int fd : expired) {
+        reject(fd, "408 Request Timeout");
+        remove_session(fd);
+    }
+}
+
+void WebSocketGateway::on_readable(int fd) {
+    auto it = sessions.find(fd);
+    if (it == sessions.end()) return;
+    Session& session = it->second;
+
+    char buffer[4096];
+    while (true) {
+        ssize_t received = ::recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received > 0) {
+            session.inbox.append(buffer, static_cast<size_t>(received));
+            // Her parça hemen işlenir: tampon bir çerçeveden fazla büyümez
+            bool keep = session.upgraded ? handle_frames(fd, session) : handle_handshake(fd, session);
+            if (!keep) {
+                remove_session(fd);
+                return;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        remove_session(fd);
+        return;
+    }
+}
+
+bool WebSocketGateway::handle_handshake(int fd, Session& session) {
+    size_t end = session.inbox.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        if (session.inbox.size() <= websocket::MAX_HANDSHAKE) return true;
+        reject(fd, "431 Request Header Fields Too Large");
+        return false;
+    }
+
+    websocket::Handshake handshake;
+    if (!websocket::parse_handshake(std::string_view(session.inbox).substr(0, end + 2), handshake)) {
+        reject(fd, "400 Bad Request");
+        return false;
+    }
+    // Oturum bir kez doğrulanır: oyuncu önce /api/game/join ile katılmış olmalı
+    if (!handlers.authenticate(handshake.player_id)) {
+        reject(fd, "403 Forbidden");
+        return false;
+    }
+
+    session.inbox.erase(0, end + 4);
+    session.player_id = std::move(handshake.player_id);
+    const std::string response = websocket::handshake_response(handshake.key);
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        send_locked(fd, response.data(), response.size());
+        session.upgraded = true;
+        upgraded_count++;
+        if (!last_tick.empty()) send_locked(fd, last_tick.data(), last_tick.size());
+    }
+    uint8_t balance[tick_protocol::BALANCE_SIZE];
+    tick_protocol::encode_balance(handlers.balance(session.player_id), balance);
+    send_frame(fd, websocket::Opcode::BINARY, std::string_view(reinterpret_cast<const char*>(balance), sizeof(balance)));
+
+    return session.inbox.empty() || handle_frames(fd, session);
+}
+
+bool WebSocketGateway::handle_frames(int fd, Session& session) {
+    size_t offset = 0;
+    bool keep = true;
+    while (keep) {
+        websocket::Frame frame;
+        long used = websocket::decode_frame(reinterpret_cast<const uint8_t*>(session.inbox.data()) + offset,
+                                            session.inbox.size() - offset, frame);
+        if (used == 0) break;
+        if (used < 0) {
+            send_close(fd, static_cast<uint16_t>(-used));
+            return false;
+        }
+        offset += static_cast<size_t>(used);
+
+        switch (frame.opcode) {
+            case websocket::Opcode::PING:
+                send_frame(fd, websocket::Opcode::PONG, frame.payload);
+                break;
+            case websocket::Opcode::PONG:
+                break;
+            case websocket::Opcode::CLOSE:
+                send_close(fd, websocket::CLOSE_NORMAL);
+                return false;
+            case websocket::Opcode::TEXT:
+                send_close(fd, websocket::CLOSE_UNSUPPORTED);  // Komutlar sadece ikili çerçeve
+                return false;
+            case websocket::Opcode::BINARY:
+            case websocket::Opcode::CONTINUATION: {
+                bool continuation = frame.opcode == websocket::Opcode::CONTINUATION;
+                if (continuation != session.in_message) {
+                    send_close(fd, websocket::CLOSE_PROTOCOL_ERROR);
+                    return false;
+                }
+                if (frame.fin && !continuation) {
+                    keep = handle_message(fd, session, frame.payload);
+                    break;
+                }
+                session.message += frame.payload;
+                session.in_message = !frame.fin;
+                if (session.message.size() > websocket::MAX_MESSAGE) {
+                    send_close(fd, websocket::CLOSE_TOO_BIG);
+                    return false;
+                }
+                if (frame.fin) {
+                    std::string message = std::move(session.message);
+                    session.message.clear();
+                    keep = handle_message(fd, session, message);
+                }
+                break;
+            }
+        }
+    }
+    session.inbox.erase(0, offset);
+    return keep;
+}
+
+bool WebSocketGateway::handle_message(int fd, Session& session, std::string_view message) {
+    tick_protocol::Command command;
+    if (!tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(message.data()), message.size(), command) ||
+        (command.type == tick_protocol::MessageType::BET && command.amount <= 0)) {
+        send_close(fd, websocket::CLOSE_INVALID_PAYLOAD);
+        return false;
+    }
+    // Oturum başka bir oyuncu adına komut gönderemez
+    if (command.player_id != session.player_id) {
+        send_close(fd, websocket::CLOSE_POLICY);
+        return false;
+    }
+
+    commands++;
+    int64_t balance = 0;
+    bool ok = false;
+    try {
+        ok = handlers.execute(session.player_id, command, balance);
+    } catch (const std::exception& e) {
+        // Örn. günlük yazılamadı: event loop'tan kaçarsa tüm sunucu kapanır
+        std::cerr << "❌ WebSocket komut hatası: " << e.what() << std::endl;
+        ok = false;
+        balance = handlers.balance(session.player_id);
+    }
+    uint8_t ack[tick_protocol::ACK_SIZE];
+    tick_protocol::encode_ack(ok, balance, ack);
+    send_frame(fd, websocket::Opcode::BINARY, std::string_view(reinterpret_cast<const char*>(ack), sizeof(ack)));
+    return true;
+}
+
+void WebSocketGateway::send_locked(int fd, const void* data, size_t size) {
+    ssize_t sent = ::send(fd, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent != static_cast<ssize_t>(size)) {
+        // Cevap çerçevesi atlanamaz: yazılamadıysa bağlantı kapanır, loop thread temizler
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void WebSocketGateway::send_frame(int fd, websocket::Opcode opcode, std::string_view payload) {
+    const std::string frame = websocket::encode_frame(opcode, payload);
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    send_locked(fd, frame.data(), frame.size());
+}
+
+void WebSocketGateway::send_close(int fd, uint16_t code) {
+    const std::string frame = websocket::encode_close(code);
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    send_locked(fd, frame.data(), frame.size());
+}
+
+void WebSocketGateway::reject(int fd, const char* status) {
+    const std::string response = std::string("HTTP/1.1 ") + status + "\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    send_locked(fd, response.data(), response.size());
+    rejected++;
+}
+
+void WebSocketGateway::remove_session(int fd) {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    auto it = sessions.find(fd);
+    if (it == sessions.end()) return;
+    if (it->second.upgraded) upgraded_count--;
+    sessions.erase(it);
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+}
+
+void WebSocketGateway::publish(const uint8_t* tick, size_t size) {
+    if (size != tick_protocol::TICK_SIZE) return;
+    uint8_t frame[tick_protocol::TICK_SIZE + websocket::MAX_FRAME_HEADER];
+    size_t length = websocket::encode_frame(websocket::Opcode::BINARY, tick, size, frame);
+    // Kazançlar crash anında ödenir: round bitişinde her oturum güncel bakiyesini alır
+    uint8_t phase = tick[2];
+    bool settled = phase == static_cast<uint8_t>(tick_protocol::Phase::CRASHED) && last_phase != phase;
+
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    last_tick.assign(reinterpret_cast<const char*>(frame), length);
+    last_phase = phase;
+    for (const auto& [fd, session] : sessions) {
+        if (!session.upgraded) continue;
+        ssize_t sent = ::send(fd, frame, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent == static_cast<ssize_t>(length)) {
+            frames_sent++;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            frames_dropped++;
+        } else {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    }
+    if (!settled || !handlers.balance) return;
+
+    uint8_t balance[tick_protocol::BALANCE_SIZE];
+    uint8_t balance_frame[tick_protocol::BALANCE_SIZE + websocket::MAX_FRAME_HEADER];
+    for (const auto& [fd, session] : sessions) {
+        if (!session.upgraded) continue;
+        tick_protocol::encode_balance(handlers.balance(session.player_id), balance);
+        size_t balance_length = websocket::encode_frame(websocket::Opcode::BINARY, balance, sizeof(balance), balance_frame);
+        send_locked(fd, balance_frame, balance_length);
+    }
+}
+
+int WebSocketGateway::get_listen_fd() const {
+    return listen_fd;
+}
+
+uint16_t WebSocketGateway::get_port() const {
+    return port;
+}
+
+WebSocketStats WebSocketGateway::get_stats() {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    return WebSocketStats{upgraded_count, connections.load(), rejected.load(), commands.load(),
+                          frames_sent.load(), frames_dropped.load()};
+}
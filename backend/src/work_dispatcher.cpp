@@ -0,0 +1,103 @@
+#include "work_dispatcher.h"
+#include "trace.h"
+#include <iostream>
+
+WorkDispatcher::WorkDispatcher(const DispatcherConfig& dispatcher_config)
+    : config(dispatcher_config), stopping(false) {
+    if (config.workers == 0) config.workers = 1;
+}
+
+WorkDispatcher::~WorkDispatcher() {
+    stop();
+}
+
+void WorkDispatcher::start() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (!workers.empty()) return;
+    stopping = false;
+    
+    for (size_t i = 0; i < config.workers; ++i) {
+        bool commands_only = config.workers >= 2 && i == 0;
+        workers.emplace_back(&WorkDispatcher::worker_loop, this, commands_only);
+    }
+}
+
+void WorkDispatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+}
+
+bool WorkDispatcher::submit(WorkPriority priority, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (priority == WorkPriority::COMMAND) {
+            if (stopping || command_queue.size() >= config.command_capacity) {
+                command_rejected++;
+                return false;
+            }
+            command_queue.push_back(std::move(task));
+            command_accepted++;
+        } else {
+            // Komutlar birikmeye başladıysa okumaları hiç kabul etme
+            if (stopping || read_queue.size() >= config.read_capacity ||
+                command_queue.size() >= config.read_shed_threshold) {
+                read_rejected++;
+                return false;
+            }
+            read_queue.push_back(std::move(task));
+            read_accepted++;
+        }
+    }
+    queue_cv.notify_all();
+    return true;
+}
+
+void WorkDispatcher::worker_loop(bool commands_only) {
+    trace::set_thread_name(commands_only ? "worker-commands" : "worker");
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [&] {
+                return stopping || !command_queue.empty() || (!commands_only && !read_queue.empty());
+            });
+            
+            if (!command_queue.empty()) {
+                task = std::move(command_queue.front());
+                command_queue.pop_front();
+            } else if (!commands_only && !read_queue.empty()) {
+                task = std::move(read_queue.front());
+                read_queue.pop_front();
+            } else if (stopping) {
+                return;
+            } else {
+                continue;
+            }
+        }
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Worker task error: " << e.what() << std::endl;
+        }
+    }
+}
+
+DispatcherStats WorkDispatcher::get_stats() const {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return DispatcherStats{
+        command_queue.size(),
+        read_queue.size(),
+        command_accepted.load(),
+        command_rejected.load(),
+        read_accepted.load(),
+        read_rejected.load()
+    };
+}
@@ -0,0 +1,181 @@
+#include "game.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// 🔨 CrashGame çok thread'li stres testi
+// İşçi thread'ler place_bet / cashout / load_balance / okuma uçlarını, ayrı bir thread
+// update() ve zorla crash'i aynı anda çağırır. Sonunda tüm bahisler settle edilir ve
+//   Σ bakiye == başlangıç + yüklenen - Σ bahis + Σ kazanç
+// doğrulanır. ThreadSanitizer ile: cmake -DCRASH_STRESS_TSAN=ON
+//
+// Kullanım: crash_stress [--threads N] [--ops M] [--players P]
+namespace {
+
+struct Options {
+    int threads = 8;
+    uint64_t ops = 2000000;  // Tüm işçilerin toplamı
+    int players = 64;
+};
+
+struct Counters {
+    std::atomic<uint64_t> bets{0};
+    std::atomic<uint64_t> rejected_bets{0};
+    std::atomic<uint64_t> cashouts{0};
+    std::atomic<uint64_t> loads{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<Money> bet_total{0};
+    std::atomic<Money> loaded_total{0};
+};
+
+Options parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--threads") == 0) options.threads = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--ops") == 0) options.ops = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--players") == 0) options.players = std::max(1, std::atoi(argv[i + 1]));
+    }
+    return options;
+}
+
+std::string player_id(int index) {
+    return "stress-" + std::to_string(index);
+}
+
+void worker(CrashGame& game, const Options& options, int thread_index, uint64_t ops, Counters& counters) {
+    std::mt19937_64 rng(1000 + thread_index);
+    std::uniform_int_distribution<int> pick_player(0, options.players - 1);
+    std::uniform_int_distribution<int> pick_op(0, 99);
+    std::uniform_int_distribution<Money> pick_amount(1 * MONEY_SCALE, 50 * MONEY_SCALE);
+    std::vector<std::string> ids;
+    for (int i = 0; i < options.players; i++) ids.push_back(player_id(i));
+
+    for (uint64_t i = 0; i < ops; i++) {
+        const std::string& id = ids[pick_player(rng)];
+        int op = pick_op(rng);
+        if (op < 50) {
+            Money amount = pick_amount(rng);
+            if (game.place_bet(id, amount)) {
+                counters.bets++;
+                counters.bet_total += amount;
+            } else {
+                counters.rejected_bets++;
+            }
+        } else if (op < 85) {
+            if (game.cashout(id)) counters.cashouts++;
+        } else if (op < 99) {
+            Money amount = pick_amount(rng) * 10;
+            if (game.load_balance(id, amount)) {
+                counters.loads++;
+                counters.loaded_total += amount;
+            }
+        } else {
+            json bets;
+            game.get_current_bets_json(bets);
+            game.get_game_state_json();
+            counters.reads++;
+        }
+    }
+}
+
+// Round'ları hızlı döndürür: uçuş 20ms'yi geçince crash'i zorlar
+void updater(CrashGame& game, std::atomic<bool>& stop, std::atomic<uint64_t>& updates) {
+    auto flying_since = std::chrono::steady_clock::now();
+    bool was_flying = false;
+    while (!stop.load()) {
+        game.update();
+        updates++;
+        bool flying = game.get_phase() == GamePhase::FLYING;
+        auto now = std::chrono::steady_clock::now();
+        if (flying && !was_flying) flying_since = now;
+        if (flying && now - flying_since > std::chrono::milliseconds(20)) {
+            game.end_game();
+        }
+        was_flying = flying;
+        std::this_thread::yield();
+    }
+}
+
+// Bekleyen tüm bahisleri settle et: mevcut round ve bir sonraki round'a verilenler
+void settle_everything(CrashGame& game) {
+    for (int pass = 0; pass < 2; pass++) {
+        if (game.get_phase() == GamePhase::WAITING) game.start_flying_phase();
+        game.end_game();
+        game.start_next_round();
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options = parse_options(argc, argv);
+    CrashGame game(true);
+    game.set_session_ttl_ms(0);
+    for (int i = 0; i < options.players; i++) {
+        game.add_player(player_id(i), "Stres " + std::to_string(i));
+    }
+    const Money initial_total = static_cast<Money>(options.players) * 1000 * MONEY_SCALE;
+
+    Counters counters;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> updates{0};
+    std::cout << "🔨 " << options.threads << " thread, " << options.ops << " işlem, "
+              << options.players << " oyuncu" << std::endl;
+
+    auto started = std::chrono::steady_clock::now();
+    std::thread update_thread(updater, std::ref(game), std::ref(stop), std::ref(updates));
+    std::vector<std::thread> workers;
+    uint64_t per_thread = options.ops / static_cast<uint64_t>(options.threads);
+    for (int t = 0; t < options.threads; t++) {
+        workers.emplace_back(worker, std::ref(game), std::cref(options), t, per_thread, std::ref(counters));
+    }
+    for (auto& thread : workers) thread.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    stop = true;
+    update_thread.join();
+
+    settle_everything(game);
+
+    Money balances = 0;
+    Money winnings = 0;
+    bool negative = false;
+    for (int i = 0; i < options.players; i++) {
+        auto player = game.get_player(player_id(i));
+        if (!player) {
+            std::cerr << "❌ Oyuncu kayboldu: " << player_id(i) << std::endl;
+            return 1;
+        }
+        balances += player->get_balance();
+        winnings += player->get_total_winnings();
+        negative = negative || player->get_balance() < 0;
+    }
+    Money expected = initial_total + counters.loaded_total.load() - counters.bet_total.load() + winnings;
+
+    uint64_t total_ops = per_thread * static_cast<uint64_t>(options.threads);
+    std::cout << "   " << static_cast<uint64_t>(total_ops / elapsed) << " işlem/sn ("
+              << elapsed * 1000.0 << " ms), " << game.get_current_round() - 1 << " round, "
+              << updates.load() << " update" << std::endl;
+    std::cout << "   bahis " << counters.bets.load() << " (reddedilen " << counters.rejected_bets.load()
+              << "), cashout " << counters.cashouts.load() << ", yükleme " << counters.loads.load()
+              << ", okuma " << counters.reads.load() << std::endl;
+    std::cout << "   Σ bakiye " << money_to_string(balances) << " TL, beklenen "
+              << money_to_string(expected) << " TL (kazanç " << money_to_string(winnings) << " TL)" << std::endl;
+
+    if (balances != expected || negative) {
+        std::cerr << "❌ Para korunumu bozuldu" << (negative ? " (negatif bakiye)" : "") << std::endl;
+        return 1;
+    }
+    // Kabul edilen her bahis tam olarak bir kez settle edilmiş olmalı
+    if (game.get_bet_history()->size() != counters.bets.load()) {
+        std::cerr << "❌ Settle edilen bahis sayısı " << game.get_bet_history()->size()
+                  << ", kabul edilen " << counters.bets.load() << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Para korunumu tuttu" << std::endl;
+    return 0;
+}
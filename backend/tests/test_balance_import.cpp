@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "balance_import.h"
+#include "game.h"
+
+namespace {
+
+// Tüm satırları toplar
+std::vector<BalanceCredit> parse_all(const std::string& body, BalanceImportReport& report, size_t chunk_size) {
+    std::vector<BalanceCredit> credits;
+    BalanceImportParser parser(report, [&credits](const std::vector<BalanceCredit>& batch) {
+        credits.insert(credits.end(), batch.begin(), batch.end());
+    }, 2);
+    for (size_t offset = 0; offset < body.size(); offset += chunk_size) {
+        parser.feed(std::string_view(body).substr(offset, chunk_size));
+    }
+    parser.finish();
+    return credits;
+}
+
+}
+
+TEST(BalanceImportTest, ParsesCsvAcrossChunkBoundaries) {
+    const std::string body =
+        "player_name,amount\r\n"
+        "beko,25.50\r\n"
+        "\n"
+        "\"Irak, Beko \"\"B\"\"\", 10\n"
+        "ali,12.345\n"
+        "veli\n"
+        "ayse,7,fazla\n"
+        "  zeynep , 3.5";
+
+    // Parça boyutu sonucu değiştirmemeli (1 byte: her satır parçalara bölünür)
+    for (size_t chunk_size : {body.size(), size_t(7), size_t(1)}) {
+        BalanceImportReport report;
+        auto credits = parse_all(body, report, chunk_size);
+        ASSERT_EQ(credits.size(), 3u) << "chunk " << chunk_size;
+        EXPECT_EQ(credits[0].player_name, "beko");
+        EXPECT_EQ(credits[0].amount, 2550);
+        EXPECT_EQ(credits[0].line, 2u);
+        EXPECT_EQ(credits[1].player_name, "Irak, Beko \"B\"");
+        EXPECT_EQ(credits[1].amount, 1000);
+        EXPECT_EQ(credits[2].player_name, "zeynep");
+        EXPECT_EQ(credits[2].amount, 350);
+
+        EXPECT_EQ(report.rows, 6u);  // Başlık ve boş satır sayılmaz
+        ASSERT_EQ(report.error_count, 3u);
+        EXPECT_EQ(report.errors[0].line, 5u);
+        EXPECT_EQ(report.errors[1].line, 6u);
+        EXPECT_EQ(report.errors[2].line, 7u);
+    }
+}
+
+TEST(BalanceImportTest, ParsesNdjson) {
+    const std::string body =
+        "{\"player_name\": \"beko\", \"amount\": 25.5}\n"
+        "{\"player_name\": \"ali\", \"amount\": 10}\n"
+        "{\"player_name\": \"veli\", \"amount\": -1}\n"
+        "{bozuk\n"
+        "{\"amount\": 5}\n";
+    BalanceImportReport report;
+    auto credits = parse_all(body, report, 5);
+    ASSERT_EQ(credits.size(), 2u);
+    EXPECT_EQ(credits[0].amount, 2550);
+    EXPECT_EQ(credits[1].player_name, "ali");
+    EXPECT_EQ(report.rows, 5u);
+    EXPECT_EQ(report.error_count, 3u);
+}
+
+TEST(BalanceImportTest, ParseAmount) {
+    Money amount = 0;
+    EXPECT_TRUE(BalanceImportParser::parse_amount("12", amount));
+    EXPECT_EQ(amount, 1200);
+    EXPECT_TRUE(BalanceImportParser::parse_amount(" 0.05 ", amount));
+    EXPECT_EQ(amount, 5);
+    EXPECT_TRUE(BalanceImportParser::parse_amount("1.5", amount));
+    EXPECT_EQ(amount, 150);
+    EXPECT_FALSE(BalanceImportParser::parse_amount("0", amount));
+    EXPECT_FALSE(BalanceImportParser::parse_amount("-3", amount));
+    EXPECT_FALSE(BalanceImportParser::parse_amount("1.234", amount));
+    EXPECT_FALSE(BalanceImportParser::parse_amount("1.", amount));
+    EXPECT_FALSE(BalanceImportParser::parse_amount("1e5", amount));
+    EXPECT_FALSE(BalanceImportParser::parse_amount("99999999999999", amount));
+}
+
+TEST(BalanceImportTest, GameAppliesBatchesAndReportsUnknownPlayers) {
+    CrashGame game(true);
+    game.add_player("p1", "ali");
+    game.add_player("p2", "veli");
+
+    BalanceImportReport report;
+    BalanceImportParser parser(report, [&game, &report](const std::vector<BalanceCredit>& batch) {
+        game.load_balances(batch, report);
+    }, 2);
+    parser.feed("ali,10\nyok,5\nveli,2.50\nali,1\n");
+    parser.finish();
+
+    EXPECT_EQ(report.rows, 4u);
+    EXPECT_EQ(report.credited, 3u);
+    EXPECT_EQ(report.total, 1350);
+    ASSERT_EQ(report.errors.size(), 1u);
+    EXPECT_EQ(report.errors[0].line, 2u);
+    EXPECT_EQ(game.get_player("p1")->get_balance(), 1000 * MONEY_SCALE + 1100);
+    EXPECT_EQ(game.get_player("p2")->get_balance(), 1000 * MONEY_SCALE + 250);
+}
+
+TEST(BalanceImportTest, SkipsOverlongLineWithoutBufferingIt) {
+    const std::string body = "ali,1\n" + std::string(BalanceImportParser::MAX_LINE_BYTES * 3, 'x') + ",5\nveli,2\n";
+
+    BalanceImportReport report;
+    auto credits = parse_all(body, report, 1000);
+    ASSERT_EQ(credits.size(), 2u);
+    EXPECT_EQ(credits[1].player_name, "veli");
+    EXPECT_EQ(credits[1].line, 3u);
+    EXPECT_EQ(report.rows, 3u);
+    ASSERT_EQ(report.errors.size(), 1u);
+    EXPECT_EQ(report.errors[0].line, 2u);
+}
+
+TEST(BalanceImportTest, UploadAppliesPartsInOrderOnce) {
+    std::vector<BalanceCredit> credits;
+    BalanceImportUploads uploads([&credits](const std::vector<BalanceCredit>& batch, BalanceImportReport& report) {
+        credits.insert(credits.end(), batch.begin(), batch.end());
+        report.credited += static_cast<uint32_t>(batch.size());
+    }, 4, 60000, 2);
+
+    // Parça sınırı satır ortasında
+    auto first = uploads.feed("u1", 0, false, "ali,10\nveli,2", 0);
+    EXPECT_EQ(first.result, BalanceImportUploads::Result::ACCEPTED);
+    EXPECT_EQ(first.next_part, 1u);
+    EXPECT_EQ(first.report.rows, 1u);
+
+    // Retry edilen parça tekrar uygulanmaz, atlanan parça da kabul edilmez
+    auto retried = uploads.feed("u1", 0, false, "ali,10\nveli,2", 10);
+    EXPECT_EQ(retried.result, BalanceImportUploads::Result::OUT_OF_ORDER);
+    EXPECT_EQ(retried.next_part, 1u);
+    EXPECT_EQ(uploads.feed("u1", 2, true, "x,1", 10).result, BalanceImportUploads::Result::OUT_OF_ORDER);
+
+    auto done = uploads.feed("u1", 1, true, ".50\nayse,3", 20);
+    EXPECT_EQ(done.result, BalanceImportUploads::Result::DONE);
+    EXPECT_EQ(done.report.rows, 3u);
+    EXPECT_EQ(done.report.credited, 3u);
+    ASSERT_EQ(credits.size(), 3u);
+    EXPECT_EQ(credits[1].player_name, "veli");
+    EXPECT_EQ(credits[1].amount, 250);
+    EXPECT_EQ(uploads.active(), 0u);
+
+    // Biten yükleme kapanır
+    EXPECT_EQ(uploads.feed("u1", 2, true, "x,1", 30).result, BalanceImportUploads::Result::UNKNOWN_UPLOAD);
+}
+
+TEST(BalanceImportTest, UploadsAreBoundedAndExpire) {
+    BalanceImportUploads uploads([](const std::vector<BalanceCredit>&, BalanceImportReport&) {}, 2, 1000);
+
+    EXPECT_EQ(uploads.feed("a", 0, false, "ali,1\n", 0).result, BalanceImportUploads::Result::ACCEPTED);
+    EXPECT_EQ(uploads.feed("b", 0, false, "ali,1\n", 0).result, BalanceImportUploads::Result::ACCEPTED);
+    EXPECT_EQ(uploads.feed("c", 0, false, "ali,1\n", 500).result, BalanceImportUploads::Result::TOO_MANY);
+
+    // "a" parça yollamaya devam eder, "b" zaman aşımına uğrar ve yeri boşalır
+    EXPECT_EQ(uploads.feed("a", 1, false, "ali,1\n", 900).result, BalanceImportUploads::Result::ACCEPTED);
+    EXPECT_EQ(uploads.feed("c", 0, false, "ali,1\n", 1500).result, BalanceImportUploads::Result::ACCEPTED);
+    EXPECT_EQ(uploads.feed("b", 1, false, "ali,1\n", 1500).result, BalanceImportUploads::Result::UNKNOWN_UPLOAD);
+    EXPECT_EQ(uploads.active(), 2u);
+}
@@ -4,7 +4,7 @@
 class BetTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        bet = std::make_unique<Bet>("player1", 100.0, 1);
+        bet = std::make_unique<Bet>("player1", 100 * MONEY_SCALE, 1);
     }
 
     void TearDown() override {
@@ -16,7 +16,7 @@ protected:
 
 TEST_F(BetTest, BetCreation) {
     EXPECT_EQ(bet->get_player_id(), "player1");
-    EXPECT_EQ(bet->get_amount(), 100.0);
+    EXPECT_EQ(bet->get_amount(), 100 * MONEY_SCALE);
     EXPECT_EQ(bet->get_cashout_multiplier(), 0.0);
     EXPECT_EQ(bet->get_status(), BetStatus::ACTIVE);
     EXPECT_EQ(bet->get_game_round(), 1);
@@ -26,7 +26,7 @@ TEST_F(BetTest, Cashout_Success) {
     EXPECT_TRUE(bet->cashout(2.5));
     EXPECT_EQ(bet->get_status(), BetStatus::CASHED_OUT);
     EXPECT_EQ(bet->get_cashout_multiplier(), 2.5);
-    EXPECT_EQ(bet->calculate_winnings(), 250.0); // 100 * 2.5
+    EXPECT_EQ(bet->calculate_winnings(), 250 * MONEY_SCALE); // 100 * 2.5
 }
 
 TEST_F(BetTest, Cashout_AlreadyCashedOut) {
@@ -41,7 +41,7 @@ TEST_F(BetTest, Cashout_AlreadyCashedOut) {
 TEST_F(BetTest, MarkAsCrashed) {
     bet->mark_as_crashed();
     EXPECT_EQ(bet->get_status(), BetStatus::CRASHED);
-    EXPECT_EQ(bet->calculate_winnings(), 0.0); // Crash olduğunda kazanç yok
+    EXPECT_EQ(bet->calculate_winnings(), 0); // Crash olduğunda kazanç yok
 }
 
 TEST_F(BetTest, MarkAsCrashed_AfterCashout) {
@@ -51,26 +51,34 @@ TEST_F(BetTest, MarkAsCrashed_AfterCashout) {
     // Sonra crash işareti koy - etki etmemeli
     bet->mark_as_crashed();
     EXPECT_EQ(bet->get_status(), BetStatus::CASHED_OUT); // Hala CASHED_OUT olmalı
-    EXPECT_EQ(bet->calculate_winnings(), 150.0); // Kazanç korunmalı
+    EXPECT_EQ(bet->calculate_winnings(), 150 * MONEY_SCALE); // Kazanç korunmalı
 }
 
 TEST_F(BetTest, CalculateWinnings_NoCashout) {
     // Cashout yapılmadan kazanç hesaplama
-    EXPECT_EQ(bet->calculate_winnings(), 0.0);
+    EXPECT_EQ(bet->calculate_winnings(), 0);
     
     // Crash olduktan sonra da kazanç yok
     bet->mark_as_crashed();
-    EXPECT_EQ(bet->calculate_winnings(), 0.0);
+    EXPECT_EQ(bet->calculate_winnings(), 0);
 }
 
 TEST_F(BetTest, HighMultiplierCashout) {
     // Yüksek çarpan test
     EXPECT_TRUE(bet->cashout(50.75));
-    EXPECT_EQ(bet->calculate_winnings(), 5075.0); // 100 * 50.75
+    EXPECT_EQ(bet->calculate_winnings(), 5075 * MONEY_SCALE); // 100 * 50.75
 }
 
 TEST_F(BetTest, LowMultiplierCashout) {
     // Düşük çarpan test (1.01x gibi)
     EXPECT_TRUE(bet->cashout(1.01));
-    EXPECT_EQ(bet->calculate_winnings(), 101.0); // 100 * 1.01
-}
\ No newline at end of file
+    EXPECT_EQ(bet->calculate_winnings(), 101 * MONEY_SCALE); // 100 * 1.01
+}
+
+TEST_F(BetTest, WinningsRoundDownToKurus) {
+    // 0.33 TL * 1.5x = 0.495 TL -> 0.49 TL (kuruş altı kesilir, double hatası yok)
+    Bet small("player1", 33, 1);
+    EXPECT_TRUE(small.cashout(1.5));
+    EXPECT_EQ(small.get_cashout_multiplier_x100(), 150u);
+    EXPECT_EQ(small.calculate_winnings(), 49);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "bet_history.h"
+#include "bet.h"
+#include <sys/resource.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstdio>
+
+namespace {
+
+// SettledBet view tutar; testlerde sabit literal'ler kullanılır
+SettledBet won(std::string_view player_id, int64_t amount, uint32_t multiplier_x100) {
+    return SettledBet{player_id, player_id, amount, amount * multiplier_x100 / 100,
+                      multiplier_x100, static_cast<uint8_t>(BetStatus::CASHED_OUT)};
+}
+
+SettledBet lost(std::string_view player_id, int64_t amount) {
+    return SettledBet{player_id, player_id, amount, 0, 0, static_cast<uint8_t>(BetStatus::CRASHED)};
+}
+
+}
+
+class BetHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "/tmp/crash_bet_history_test_" + std::to_string(::getpid()) + ".bin";
+        std::remove(path.c_str());
+        std::remove((path + ".players").c_str());
+    }
+    
+    void TearDown() override {
+        std::remove(path.c_str());
+        std::remove((path + ".players").c_str());
+    }
+    
+    std::string path;
+};
+
+TEST_F(BetHistoryTest, PagesNewestFirst) {
+    BetHistoryStore store;
+    for (uint32_t round = 1; round <= 5; ++round) {
+        store.append_round(round, 1000 * round, {won("p1", 10000, 150), lost("p2", 5000)});
+    }
+    
+    HistoryPage page = store.query("p1", 0, 2);
+    ASSERT_EQ(page.records.size(), 2u);
+    EXPECT_EQ(page.records[0].round, 5u);
+    EXPECT_EQ(page.records[1].round, 4u);
+    EXPECT_EQ(page.records[0].payout, 15000);
+    EXPECT_NE(page.next_cursor, 0u);
+    
+    page = store.query("p1", page.next_cursor, 10);
+    ASSERT_EQ(page.records.size(), 3u);
+    EXPECT_EQ(page.records[0].round, 3u);
+    EXPECT_EQ(page.records[2].round, 1u);
+    EXPECT_EQ(page.next_cursor, 0u);
+    
+    EXPECT_EQ(store.size(), 10u);
+    EXPECT_EQ(store.get_player_bet_count("p2"), 5u);
+}
+
+TEST_F(BetHistoryTest, UnknownPlayerAndForeignCursor) {
+    BetHistoryStore store;
+    store.append_round(1, 1000, {won("p1", 100, 200), lost("p2", 100)});
+    
+    EXPECT_TRUE(store.query("nobody", 0, 10).records.empty());
+    
+    // p1'in imleciyle p2 kayıtları okunamaz
+    HistoryPage p1_page = store.query("p1", 0, 10);
+    ASSERT_EQ(p1_page.records.size(), 1u);
+    HistoryPage foreign = store.query("p2", 1, 10);
+    EXPECT_TRUE(foreign.records.empty());
+}
+
+TEST_F(BetHistoryTest, SegmentsPerRound) {
+    BetHistoryStore store;
+    store.append_round(1, 1000, {lost("p1", 100), lost("p2", 100)});
+    store.append_round(2, 2000, {lost("p1", 100)});
+    store.append_round(3, 3000, {});  // Bahissiz round segment oluşturmaz
+    
+    auto segments = store.get_segments();
+    ASSERT_EQ(segments.size(), 2u);
+    EXPECT_EQ(store.last_round(), 2u);
+    EXPECT_EQ(segments[0].count, 2u);
+    EXPECT_EQ(segments[1].first, 2u);
+    EXPECT_EQ(segments[1].settled_at_ms, 2000);
+}
+
+TEST_F(BetHistoryTest, ReopenRebuildsIndex) {
+    {
+        BetHistoryStore store(path);
+        store.append_round(1, 1000, {won("p1", 100, 250), lost("p2", 300)});
+        store.append_round(2, 2000, {lost("p1", 400)});
+    }
+    
+    BetHistoryStore reopened(path);
+    EXPECT_EQ(reopened.size(), 3u);
+    EXPECT_EQ(reopened.get_segments().size(), 2u);
+    
+    HistoryPage page = reopened.query("p1", 0, 10);
+    ASSERT_EQ(page.records.size(), 2u);
+    EXPECT_EQ(page.records[0].amount, 400);
+    EXPECT_EQ(page.records[1].multiplier_x100, 250u);
+    
+    // Yeni kayıtlar eski zincire bağlanır
+    reopened.append_round(3, 3000, {won("p1", 500, 110)});
+    EXPECT_EQ(reopened.query("p1", 0, 10).records.size(), 3u);
+}
+
+TEST_F(BetHistoryTest, FailedAppendLeavesFileAligned) {
+    {
+        BetHistoryStore store(path);
+        store.append_round(1, 1000, {won("p1", 10000, 150), lost("p2", 5000)});
+        
+        // Dosya boyutu sınırı: round'un sadece bir buçuk kaydı sığar, write yarıda EFBIG döner
+        rlimit original{};
+        ::getrlimit(RLIMIT_FSIZE, &original);
+        auto previous = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit limited = original;
+        limited.rlim_cur = 2 * sizeof(BetRecord) + sizeof(BetRecord) * 3 / 2;
+        ::setrlimit(RLIMIT_FSIZE, &limited);
+        EXPECT_THROW(store.append_round(2, 2000, {lost("p1", 100), lost("p2", 200), lost("p1", 300)}),
+                     std::runtime_error);
+        ::setrlimit(RLIMIT_FSIZE, &original);
+        std::signal(SIGXFSZ, previous);
+        
+        // İndeks ve dosya başarısız round'dan önceki halinde
+        EXPECT_EQ(store.size(), 2u);
+        EXPECT_EQ(store.get_player_bet_count("p1"), 1u);
+        EXPECT_EQ(store.get_segments().size(), 1u);
+        HistoryPage page = store.query("p1", 0, 10);
+        ASSERT_EQ(page.records.size(), 1u);
+        EXPECT_EQ(page.records[0].round, 1u);
+        
+        store.append_round(3, 3000, {lost("p1", 400)});
+    }
+    
+    BetHistoryStore reopened(path);
+    EXPECT_EQ(reopened.size(), 3u);
+    HistoryPage page = reopened.query("p1", 0, 10);
+    ASSERT_EQ(page.records.size(), 2u);
+    EXPECT_EQ(page.records[0].round, 3u);
+    EXPECT_EQ(page.records[0].amount, 400);
+    EXPECT_EQ(page.records[1].round, 1u);
+}
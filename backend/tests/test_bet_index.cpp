@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "bet_index.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST(BetIndexTest, InsertFindAndErase) {
+    BetIndex index(16);
+    bool inserted = false;
+    index.insert("p1", BetIndex::Chain{0, 0}, inserted);
+    EXPECT_TRUE(inserted);
+    BetIndex::Chain& existing = index.insert("p1", BetIndex::Chain{5, 5}, inserted);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(existing.head, 0u);
+    existing.tail = 3;
+
+    ASSERT_NE(index.find("p1"), nullptr);
+    EXPECT_EQ(index.find("p1")->tail, 3u);
+    EXPECT_EQ(index.find("p2"), nullptr);
+
+    index.erase("p1");
+    index.erase("p2");
+    EXPECT_EQ(index.find("p1"), nullptr);
+    EXPECT_EQ(index.size(), 0u);
+}
+
+TEST(BetIndexTest, EraseKeepsCollidingKeysReachable) {
+    // Küçük tabloda çakışmalar kaçınılmaz; silinen slotun arkasındakiler kaybolmamalı
+    BetIndex index(16);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 8; i++) keys.push_back("player_" + std::to_string(i));
+    bool inserted = false;
+    for (uint32_t i = 0; i < keys.size(); i++) index.insert(keys[i], BetIndex::Chain{i, i}, inserted);
+
+    for (size_t i = 0; i < keys.size(); i += 2) index.erase(keys[i]);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        const BetIndex::Chain* chain = index.find(keys[i]);
+        if (i % 2 == 0) {
+            EXPECT_EQ(chain, nullptr) << keys[i];
+        } else {
+            ASSERT_NE(chain, nullptr) << keys[i];
+            EXPECT_EQ(chain->head, i);
+        }
+    }
+    EXPECT_EQ(index.size(), 4u);
+}
+
+TEST(BetIndexTest, GrowsAndMatchesReferenceMap) {
+    BetIndex index(16);
+    std::unordered_map<std::string, uint32_t> reference;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 5000; i++) keys.push_back("p" + std::to_string(i * 7919 % 10007));
+
+    bool inserted = false;
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        index.insert(keys[i], BetIndex::Chain{i, i}, inserted);
+        reference.emplace(keys[i], i);
+        if (i % 3 == 0) {
+            index.erase(keys[i / 2]);
+            reference.erase(keys[i / 2]);
+        }
+    }
+    EXPECT_EQ(index.size(), reference.size());
+    for (const auto& key : keys) {
+        auto expected = reference.find(key);
+        const BetIndex::Chain* chain = index.find(key);
+        if (expected == reference.end()) {
+            EXPECT_EQ(chain, nullptr) << key;
+        } else {
+            ASSERT_NE(chain, nullptr) << key;
+            EXPECT_EQ(chain->head, expected->second);
+        }
+    }
+}
+
+TEST(BetIndexTest, ClearReusesSlotsAcrossRounds) {
+    BetIndex index(16);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; i++) keys.push_back("player_" + std::to_string(i));
+
+    bool inserted = false;
+    size_t capacity = 0;
+    for (int round = 0; round < 5; round++) {
+        index.clear();
+        EXPECT_EQ(index.find(keys[0]), nullptr);
+        for (uint32_t i = 0; i < keys.size(); i++) {
+            index.insert(keys[i], BetIndex::Chain{i, i}, inserted);
+            EXPECT_TRUE(inserted);
+        }
+        // İlk round'dan sonra tablo büyümemeli
+        if (round == 0) capacity = index.capacity();
+        EXPECT_EQ(index.capacity(), capacity);
+        EXPECT_EQ(index.size(), keys.size());
+    }
+}
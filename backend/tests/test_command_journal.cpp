@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "command_journal.h"
+#include "journal_replay.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Saate bakmadan iki round oynatır; her round'da bir oyuncu kazanır, biri kaybeder
+void play_rounds(CrashGame& game) {
+    game.add_player("p1", "Ali");
+    game.add_player("p2", "Veli");
+    game.load_balance("p2", 250 * MONEY_SCALE);
+    for (int round = 0; round < 2; round++) {
+        game.place_bet("p1", 100 * MONEY_SCALE);
+        game.place_bet("p2", 40 * MONEY_SCALE);
+        game.start_flying_phase(3.0);
+        game.cashout_at("p1", 1.37);
+        game.place_bet("p2", 10 * MONEY_SCALE);  // Bir sonraki round'a
+        game.end_game();
+        game.start_next_round();
+    }
+    game.withdraw_balance("p1", 5 * MONEY_SCALE);
+    game.remove_player("p2");
+}
+
+}
+
+class CommandJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "/tmp/crash_journal_test_" + std::to_string(::getpid()) + ".bin";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+};
+
+TEST_F(CommandJournalTest, RecordsRoundTrip) {
+    CommandJournal journal;
+    journal.record(JournalType::ADD_PLAYER, 1, 0, "p1", "Ali");
+    journal.record(JournalType::BET, 1, 12345, "p1");
+    journal.record(JournalType::FLY, 1, 250);
+    EXPECT_EQ(journal.size(), 3u);
+
+    std::string buffer = journal.get_buffer();
+    JournalReader reader(buffer.data(), buffer.size());
+    JournalEntry entry;
+    ASSERT_TRUE(reader.next(entry));
+    EXPECT_EQ(entry.type, JournalType::ADD_PLAYER);
+    EXPECT_EQ(entry.player_id, "p1");
+    EXPECT_EQ(entry.name, "Ali");
+    ASSERT_TRUE(reader.next(entry));
+    EXPECT_EQ(entry.type, JournalType::BET);
+    EXPECT_EQ(entry.value, 12345);
+    ASSERT_TRUE(reader.next(entry));
+    EXPECT_EQ(entry.type, JournalType::FLY);
+    EXPECT_TRUE(entry.player_id.empty());
+    EXPECT_FALSE(reader.next(entry));
+    EXPECT_FALSE(reader.truncated());
+
+    // Yarım kalan son kayıt okunmaz
+    JournalReader partial(buffer.data(), buffer.size() - 5);
+    int count = 0;
+    while (partial.next(entry)) count++;
+    EXPECT_EQ(count, 2);
+    EXPECT_TRUE(partial.truncated());
+}
+
+TEST_F(CommandJournalTest, FileJournalDropsPartialTail) {
+    {
+        CommandJournal journal(path);
+        journal.record(JournalType::ADD_PLAYER, 1, 0, "p1", "Ali");
+    }
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::write(fd, "\x01\x02\x03", 3), 3);
+    ::close(fd);
+
+    {
+        CommandJournal journal(path);
+        EXPECT_EQ(journal.size(), 1u);
+        journal.record(JournalType::BET, 1, 500, "p1");
+    }
+    std::vector<char> content = read_journal_file(path);
+    JournalReader reader(content.data(), content.size());
+    JournalEntry entry;
+    ASSERT_TRUE(reader.next(entry));
+    ASSERT_TRUE(reader.next(entry));
+    EXPECT_EQ(entry.type, JournalType::BET);
+    EXPECT_EQ(entry.value, 500);
+    EXPECT_FALSE(reader.truncated());
+}
+
+TEST_F(CommandJournalTest, ReplayReproducesBalances) {
+    auto journal = std::make_shared<CommandJournal>();
+    CrashGame game(true);
+    game.set_command_journal(journal);
+    play_rounds(game);
+
+    std::string buffer = journal->get_buffer();
+    JournalReader reader(buffer.data(), buffer.size());
+    JournalReplayer replayer;
+    const ReplayStats& stats = replayer.run(reader);
+
+    EXPECT_FALSE(stats.diverged());
+    EXPECT_EQ(stats.rounds, 2u);
+    EXPECT_EQ(stats.checkpoints, 2u);
+    EXPECT_EQ(replayer.get_game().balance_checksum(), game.balance_checksum());
+    EXPECT_EQ(replayer.get_game().get_current_round(), game.get_current_round());
+    EXPECT_EQ(replayer.get_game().get_player_count(), 1u);
+}
+
+TEST_F(CommandJournalTest, ReplayContinuesRoundNumbersFromStart) {
+    // Soğuk başlangıç round'ları önceki çalışmanın devamından numaralar; START kaydı ilk round'u taşır
+    auto journal = std::make_shared<CommandJournal>();
+    CrashGame game(true);
+    game.set_first_round(41);
+    game.set_command_journal(journal);
+    play_rounds(game);
+    ASSERT_EQ(game.get_current_round(), 43);
+
+    std::string buffer = journal->get_buffer();
+    JournalReader reader(buffer.data(), buffer.size());
+    JournalReplayer replayer;
+    const ReplayStats& stats = replayer.run(reader);
+
+    EXPECT_FALSE(stats.diverged());
+    EXPECT_EQ(stats.rounds, 2u);
+    EXPECT_EQ(replayer.get_game().get_current_round(), 43);
+}
+
+TEST_F(CommandJournalTest, ReplayReloadsPagedPlayers) {
+    auto journal = std::make_shared<CommandJournal>();
+    CrashGame game(true);
+    game.set_command_journal(journal);
+    play_rounds(game);  // p2 bakiyesi değiştiği için sayfalandı
+
+    // Okuma da geri yükler: replay aynı noktada belleğe almalı, bakiye özeti tutmalı
+    ASSERT_NE(game.get_player("p2"), nullptr);
+    game.place_bet("p2", 20 * MONEY_SCALE);
+    game.start_flying_phase(2.0);
+    game.end_game();
+
+    std::string buffer = journal->get_buffer();
+    JournalReader reader(buffer.data(), buffer.size());
+    JournalReplayer replayer;
+    const ReplayStats& stats = replayer.run(reader);
+
+    EXPECT_FALSE(stats.diverged());
+    EXPECT_EQ(stats.checkpoints, 3u);
+    EXPECT_EQ(replayer.get_game().get_player_count(), 2u);
+    EXPECT_EQ(replayer.get_game().balance_checksum(), game.balance_checksum());
+}
+
+TEST_F(CommandJournalTest, ReplayDetectsDivergence) {
+    auto journal = std::make_shared<CommandJournal>();
+    CrashGame game(true);
+    game.set_command_journal(journal);
+    play_rounds(game);
+
+    // İlk cashout çarpanını değiştir: ilk round'un bakiye özeti tutmamalı
+    std::string buffer = journal->get_buffer();
+    size_t offset = 0;
+    JournalRecordHeader header;
+    while (offset < buffer.size()) {
+        std::memcpy(&header, buffer.data() + offset, sizeof(header));
+        if (header.type == static_cast<uint8_t>(JournalType::CASHOUT)) {
+            header.value = 200;
+            std::memcpy(&buffer[offset], &header, sizeof(header));
+            break;
+        }
+        offset += sizeof(header) + header.id_size + header.name_size;
+    }
+
+    JournalReader reader(buffer.data(), buffer.size());
+    JournalReplayer replayer;
+    const ReplayStats& stats = replayer.run(reader);
+    EXPECT_TRUE(stats.diverged());
+    EXPECT_EQ(stats.rejected, 0u);
+    EXPECT_EQ(stats.checkpoint_mismatches, 2u);
+    EXPECT_EQ(stats.first_mismatch_round, 1u);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "compression.h"
+#include "response_cache.h"
+
+TEST(CompressionTest, NegotiatePrefersGzip) {
+    EXPECT_EQ(Compression::negotiate("gzip, deflate, br"), ContentCoding::GZIP);
+    EXPECT_EQ(Compression::negotiate("deflate, gzip"), ContentCoding::GZIP);
+}
+
+TEST(CompressionTest, NegotiateHonorsQValues) {
+    EXPECT_EQ(Compression::negotiate("gzip;q=0.5, deflate;q=0.9"), ContentCoding::DEFLATE);
+    EXPECT_EQ(Compression::negotiate("gzip;q=0, deflate"), ContentCoding::DEFLATE);
+    EXPECT_EQ(Compression::negotiate("gzip;q=0"), ContentCoding::IDENTITY);
+}
+
+TEST(CompressionTest, NegotiateWildcardAndEmpty) {
+    EXPECT_EQ(Compression::negotiate("*"), ContentCoding::GZIP);
+    EXPECT_EQ(Compression::negotiate("*, gzip;q=0"), ContentCoding::DEFLATE);
+    EXPECT_EQ(Compression::negotiate(""), ContentCoding::IDENTITY);
+    EXPECT_EQ(Compression::negotiate("br"), ContentCoding::IDENTITY);
+}
+
+TEST(CompressionTest, RoundTrip) {
+    std::string body;
+    for (int i = 0; i < 200; ++i) {
+        body += "{\"player_name\":\"Player" + std::to_string(i) + "\",\"amount\":100},";
+    }
+    
+    for (auto coding : {ContentCoding::GZIP, ContentCoding::DEFLATE}) {
+        std::string compressed = Compression::compress(body, coding);
+        EXPECT_LT(compressed.size(), body.size());
+        EXPECT_EQ(Compression::decompress(compressed, coding), body);
+    }
+}
+
+TEST(CompressionTest, GzipHasMagicHeader) {
+    std::string compressed = Compression::compress(std::string(1000, 'a'), ContentCoding::GZIP);
+    ASSERT_GE(compressed.size(), 2u);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[1]), 0x8b);
+}
+
+TEST(CompressionTest, CachedBodyCompressedOnce) {
+    ResponseCache cache;
+    auto cached = cache.put("active-bets", 1, std::string(1000, 'x'));
+    
+    const std::string& first = cached->encoded_body(ContentCoding::GZIP);
+    const std::string& second = cached->encoded_body(ContentCoding::GZIP);
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(Compression::decompress(first, ContentCoding::GZIP), cached->body);
+    EXPECT_NE(cached->encoded_etag(ContentCoding::GZIP), cached->etag);
+}
+
+TEST(CompressionTest, SmallBodiesStayIdentity) {
+    ResponseCache cache;
+    auto cached = cache.put("old-crash-points", 1, "[1.5,2.3]");
+    EXPECT_EQ(cached->effective_coding(ContentCoding::GZIP), ContentCoding::IDENTITY);
+}
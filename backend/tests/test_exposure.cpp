@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "exposure.h"
+#include "game.h"
+#include <thread>
+#include <vector>
+
+TEST(ExposureTrackerTest, AggregatesBetCashoutAndSettle) {
+    ExposureTracker tracker;
+    tracker.on_bet(1, 100 * MONEY_SCALE);
+    tracker.on_bet(1, 50 * MONEY_SCALE);
+    tracker.on_cashout(1, 50 * MONEY_SCALE, 75 * MONEY_SCALE, 150);
+    
+    RoundAggregates round = tracker.get_round(1);
+    EXPECT_EQ(round.bets, 2u);
+    EXPECT_EQ(round.wagered, 150 * MONEY_SCALE);
+    EXPECT_EQ(round.active_stake, 100 * MONEY_SCALE);
+    EXPECT_EQ(round.paid_out, 75 * MONEY_SCALE);
+    EXPECT_EQ(round.liability(250), 250 * MONEY_SCALE);
+    EXPECT_EQ(round.cashout_histogram[ExposureTracker::histogram_bucket(150)], 1u);
+    
+    tracker.on_settle(1);
+    round = tracker.get_round(1);
+    EXPECT_EQ(round.active_stake, 0);
+    EXPECT_EQ(round.lost, 100 * MONEY_SCALE);
+}
+
+TEST(ExposureTrackerTest, NextRoundBetsSurviveRoundStart) {
+    ExposureTracker tracker;
+    tracker.on_bet(1, 10 * MONEY_SCALE);
+    tracker.on_bet(2, 20 * MONEY_SCALE);  // FLYING sırasında bir sonraki round'a
+    tracker.on_settle(1);
+    tracker.on_round_start(2);
+    
+    EXPECT_EQ(tracker.get_round(2).wagered, 20 * MONEY_SCALE);
+    EXPECT_EQ(tracker.get_round(3).bets, 0u);
+    RoundAggregates last = tracker.get_last_round();
+    EXPECT_EQ(last.round, 1);
+    EXPECT_EQ(last.lost, 10 * MONEY_SCALE);
+}
+
+TEST(ExposureTrackerTest, HistogramBuckets) {
+    EXPECT_EQ(ExposureTracker::histogram_bucket(101), 0u);
+    EXPECT_EQ(ExposureTracker::histogram_bucket(150), 1u);
+    EXPECT_EQ(ExposureTracker::histogram_bucket(499), 3u);
+    EXPECT_EQ(ExposureTracker::histogram_bucket(100000), EXPOSURE_BUCKETS - 1);
+}
+
+TEST(ExposureTrackerTest, ShardsMergeAcrossThreads) {
+    ExposureTracker tracker;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&tracker] {
+            for (int i = 0; i < 1000; i++) tracker.on_bet(1, 1);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(tracker.get_round(1).bets, 8000u);
+    EXPECT_EQ(tracker.get_round(1).wagered, 8000);
+}
+
+TEST(ExposureTrackerTest, GameMatchesBetScan) {
+    CrashGame game(true);
+    for (int i = 0; i < 4; i++) {
+        std::string id = "p" + std::to_string(i);
+        game.add_player(id, id);
+        ASSERT_TRUE(game.place_bet(id, (i + 1) * 10 * MONEY_SCALE));
+    }
+    game.start_flying_phase(3.0);
+    ASSERT_TRUE(game.cashout_at("p0", 2.0));
+    ASSERT_TRUE(game.place_bet("p1", 5 * MONEY_SCALE));  // Sonraki round
+    
+    int round = game.get_round();
+    RoundAggregates current = game.get_exposure().get_round(round);
+    EXPECT_EQ(current.wagered, 100 * MONEY_SCALE);
+    EXPECT_EQ(current.active_stake, 90 * MONEY_SCALE);
+    EXPECT_EQ(current.paid_out, 20 * MONEY_SCALE);
+    EXPECT_EQ(game.get_exposure().get_round(round + 1).wagered, 5 * MONEY_SCALE);
+    
+    json exposure = GameStateSerializer::serializeExposure(game);
+    EXPECT_EQ(exposure["current"]["bets"], 4);
+    EXPECT_DOUBLE_EQ(exposure["current"]["liability"].get<double>(), 90.0 * exposure["multiplier"].get<double>());
+    
+    game.end_game();
+    game.start_next_round();
+    RoundAggregates last = game.get_exposure().get_last_round();
+    EXPECT_EQ(last.round, round);
+    EXPECT_EQ(last.lost, 90 * MONEY_SCALE);
+    EXPECT_EQ(game.get_exposure().get_round(round + 1).wagered, 5 * MONEY_SCALE);
+}
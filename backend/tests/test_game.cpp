@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "game.h"
+#include "balance_import.h"
 #include <thread>
 #include <chrono>
 
@@ -30,7 +31,7 @@ TEST_F(GameTest, AddPlayer_Success) {
     ASSERT_NE(player, nullptr);
     EXPECT_EQ(player->get_id(), "player1");
     EXPECT_EQ(player->get_name(), "Ahmet");
-    EXPECT_EQ(player->get_balance(), 1000.0); // Default balance
+    EXPECT_EQ(player->get_balance(), 1000 * MONEY_SCALE); // Default balance
 }
 
 TEST_F(GameTest, AddPlayer_DuplicateId) {
@@ -49,23 +50,23 @@ TEST_F(GameTest, GetPlayer_NotFound) {
 TEST_F(GameTest, PlaceBet_Success) {
     game->add_player("player1", "Ahmet");
     
-    EXPECT_TRUE(game->place_bet("player1", 100.0));
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
     
     auto player = game->get_player("player1");
-    EXPECT_EQ(player->get_balance(), 900.0); // 1000 - 100
+    EXPECT_EQ(player->get_balance(), 900 * MONEY_SCALE); // 1000 - 100
 }
 
 TEST_F(GameTest, PlaceBet_InsufficientBalance) {
     game->add_player("player1", "Ahmet");
     
-    EXPECT_FALSE(game->place_bet("player1", 1500.0)); // 1000'den fazla
+    EXPECT_FALSE(game->place_bet("player1", 1500 * MONEY_SCALE)); // 1000'den fazla
     
     auto player = game->get_player("player1");
-    EXPECT_EQ(player->get_balance(), 1000.0); // Bakiye değişmemeli
+    EXPECT_EQ(player->get_balance(), 1000 * MONEY_SCALE); // Bakiye değişmemeli
 }
 
 TEST_F(GameTest, PlaceBet_PlayerNotFound) {
-    EXPECT_FALSE(game->place_bet("nonexistent", 100.0));
+    EXPECT_FALSE(game->place_bet("nonexistent", 100 * MONEY_SCALE));
 }
 
 TEST_F(GameTest, CrashPointGeneration) {
@@ -146,8 +147,8 @@ TEST_F(GameTest, FullGameCycle) {
     game->add_player("player2", "Mehmet");
     
     // Bahis yap
-    EXPECT_TRUE(game->place_bet("player1", 100.0));
-    EXPECT_TRUE(game->place_bet("player2", 200.0));
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->place_bet("player2", 200 * MONEY_SCALE));
     
     // FLYING phase'e geçmesini bekle
     while (game->get_phase() == GamePhase::WAITING) {
@@ -162,4 +163,192 @@ TEST_F(GameTest, FullGameCycle) {
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     game->update();
     EXPECT_GT(game->get_current_multiplier(), initial_multiplier);
-}
\ No newline at end of file
+}
+// ETag versiyonları - bahis ve geçmiş değiştikçe artmalı
+TEST_F(GameTest, VersionsAdvanceWithState) {
+    game->add_player("player1", "Ahmet");
+    
+    uint64_t bets_version = game->get_bets_version();
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    EXPECT_GT(game->get_bets_version(), bets_version);
+    
+    // FLYING'e geç ve round'u bitir
+    while (game->get_phase() == GamePhase::WAITING) {
+        game->update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    uint64_t history_version = game->get_history_version();
+    bets_version = game->get_bets_version();
+    game->end_game();
+    EXPECT_EQ(game->get_history_version(), history_version + 1);
+    EXPECT_GT(game->get_bets_version(), bets_version);
+}
+
+// Settlement liderlik tablolarını güncellemeli
+TEST_F(GameTest, SettlementUpdatesLeaderboards) {
+    game->add_player("player1", "Ahmet");
+    game->add_player("player2", "Mehmet");
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->place_bet("player2", 100 * MONEY_SCALE));
+    
+    while (game->get_phase() == GamePhase::WAITING) {
+        game->update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(game->cashout("player1"));
+    
+    uint64_t version = game->get_leaderboard_version();
+    game->end_game();
+    EXPECT_EQ(game->get_leaderboard_version(), version + 1);
+    
+    json leaderboard;
+    ASSERT_TRUE(game->get_leaderboard_json(leaderboard, version));
+    EXPECT_EQ(version, game->get_leaderboard_version());
+    ASSERT_EQ(leaderboard["round_top"].size(), 1u);
+    EXPECT_EQ(leaderboard["round_top"][0]["player_name"], "Ahmet");
+    EXPECT_EQ(leaderboard["all_time"].size(), 1u);
+    EXPECT_EQ(game->get_player("player1")->get_total_winnings(), 100 * MONEY_SCALE);
+}
+
+// Round bitince bahisler geçmişe yazılmalı
+TEST_F(GameTest, SettledBetsGoToHistory) {
+    game->add_player("player1", "Ahmet");
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    
+    while (game->get_phase() == GamePhase::WAITING) {
+        game->update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    game->end_game();
+    
+    json history;
+    ASSERT_TRUE(game->get_bet_history_json("player1", 0, 10, history));
+    ASSERT_EQ(history["bets"].size(), 1u);
+    EXPECT_EQ(history["bets"][0]["amount"], 100.0);
+    EXPECT_EQ(history["bets"][0]["status"], "crashed");
+    EXPECT_TRUE(history["next_cursor"].is_null());
+    
+    EXPECT_FALSE(game->get_bet_history_json("nobody", 0, 10, history));
+}
+
+// Bir sonraki round'a verilen bahisler round değişiminden sonra da geçerli kalmalı
+TEST_F(GameTest, NextRoundBetsSurviveRoundChange) {
+    game->add_player("player1", "Ahmet");
+    
+    while (game->get_phase() == GamePhase::WAITING) {
+        game->update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(game->place_bet("player1", 50 * MONEY_SCALE));  // FLYING: sonraki round'a
+    game->end_game();
+    
+    while (game->get_phase() != GamePhase::WAITING) {
+        game->update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(game->get_current_round(), 2);
+    
+    json bets;
+    game->get_current_bets_json(bets);
+    ASSERT_EQ(bets.size(), 1u);
+    EXPECT_EQ(bets[0]["player_name"], "Ahmet");
+    EXPECT_EQ(bets[0]["amount"], 50.0);
+}
+
+// Boşta kalan oyuncu bellekten atılmalı, bahsi olana dokunulmamalı; değişmiş bakiye sayfalanmalı
+TEST_F(GameTest, IdleSessionsExpire) {
+    game->set_session_ttl_ms(5000);
+    game->add_player("idle", "Ahmet");
+    game->add_player("betting", "Mehmet");
+    game->add_player("funded", "Ayşe");
+    EXPECT_TRUE(game->place_bet("betting", 100 * MONEY_SCALE));
+    game->get_player("funded")->add_balance(250 * MONEY_SCALE);  // Ör. toplu bakiye yükleme
+    
+    int64_t now = CrashGame::now_ms();
+    EXPECT_EQ(game->expire_idle_sessions(now + 1000), 0u);
+    EXPECT_EQ(game->expire_idle_sessions(now + 10000), 2u);
+    
+    EXPECT_EQ(game->get_player("idle"), nullptr);
+    std::shared_ptr<Player> player;
+    EXPECT_FALSE(game->get_player_by_name("Ahmet", player));
+    EXPECT_NE(game->get_player("betting"), nullptr);
+    EXPECT_EQ(game->get_player_count(), 1u);
+    EXPECT_EQ(game->get_player_store()->size(), 1u);
+    EXPECT_EQ(game->get_evicted_session_count(), 2u);
+    
+    // Sayfalanan oyuncu id'siyle sorulunca bakiyesiyle geri gelir
+    ASSERT_NE(game->get_player("funded"), nullptr);
+    EXPECT_EQ(game->get_player("funded")->get_balance(), 1250 * MONEY_SCALE);
+    EXPECT_EQ(game->get_player_count(), 2u);
+    EXPECT_EQ(game->get_player_store()->size(), 0u);
+    
+    // Bahsi settle olunca o da atılır; tekrar katılınca bakiyesi korunur
+    game->start_flying_phase();
+    game->end_game();
+    game->start_next_round();
+    EXPECT_EQ(game->expire_idle_sessions(now + 20000), 2u);
+    EXPECT_EQ(game->get_player_count(), 0u);
+    EXPECT_EQ(game->get_player_store()->size(), 2u);
+    EXPECT_FALSE(game->add_player("betting", "Mehmet"));
+    EXPECT_EQ(game->get_player("betting")->get_balance(), 900 * MONEY_SCALE);
+    
+    // Sayfalanan oyuncunun ismi başkasına verilmez: isimle sorulunca geri yüklenir
+    ASSERT_TRUE(game->get_player_by_name("Ayşe", player));
+    EXPECT_EQ(player->get_id(), "funded");
+    EXPECT_EQ(game->get_player_store()->size(), 0u);
+    
+    // Başlangıç bakiyesindeki oyuncunun ismi tekrar kullanılabilir
+    EXPECT_TRUE(game->add_player("idle2", "Ahmet"));
+    EXPECT_TRUE(game->get_player_by_name("Ahmet", player));
+    EXPECT_EQ(player->get_id(), "idle2");
+}
+
+// Toplu yükleme sayfalanmış oyuncuyu belleğe almadan kaydına eklemeli
+TEST_F(GameTest, LoadBalanceCreditsPagedPlayers) {
+    game->set_session_ttl_ms(5000);
+    game->add_player("p1", "Ahmet");
+    EXPECT_TRUE(game->load_balance("p1", 10 * MONEY_SCALE));
+    EXPECT_EQ(game->expire_idle_sessions(CrashGame::now_ms() + 10000), 1u);
+    
+    EXPECT_TRUE(game->load_balance("p1", 5 * MONEY_SCALE));
+    BalanceImportReport report;
+    game->load_balances({BalanceCredit{1, "Ahmet", 2 * MONEY_SCALE}}, report);
+    EXPECT_EQ(report.credited, 1u);
+    EXPECT_EQ(game->get_player_count(), 0u);
+    
+    ASSERT_NE(game->get_player("p1"), nullptr);
+    EXPECT_EQ(game->get_player("p1")->get_balance(), 1017 * MONEY_SCALE);
+}
+
+// Aynı oyuncunun birden fazla bahsi sırayla cashout edilmeli
+TEST_F(GameTest, CashoutWalksPlayersBets) {
+    game->add_player("player1", "Ahmet");
+    game->add_player("player2", "Mehmet");
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->place_bet("player2", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->place_bet("player1", 50 * MONEY_SCALE));
+    
+    game->start_flying_phase();
+    EXPECT_TRUE(game->cashout("player1"));
+    EXPECT_TRUE(game->cashout("player1"));
+    EXPECT_FALSE(game->cashout("player1"));
+    EXPECT_TRUE(game->cashout("player2"));
+    EXPECT_FALSE(game->cashout("nobody"));
+}
+
+// Açık bahis bilgisi cashout ve crash sonrası temizlenmeli
+TEST_F(GameTest, ActiveBetClearsAfterSettlement) {
+    game->add_player("player1", "Ahmet");
+    game->add_player("player2", "Mehmet");
+    EXPECT_TRUE(game->place_bet("player1", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->place_bet("player2", 100 * MONEY_SCALE));
+    EXPECT_TRUE(game->has_active_bet("player1"));
+    
+    game->start_flying_phase();
+    EXPECT_TRUE(game->cashout("player1"));
+    EXPECT_FALSE(game->has_active_bet("player1"));
+    EXPECT_TRUE(game->has_active_bet("player2"));
+    
+    game->end_game();
+    EXPECT_FALSE(game->has_active_bet("player2"));
+}
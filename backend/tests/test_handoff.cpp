@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "handoff.h"
+#include "game.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <filesystem>
+#include <thread>
+
+TEST(HandoffTest, PassesStateAndFileDescriptors) {
+    int pair[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    int pipe_fds[2];
+    ASSERT_EQ(::pipe(pipe_fds), 0);
+
+    // Soket tamponundan büyük gövde: gönderen, alıcı okurken parça parça yazar
+    std::string state(300 * 1024, 'x');
+    state[12345] = 'y';
+    std::thread sender([&] {
+        handoff::send_message(pair[0], handoff::MessageType::STATE, state, {pipe_fds[1]});
+        handoff::send_message(pair[0], handoff::MessageType::ACK, {});
+    });
+
+    std::string payload;
+    std::vector<int> fds;
+    EXPECT_EQ(handoff::receive_message(pair[1], payload, fds, 5000), handoff::MessageType::STATE);
+    EXPECT_EQ(payload, state);
+    ASSERT_EQ(fds.size(), 1u);
+    int passed = fds[0];
+    EXPECT_EQ(handoff::receive_message(pair[1], payload, fds, 5000), handoff::MessageType::ACK);
+    EXPECT_TRUE(payload.empty());
+    EXPECT_TRUE(fds.empty());
+    sender.join();
+
+    // Gelen fd aynı pipe'ın yazma ucu
+    ::close(pipe_fds[1]);
+    ASSERT_EQ(::write(passed, "!", 1), 1);
+    ::close(passed);
+    char byte = 0;
+    EXPECT_EQ(::read(pipe_fds[0], &byte, 1), 1);
+    EXPECT_EQ(byte, '!');
+    ::close(pipe_fds[0]);
+
+    // Zaman aşımı ve kopan bağlantı exception
+    EXPECT_THROW(handoff::receive_message(pair[1], payload, fds, 50), std::runtime_error);
+    ::close(pair[0]);
+    EXPECT_THROW(handoff::receive_message(pair[1], payload, fds, 1000), std::runtime_error);
+    ::close(pair[1]);
+}
+
+TEST(HandoffTest, ConnectFindsRunningProcessOnly) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("crash_handoff_" + std::to_string(::getpid()) + ".sock")).string();
+    std::filesystem::remove(path);
+    EXPECT_EQ(handoff::connect(path), -1);  // Soğuk başlangıç
+
+    int listen_fd = handoff::listen(path);
+    int client = handoff::connect(path);
+    ASSERT_GE(client, 0);
+    int successor = handoff::accept(listen_fd, 1000);
+    ASSERT_GE(successor, 0);
+    EXPECT_EQ(handoff::accept(listen_fd, 10), -1);
+
+    // Sahibi kapanmış dosya da soğuk başlangıç
+    ::close(successor);
+    ::close(client);
+    ::close(listen_fd);
+    EXPECT_EQ(handoff::connect(path), -1);
+    std::filesystem::remove(path);
+}
+
+TEST(HandoffTest, RetiredListenerStopsAcceptingButKeepsItsFd) {
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(listen_fd, 8), 0);
+    socklen_t length = sizeof(addr);
+    ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &length);
+
+    EXPECT_EQ(handoff::retire_listeners(ntohs(addr.sin_port)), 1u);
+    // fd numarası sahibinde geçerli, ama port artık dinlenmiyor
+    EXPECT_GE(::fcntl(listen_fd, F_GETFD), 0);
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), -1);
+    EXPECT_EQ(errno, ECONNREFUSED);
+    ::close(client);
+    ::close(listen_fd);
+}
+
+TEST(HandoffTest, CountsAndClosesIdleConnectionsAfterRetire) {
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(listen_fd, 8), 0);
+    socklen_t length = sizeof(addr);
+    ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    uint16_t port = ntohs(addr.sin_port);
+
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    int accepted = ::accept(listen_fd, nullptr, nullptr);
+    ASSERT_GE(accepted, 0);
+
+    // İstemci tarafı (yerel portu geçici) ve dinleyici sayılmaz
+    EXPECT_EQ(handoff::open_connections(port), 1u);
+    EXPECT_EQ(handoff::retire_listeners(port), 1u);
+    EXPECT_EQ(handoff::open_connections(port), 1u);
+
+    // Boştaki keep-alive bağlantı kapatılır: istemci EOF görür, fd sahibinde kalır
+    EXPECT_EQ(handoff::close_connections(port), 1u);
+    char byte;
+    EXPECT_EQ(::recv(client, &byte, 1, 0), 0);
+    EXPECT_GE(::fcntl(accepted, F_GETFD), 0);
+
+    ::close(accepted);
+    EXPECT_EQ(handoff::open_connections(port), 0u);
+    ::close(client);
+    ::close(listen_fd);
+}
+
+TEST(HandoffTest, GameStateSurvivesExportAndImport) {
+    CrashGame game(true);
+    game.add_player("p1", "ali");
+    game.add_player("p2", "veli");
+    ASSERT_TRUE(game.place_bet("p1", 10000));
+    game.start_flying_phase(2.0);
+    json state;
+    EXPECT_THROW(game.export_state(state), std::runtime_error);  // Uçuş yarıda devredilmez
+
+    ASSERT_TRUE(game.cashout_at("p1", 1.5));
+    game.end_game();
+    ASSERT_TRUE(game.place_bet("p2", 5000));  // Sonraki round'a
+    game.export_state(state);
+
+    // Kablo biçimi CBOR
+    CrashGame successor(true);
+    successor.import_state(json::from_cbor(json::to_cbor(state)));
+    EXPECT_EQ(successor.get_phase(), GamePhase::CRASHED);
+    EXPECT_EQ(successor.get_current_round(), game.get_current_round());
+    EXPECT_EQ(successor.get_status_version(), game.get_status_version());
+    EXPECT_EQ(successor.get_bets_version(), game.get_bets_version());
+    EXPECT_EQ(successor.get_old_crash_points(), game.get_old_crash_points());
+    EXPECT_EQ(successor.balance_checksum(), game.balance_checksum());
+    EXPECT_EQ(successor.get_player("p1")->get_total_winnings(), game.get_player("p1")->get_total_winnings());
+    json boards, expected_boards;
+    uint64_t boards_version = 0, expected_version = 0;
+    EXPECT_TRUE(successor.get_leaderboard_json(boards, boards_version));
+    EXPECT_TRUE(game.get_leaderboard_json(expected_boards, expected_version));
+    EXPECT_EQ(boards, expected_boards);
+    EXPECT_EQ(boards_version, expected_version);
+    std::shared_ptr<Player> by_name;
+    EXPECT_TRUE(successor.get_player_by_name("veli", by_name));
+
+    // Devralınan bekleyen bahis sonraki round'da aktif
+    successor.start_next_round();
+    EXPECT_EQ(successor.get_active_bet_count(), 1);
+    EXPECT_TRUE(successor.has_active_bet("p2"));
+
+    EXPECT_THROW(successor.import_state(state), std::runtime_error);  // Boş olmayan oyuna yüklenmez
+}
+
+TEST(HandoffTest, DetectsSuccessorLeavingAndLateAck) {
+    int pair[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    EXPECT_TRUE(handoff::peer_alive(pair[0]));
+    
+    // Eski süreç vazgeçmeden önce yazılan ACK kapanıştan sonra da okunur
+    handoff::send_message(pair[1], handoff::MessageType::ACK, {});
+    ::shutdown(pair[0], SHUT_RDWR);
+    std::string payload;
+    std::vector<int> fds;
+    EXPECT_EQ(handoff::receive_message(pair[0], payload, fds, 100), handoff::MessageType::ACK);
+    // Sonrasında ardıl yazamaz: oyunu açmadan çıkar
+    EXPECT_THROW(handoff::send_message(pair[1], handoff::MessageType::ACK, {}), std::runtime_error);
+    ::close(pair[0]);
+    ::close(pair[1]);
+    
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    ::close(pair[1]);  // Ardıl round bitmeden çöktü
+    EXPECT_FALSE(handoff::peer_alive(pair[0]));
+    ::close(pair[0]);
+}
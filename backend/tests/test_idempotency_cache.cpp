@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "idempotency_cache.h"
+#include <string>
+
+TEST(IdempotencyCacheTest, RetryReturnsFirstResult) {
+    IdempotencyCache cache;
+    EXPECT_EQ(cache.begin("p1", "key-1", 7, 0), IdempotencyStatus::NEW);
+    EXPECT_EQ(cache.begin("p1", "key-1", 7, 1), IdempotencyStatus::IN_PROGRESS);
+    
+    cache.complete("p1", "key-1", true, 2);
+    EXPECT_EQ(cache.begin("p1", "key-1", 7, 3), IdempotencyStatus::SUCCEEDED);
+    
+    EXPECT_EQ(cache.begin("p1", "key-2", 7, 3), IdempotencyStatus::NEW);
+    cache.complete("p1", "key-2", false, 4);
+    EXPECT_EQ(cache.begin("p1", "key-2", 7, 5), IdempotencyStatus::FAILED);
+    
+    IdempotencyStats stats = cache.get_stats();
+    EXPECT_EQ(stats.accepted, 2u);
+    EXPECT_EQ(stats.replayed, 2u);
+    EXPECT_EQ(stats.conflicts, 1u);
+}
+
+TEST(IdempotencyCacheTest, KeysAreScopedPerPlayer) {
+    IdempotencyCache cache;
+    EXPECT_EQ(cache.begin("p1", "retry", 1, 0), IdempotencyStatus::NEW);
+    EXPECT_EQ(cache.begin("p2", "retry", 1, 0), IdempotencyStatus::NEW);
+    // Ayırıcı: "p1"+"2x" ile "p12"+"x" aynı anahtar değil
+    EXPECT_EQ(cache.begin("p1", "2x", 1, 0), IdempotencyStatus::NEW);
+    EXPECT_EQ(cache.begin("p12", "x", 1, 0), IdempotencyStatus::NEW);
+}
+
+TEST(IdempotencyCacheTest, DifferentRequestWithSameKeyIsRejected) {
+    IdempotencyCache cache;
+    cache.begin("p1", "key", 100, 0);
+    cache.complete("p1", "key", true, 0);
+    EXPECT_EQ(cache.begin("p1", "key", 200, 1), IdempotencyStatus::MISMATCH);
+}
+
+TEST(IdempotencyCacheTest, EntriesExpireAfterTtl) {
+    IdempotencyCache cache(IdempotencyConfig{64, 1000});
+    cache.begin("p1", "key", 1, 0);
+    cache.complete("p1", "key", true, 0);
+    EXPECT_EQ(cache.begin("p1", "key", 1, 999), IdempotencyStatus::SUCCEEDED);
+    EXPECT_EQ(cache.begin("p1", "key", 1, 1000), IdempotencyStatus::NEW);
+}
+
+TEST(IdempotencyCacheTest, MemoryStaysFixedUnderChurn) {
+    IdempotencyCache cache(IdempotencyConfig{64, 60000});
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(cache.begin("p", std::to_string(i), 1, i), IdempotencyStatus::NEW);
+        cache.complete("p", std::to_string(i), true, i);
+    }
+    EXPECT_EQ(cache.capacity(), 64u);
+    EXPECT_GT(cache.get_stats().evicted, 0u);
+    // En yeni anahtar hâlâ tanınır
+    EXPECT_EQ(cache.begin("p", "9999", 1, 10000), IdempotencyStatus::SUCCEEDED);
+}
+
+TEST(IdempotencyCacheTest, InProgressEntriesAreNeverEvicted) {
+    // 8 slotluk tablo: her anahtar aynı (tek) pencereye düşer
+    IdempotencyCache cache(IdempotencyConfig{8, 60000});
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(cache.begin("p", std::to_string(i), 1, 0), IdempotencyStatus::NEW);
+    }
+    EXPECT_EQ(cache.begin("p", "late", 1, 1), IdempotencyStatus::FULL);
+    EXPECT_EQ(cache.get_stats().full, 1u);
+    EXPECT_EQ(cache.get_stats().evicted, 0u);
+    // İşlenen istekler hâlâ tanınır: tekrarları ikinci kez işlenmez
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(cache.begin("p", std::to_string(i), 1, 2), IdempotencyStatus::IN_PROGRESS);
+    }
+
+    // Biri tamamlanınca onun yeri açılır, işlenenlere yine dokunulmaz
+    cache.complete("p", "3", true, 3);
+    EXPECT_EQ(cache.begin("p", "late", 1, 4), IdempotencyStatus::NEW);
+    EXPECT_EQ(cache.get_stats().evicted, 1u);
+    EXPECT_EQ(cache.begin("p", "3", 1, 5), IdempotencyStatus::FULL);  // Tamamlanan silinmişti, pencere yine dolu
+    EXPECT_EQ(cache.begin("p", "0", 1, 5), IdempotencyStatus::IN_PROGRESS);
+}
+
+TEST(IdempotencyCacheTest, ForgetAllowsRetryAfterFailure) {
+    IdempotencyCache cache;
+    cache.begin("p1", "key", 1, 0);
+    cache.forget("p1", "key");
+    EXPECT_EQ(cache.begin("p1", "key", 1, 1), IdempotencyStatus::NEW);
+}
+
+TEST(IdempotencyCacheTest, CompletedEntriesSurviveHandoff) {
+    IdempotencyCache cache(IdempotencyConfig{1024, 1000});
+    cache.begin("p1", "done", 7, 0);
+    cache.complete("p1", "done", true, 0);
+    cache.begin("p1", "pending", 7, 0);  // Yarım kalan devredilmez
+    cache.begin("p2", "old", 7, -900);
+    cache.complete("p2", "old", false, -900);  // Devir anında süresi dolmuş
+
+    // Ardılın tablosu daha küçük olabilir
+    IdempotencyCache successor(IdempotencyConfig{64, 1000});
+    EXPECT_EQ(successor.restore_entries(cache.save_entries(200), 200), 1u);
+    EXPECT_EQ(successor.begin("p1", "done", 7, 300), IdempotencyStatus::SUCCEEDED);
+    EXPECT_EQ(successor.begin("p1", "pending", 7, 300), IdempotencyStatus::NEW);
+    EXPECT_EQ(successor.begin("p2", "old", 7, 300), IdempotencyStatus::NEW);
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include "json_utils.h"
+
+TEST(JsonUtilsTest, PeekStringFindsValue) {
+    EXPECT_EQ(JsonUtils::peekString("{\"player_id\":\"player_abc\",\"amount\":10}", "player_id"), "player_abc");
+    EXPECT_EQ(JsonUtils::peekString("{ \"amount\": 10, \"player_id\" : \"p1\" }", "player_id"), "p1");
+}
+
+TEST(JsonUtilsTest, PeekStringMissingOrMalformed) {
+    EXPECT_EQ(JsonUtils::peekString("", "player_id"), "");
+    EXPECT_EQ(JsonUtils::peekString("{\"amount\":10}", "player_id"), "");
+    EXPECT_EQ(JsonUtils::peekString("{\"player_id\":42}", "player_id"), "");
+    EXPECT_EQ(JsonUtils::peekString("{\"player_id\":\"unterminated", "player_id"), "");
+    EXPECT_EQ(JsonUtils::peekString("{\"player_id\":\"a\\\"b\"}", "player_id"), "");
+}
+
+TEST(JsonUtilsTest, GetMoneyConvertsToKurus) {
+    Money amount = 0;
+    EXPECT_TRUE(JsonUtils::getMoney(json::parse("{\"amount\":100}"), "amount", amount));
+    EXPECT_EQ(amount, 100 * MONEY_SCALE);
+    EXPECT_TRUE(JsonUtils::getMoney(json::parse("{\"amount\":12.34}"), "amount", amount));
+    EXPECT_EQ(amount, 1234);
+    EXPECT_TRUE(JsonUtils::getMoney(json::parse("{\"amount\":0.1}"), "amount", amount));
+    EXPECT_EQ(amount, 10);
+    
+    EXPECT_FALSE(JsonUtils::getMoney(json::parse("{\"amount\":12.345}"), "amount", amount));
+    EXPECT_FALSE(JsonUtils::getMoney(json::parse("{\"amount\":-5}"), "amount", amount));
+    EXPECT_FALSE(JsonUtils::getMoney(json::parse("{\"amount\":\"10\"}"), "amount", amount));
+    EXPECT_FALSE(JsonUtils::getMoney(json::parse("{\"amount\":1e300}"), "amount", amount));
+    EXPECT_FALSE(JsonUtils::getMoney(json::parse("{}"), "amount", amount));
+}
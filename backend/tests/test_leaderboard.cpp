@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "leaderboard.h"
+
+TEST(TopKTest, KeepsHighestValues) {
+    TopK board(3);
+    board.offer("p1", "Ahmet", 100);
+    board.offer("p2", "Mehmet", 300);
+    board.offer("p3", "Ayse", 200);
+    board.offer("p4", "Fatma", 50);   // Listeye giremez
+    board.offer("p5", "Ali", 250);    // Ahmet'i çıkarır
+    
+    auto top = board.top();
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].name, "Mehmet");
+    EXPECT_EQ(top[1].name, "Ali");
+    EXPECT_EQ(top[2].name, "Ayse");
+}
+
+TEST(TopKTest, UpdatesExistingMember) {
+    TopK board(2);
+    board.offer("p1", "Ahmet", 100);
+    board.offer("p2", "Mehmet", 200);
+    board.offer("p1", "Ahmet", 500);
+    
+    auto top = board.top();
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].player_id, "p1");
+    EXPECT_EQ(top[0].value, 500);
+}
+
+TEST(LeaderboardsTest, RoundBoardResetsEachSettlement) {
+    Leaderboards boards(5);
+    boards.begin_settlement(1, 100);
+    boards.record_win("p1", "Ahmet", 150, 150);
+    boards.end_settlement();
+    
+    boards.begin_settlement(2, 100);
+    boards.record_win("p2", "Mehmet", 80, 80);
+    boards.end_settlement();
+    
+    auto round_top = boards.get_round_top();
+    ASSERT_EQ(round_top.size(), 1u);
+    EXPECT_EQ(round_top[0].name, "Mehmet");
+    EXPECT_EQ(boards.get_settled_round(), 2);
+    EXPECT_EQ(boards.get_daily_top().size(), 2u);
+    EXPECT_EQ(boards.get_version(), 2u);
+}
+
+TEST(LeaderboardsTest, SnapshotMarksSettlementInProgress) {
+    Leaderboards boards(5);
+    boards.begin_settlement(1, 100);
+    boards.record_win("p1", "Ahmet", 150, 150);
+    boards.end_settlement();
+    
+    // Yarıdaki settlement: yeni round'un kazananları eski versiyonla görünür, önbelleğe girmemeli
+    boards.begin_settlement(2, 100);
+    boards.record_win("p2", "Mehmet", 80, 80);
+    LeaderboardSnapshot partial = boards.snapshot();
+    EXPECT_TRUE(partial.settling);
+    EXPECT_EQ(partial.version, 1u);
+    boards.end_settlement();
+    
+    LeaderboardSnapshot settled = boards.snapshot();
+    EXPECT_FALSE(settled.settling);
+    EXPECT_EQ(settled.version, 2u);
+    EXPECT_EQ(settled.settled_round, 2);
+    ASSERT_EQ(settled.round_top.size(), 1u);
+    EXPECT_EQ(settled.round_top[0].name, "Mehmet");
+    EXPECT_EQ(settled.daily_top.size(), 2u);
+    EXPECT_EQ(settled.all_time_top.size(), 2u);
+}
+
+TEST(LeaderboardsTest, DailyAccumulatesAndRollsOver) {
+    Leaderboards boards(5);
+    boards.begin_settlement(1, 100);
+    boards.record_win("p1", "Ahmet", 100, 100);
+    boards.record_win("p1", "Ahmet", 50, 150);  // Aynı round'da ikinci bahis
+    boards.end_settlement();
+    
+    auto daily = boards.get_daily_top();
+    ASSERT_EQ(daily.size(), 1u);
+    EXPECT_EQ(daily[0].value, 150);
+    EXPECT_EQ(boards.get_round_top()[0].value, 150);
+    
+    // Yeni gün: günlük tablo sıfırlanır, tüm zamanlar korunur
+    boards.begin_settlement(2, 101);
+    boards.record_win("p2", "Mehmet", 20, 20);
+    boards.end_settlement();
+    
+    daily = boards.get_daily_top();
+    ASSERT_EQ(daily.size(), 1u);
+    EXPECT_EQ(daily[0].name, "Mehmet");
+    
+    auto all_time = boards.get_all_time_top();
+    ASSERT_EQ(all_time.size(), 2u);
+    EXPECT_EQ(all_time[0].name, "Ahmet");
+    EXPECT_EQ(all_time[0].value, 150);
+}
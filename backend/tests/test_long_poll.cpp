@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "long_poll.h"
+#include "game.h"
+#include "json_utils.h"
+#include "shm_state.h"
+#include <string>
+
+TEST(LongPollQueueTest, ParksOnlyAtCurrentVersion) {
+    LongPollQueue<std::string> queue(10, 1000);
+    queue.advance(5);
+    
+    std::string stale = "stale";
+    EXPECT_FALSE(queue.park(4, stale, 0));
+    EXPECT_EQ(stale, "stale");  // Bekletilmediyse çağıran cevaplar
+    
+    // Primary yeniden başlayıp sıfırdan saydıysa ileri versiyon da hemen cevaplanır
+    std::string ahead = "ahead";
+    EXPECT_FALSE(queue.park(9, ahead, 0));
+    
+    std::string current = "current";
+    EXPECT_TRUE(queue.park(5, current, 0));
+    EXPECT_EQ(queue.get_stats().parked, 1u);
+}
+
+TEST(LongPollQueueTest, AdvanceWakesAllWaitersOnce) {
+    LongPollQueue<int> queue(10, 1000);
+    for (int i = 0; i < 3; i++) {
+        int waiter = i;
+        ASSERT_TRUE(queue.park(0, waiter, 0));
+    }
+    
+    EXPECT_TRUE(queue.advance(0).empty());  // Versiyon değişmedi
+    auto woken = queue.advance(1);
+    ASSERT_EQ(woken.size(), 3u);
+    EXPECT_EQ(woken[0], 0);
+    EXPECT_EQ(woken[2], 2);
+    EXPECT_TRUE(queue.advance(2).empty());
+    
+    LongPollStats stats = queue.get_stats();
+    EXPECT_EQ(stats.parked, 0u);
+    EXPECT_EQ(stats.woken, 3u);
+}
+
+TEST(LongPollQueueTest, ExpiresInDeadlineOrder) {
+    LongPollQueue<int> queue(10, 100);
+    int first = 1, second = 2;
+    queue.park(0, first, 0);
+    queue.park(0, second, 50);
+    
+    EXPECT_TRUE(queue.expire(99).empty());
+    auto expired = queue.expire(100);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0], 1);
+    EXPECT_EQ(queue.expire(150).size(), 1u);
+    EXPECT_EQ(queue.get_stats().timed_out, 2u);
+}
+
+TEST(LongPollQueueTest, RejectsWhenFull) {
+    LongPollQueue<int> queue(2, 1000);
+    int a = 1, b = 2, c = 3;
+    EXPECT_TRUE(queue.park(0, a, 0));
+    EXPECT_TRUE(queue.park(0, b, 0));
+    EXPECT_FALSE(queue.park(0, c, 0));
+    EXPECT_EQ(queue.get_stats().rejected, 1u);
+}
+
+TEST(LongPollQueueTest, StatusVersionFollowsGame) {
+    CrashGame game(true);
+    game.add_player("p1", "Oyuncu");
+    uint64_t waiting = game.get_status_version();
+    
+    ASSERT_TRUE(game.place_bet("p1", 10 * MONEY_SCALE));
+    uint64_t after_bet = game.get_status_version();
+    EXPECT_GT(after_bet, waiting);
+    
+    game.start_flying_phase(2.0);
+    EXPECT_GT(game.get_status_version(), after_bet);
+    uint64_t flying = game.get_status_version();
+    game.end_game();
+    EXPECT_GT(game.get_status_version(), flying);
+}
+
+TEST(LongPollQueueTest, CutoffDownsamplesStaleWaiters) {
+    LongPollQueue<int> queue(10, 1000);
+    int early = 1, late = 2;
+    queue.park(0, early, 0);
+    queue.park(0, late, 200);
+    
+    // Sadece cutoff'tan önce park edenler döner; diğeri bayat kalır
+    auto woken = queue.advance(1, 100);
+    ASSERT_EQ(woken.size(), 1u);
+    EXPECT_EQ(woken[0], 1);
+    
+    // Versiyon değişmese de cutoff geçince bayat bekleyen alınır
+    EXPECT_TRUE(queue.advance(1, 150).empty());
+    woken = queue.advance(1, 200);
+    ASSERT_EQ(woken.size(), 1u);
+    EXPECT_EQ(woken[0], 2);
+    
+    // Güncel versiyonla park eden cutoff ne olursa olsun bekler
+    int current = 3;
+    ASSERT_TRUE(queue.park(1, current, 300));
+    EXPECT_TRUE(queue.advance(1).empty());
+}
+
+// Tick'ler arası bahis canlı versiyonu ilerletir; status cevabı yayınlanan snapshot'tan
+// geldiği için istemcinin döndürülen versiyonla gelişi hemen cevaplanmaz, park edilir
+TEST(LongPollQueueTest, StatusVersionMovesBetweenTicks) {
+    CrashGame game(true);
+    game.add_player("p1", "Oyuncu");
+    LongPollQueue<std::string> queue(10, 1000);
+    LatestSnapshot latest;
+    auto publish_tick = [&]() {
+        GameSnapshot snapshot = GameStateSerializer::captureSnapshot(game);
+        latest.store(snapshot);
+        queue.advance(snapshot.status_version);
+    };
+    publish_tick();
+    
+    ASSERT_TRUE(game.place_bet("p1", 10 * MONEY_SCALE));
+    ASSERT_NE(game.get_status_version(), queue.get_version());  // Canlı versiyon öne geçti
+    std::string live = "live";
+    EXPECT_FALSE(queue.park(game.get_status_version(), live, 0));
+    
+    GameSnapshot snapshot;
+    ASSERT_TRUE(latest.load(snapshot));
+    json reply = GameStateSerializer::serializeSnapshot(snapshot, snapshot.published_at_ms);
+    std::string waiter = "waiter";
+    EXPECT_TRUE(queue.park(reply["version"].get<uint64_t>(), waiter, 0));
+    
+    // Sonraki tick bahsi yayınlar ve bekleyeni uyandırır
+    publish_tick();
+    auto woken = queue.advance(queue.get_version());
+    EXPECT_TRUE(woken.empty());  // publish_tick içinde zaten uyandırıldı
+    EXPECT_EQ(queue.get_stats().woken, 1u);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "player_store.h"
+#include <cstdio>
+#include <unistd.h>
+
+class PlayerStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "/tmp/crash_player_store_test_" + std::to_string(::getpid()) + ".bin";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+        std::remove((path + ".compact").c_str());
+    }
+
+    std::string path;
+};
+
+TEST_F(PlayerStoreTest, TakeRemovesAndCreditUpdatesInPlace) {
+    PlayerStore store;
+    store.put(DormantPlayer{"p1", "Ali", 1500, 700});
+    store.put(DormantPlayer{"p2", "Veli", 200, 0});
+    EXPECT_EQ(store.size(), 2u);
+
+    std::string player_id;
+    ASSERT_TRUE(store.find_id_by_name("Veli", player_id));
+    EXPECT_EQ(player_id, "p2");
+    EXPECT_FALSE(store.find_id_by_name("Ayşe", player_id));
+    EXPECT_TRUE(store.credit("p2", 50));
+    EXPECT_FALSE(store.credit("p3", 50));
+
+    DormantPlayer player;
+    ASSERT_TRUE(store.take("p2", player));
+    EXPECT_EQ(player.name, "Veli");
+    EXPECT_EQ(player.balance, 250);
+    EXPECT_FALSE(store.take("p2", player));
+    EXPECT_FALSE(store.contains("p2"));
+    EXPECT_TRUE(store.contains("p1"));
+    EXPECT_EQ(store.size(), 1u);
+}
+
+TEST_F(PlayerStoreTest, ResumeKeepsRecordsColdStartDropsThem) {
+    {
+        PlayerStore store(path);
+        store.put(DormantPlayer{"p1", "Ali", 1500, 700});
+        store.put(DormantPlayer{"p2", "Veli", 200, 0});
+        DormantPlayer player;
+        ASSERT_TRUE(store.take("p1", player));
+    }
+    // Yarım kalan son kayıt atılmalı
+    FILE* file = std::fopen(path.c_str(), "ab");
+    ASSERT_NE(file, nullptr);
+    std::fwrite("\x01\x02\x03", 1, 3, file);
+    std::fclose(file);
+
+    {
+        PlayerStore store(path, true);
+        EXPECT_EQ(store.size(), 1u);
+        EXPECT_FALSE(store.contains("p1"));
+        store.put(DormantPlayer{"p3", "Ayşe", 900, 100});
+
+        DormantPlayer player;
+        ASSERT_TRUE(store.take("p2", player));
+        EXPECT_EQ(player.balance, 200);
+        ASSERT_TRUE(store.take("p3", player));
+        EXPECT_EQ(player.name, "Ayşe");
+        EXPECT_EQ(player.total_winnings, 100);
+        store.put(DormantPlayer{"p4", "Zeynep", 10, 0});
+    }
+
+    PlayerStore resumed(path, true);
+    EXPECT_EQ(resumed.size(), 1u);
+    EXPECT_TRUE(resumed.contains("p4"));
+
+    PlayerStore cold(path);
+    EXPECT_EQ(cold.size(), 0u);
+    EXPECT_EQ(cold.file_bytes(), 0u);
+}
+
+TEST_F(PlayerStoreTest, CompactsDeadRecords) {
+    PlayerStore store(path);
+    store.put(DormantPlayer{"keep", "Kalan", 4200, 0});
+    // Aynı oyuncu binlerce kez sayfalanıp geri yüklenir; dosya sınırsız büyümemeli
+    DormantPlayer player;
+    for (int i = 0; i < 50000; i++) {
+        store.put(DormantPlayer{"p" + std::to_string(i % 10), "Oyuncu " + std::to_string(i % 10), i, 0});
+        ASSERT_TRUE(store.take("p" + std::to_string(i % 10), player));
+    }
+    EXPECT_LT(store.file_bytes(), 2 * PlayerStore::COMPACT_MIN_DEAD_BYTES);
+    EXPECT_EQ(store.size(), 1u);
+
+    PlayerStore resumed(path, true);
+    ASSERT_TRUE(resumed.take("keep", player));
+    EXPECT_EQ(player.balance, 4200);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "rate_limiter.h"
+#include <thread>
+#include <vector>
+#include <atomic>
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    RateLimitConfig config{2.0, 4.0, 1024};  // 2 token/sn, kapasite 4
+};
+
+TEST_F(RateLimiterTest, BurstThenReject) {
+    RateLimiter limiter(config);
+    
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(limiter.try_acquire("player1", 1000));
+    }
+    EXPECT_FALSE(limiter.try_acquire("player1", 1000));
+}
+
+TEST_F(RateLimiterTest, RefillsOverTime) {
+    RateLimiter limiter(config);
+    
+    for (int i = 0; i < 4; ++i) limiter.try_acquire("player1", 1000);
+    EXPECT_FALSE(limiter.try_acquire("player1", 1000));
+    
+    // 500ms'de 1 token dolar
+    EXPECT_TRUE(limiter.try_acquire("player1", 1500));
+    EXPECT_FALSE(limiter.try_acquire("player1", 1500));
+    
+    // Uzun bekleme kapasiteyi aşmaz
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(limiter.try_acquire("player1", 100000));
+    }
+    EXPECT_FALSE(limiter.try_acquire("player1", 100000));
+}
+
+TEST_F(RateLimiterTest, KeysAreIndependent) {
+    RateLimiter limiter(config);
+    
+    for (int i = 0; i < 4; ++i) limiter.try_acquire("flooder", 1000);
+    EXPECT_FALSE(limiter.try_acquire("flooder", 1000));
+    EXPECT_TRUE(limiter.try_acquire("innocent", 1000));
+}
+
+TEST_F(RateLimiterTest, DisabledWhenRateIsZero) {
+    RateLimiter limiter(RateLimitConfig{0.0, 4.0, 16});
+    
+    EXPECT_FALSE(limiter.is_enabled());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(limiter.try_acquire("player1", 1000));
+    }
+}
+
+TEST_F(RateLimiterTest, ConcurrentAcquireNeverExceedsBurst) {
+    RateLimiter limiter(RateLimitConfig{1.0, 50.0, 16});
+    std::atomic<int> granted{0};
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                if (limiter.try_acquire("player1", 1000)) granted++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    EXPECT_EQ(granted.load(), 50);
+}
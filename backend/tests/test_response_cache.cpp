@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "response_cache.h"
+
+class ResponseCacheTest : public ::testing::Test {
+protected:
+    ResponseCache cache;
+};
+
+TEST_F(ResponseCacheTest, MissOnEmptyCache) {
+    EXPECT_EQ(cache.get("active-bets", 1), nullptr);
+}
+
+TEST_F(ResponseCacheTest, HitOnSameVersion) {
+    cache.put("active-bets", 3, "[]");
+    
+    auto cached = cache.get("active-bets", 3);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->body, "[]");
+    EXPECT_EQ(cached->etag, cache.make_etag("active-bets", 3));
+}
+
+TEST_F(ResponseCacheTest, MissOnNewVersion) {
+    cache.put("active-bets", 3, "[]");
+    EXPECT_EQ(cache.get("active-bets", 4), nullptr);
+}
+
+TEST_F(ResponseCacheTest, OlderVersionDoesNotOverwrite) {
+    cache.put("old-crash-points", 5, "[1.5]");
+    cache.put("old-crash-points", 4, "[]");
+    
+    auto cached = cache.get("old-crash-points", 5);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->body, "[1.5]");
+}
+
+TEST_F(ResponseCacheTest, EtagDiffersPerKeyAndVersion) {
+    EXPECT_NE(cache.make_etag("active-bets", 1), cache.make_etag("active-bets", 2));
+    EXPECT_NE(cache.make_etag("active-bets", 1), cache.make_etag("old-crash-points", 1));
+}
+
+TEST_F(ResponseCacheTest, EtagMatching) {
+    std::string etag = cache.make_etag("active-bets", 7);
+    
+    EXPECT_TRUE(ResponseCache::etag_matches(etag, etag));
+    EXPECT_TRUE(ResponseCache::etag_matches("W/" + etag, etag));
+    EXPECT_TRUE(ResponseCache::etag_matches("\"other\", " + etag, etag));
+    EXPECT_TRUE(ResponseCache::etag_matches("*", etag));
+    EXPECT_FALSE(ResponseCache::etag_matches("", etag));
+    EXPECT_FALSE(ResponseCache::etag_matches(cache.make_etag("active-bets", 6), etag));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "settlement_export.h"
+#include "bet.h"
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+SettledBet won(std::string_view player_id, std::string_view name, int64_t amount, uint32_t multiplier_x100) {
+    return SettledBet{player_id, name, amount, amount * multiplier_x100 / 100,
+                      multiplier_x100, static_cast<uint8_t>(BetStatus::CASHED_OUT)};
+}
+
+SettledBet lost(std::string_view player_id, std::string_view name, int64_t amount) {
+    return SettledBet{player_id, name, amount, 0, 0, static_cast<uint8_t>(BetStatus::CRASHED)};
+}
+
+// Round r, r * 1000 ms'de settle edilir: p1 kazanır, p2 kaybeder
+void fill(BetHistoryStore& store, uint32_t rounds) {
+    for (uint32_t round = 1; round <= rounds; round++) {
+        store.append_round(round, 1000 * round, {won("p1", "Ali \"B\"", 1000, 235), lost("p2", "Veli", 500)});
+    }
+}
+
+std::vector<json> export_all(const BetHistoryStore& store, const ExportRange& range, size_t& chunks) {
+    SettlementExporter exporter(store, range, 300, 3);
+    std::vector<json> rows;
+    std::string chunk;
+    chunks = 0;
+    while (exporter.next_chunk(chunk)) {
+        chunks++;
+        EXPECT_EQ(chunk.back(), '\n');  // Satırlar parçalara bölünmez
+        std::istringstream lines(chunk);
+        std::string line;
+        while (std::getline(lines, line)) rows.push_back(json::parse(line));
+    }
+    EXPECT_EQ(exporter.get_rows(), rows.size());
+    return rows;
+}
+
+}
+
+TEST(SettlementExportTest, StreamsEveryRecordInChunks) {
+    BetHistoryStore store;
+    fill(store, 10);
+
+    size_t chunks = 0;
+    auto rows = export_all(store, ExportRange(), chunks);
+    ASSERT_EQ(rows.size(), 20u);
+    EXPECT_GT(chunks, 3u);
+
+    EXPECT_EQ(rows[0]["round"], 1);
+    EXPECT_EQ(rows[0]["settled_at"], 1000);
+    EXPECT_EQ(rows[0]["player_id"], "p1");
+    EXPECT_EQ(rows[0]["player_name"], "Ali \"B\"");
+    EXPECT_DOUBLE_EQ(rows[0]["amount"].get<double>(), 10.0);
+    EXPECT_EQ(rows[0]["status"], "cashed_out");
+    EXPECT_DOUBLE_EQ(rows[0]["cashout_multiplier"].get<double>(), 2.35);
+    EXPECT_DOUBLE_EQ(rows[0]["winnings"].get<double>(), 23.5);
+    EXPECT_EQ(rows[1]["status"], "crashed");
+    EXPECT_DOUBLE_EQ(rows[1]["winnings"].get<double>(), 0.0);
+    EXPECT_EQ(rows[19]["round"], 10);
+
+    // Bütünlük satırı: tamamlanan dışa aktarım ve yarım kalan
+    SettlementExporter exporter(store, ExportRange(), 64);
+    std::string chunk;
+    while (exporter.next_chunk(chunk)) {}
+    EXPECT_TRUE(exporter.is_complete());
+    std::string trailer;
+    SettlementExporter::append_trailer(trailer, true, exporter.get_rows());
+    EXPECT_EQ(json::parse(trailer), json::parse(R"({"export":"complete","rows":20})"));
+    trailer.clear();
+    SettlementExporter::append_trailer(trailer, false, 7, "Sunucu kapanıyor");
+    EXPECT_EQ(json::parse(trailer)["export"], "incomplete");
+    EXPECT_EQ(json::parse(trailer)["error"], "Sunucu kapanıyor");
+}
+
+TEST(SettlementExportTest, FiltersByTimeAndRound) {
+    BetHistoryStore store;
+    fill(store, 10);
+    size_t chunks = 0;
+
+    ExportRange by_time;
+    by_time.from_ms = 3000;
+    by_time.to_ms = 6000;  // Hariç
+    auto rows = export_all(store, by_time, chunks);
+    ASSERT_EQ(rows.size(), 6u);
+    EXPECT_EQ(rows.front()["round"], 3);
+    EXPECT_EQ(rows.back()["round"], 5);
+
+    ExportRange by_round;
+    by_round.from_round = 9;
+    rows = export_all(store, by_round, chunks);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows.front()["round"], 9);
+
+    ExportRange empty;
+    empty.from_ms = 20000;
+    EXPECT_TRUE(export_all(store, empty, chunks).empty());
+    EXPECT_EQ(chunks, 0u);
+}
+
+TEST(SettlementExportTest, ReadsPersistedHistory) {
+    std::string path = "/tmp/crash_settlement_export_" + std::to_string(::getpid()) + ".bin";
+    std::remove(path.c_str());
+    std::remove((path + ".players").c_str());
+    {
+        BetHistoryStore store(path);
+        fill(store, 4);
+    }
+
+    BetHistoryStore reopened(path);
+    size_t chunks = 0;
+    ExportRange range;
+    range.from_round = 2;
+    range.to_round = 3;
+    auto rows = export_all(reopened, range, chunks);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0]["player_name"], "Ali \"B\"");
+    EXPECT_EQ(rows[3]["player_id"], "p2");
+
+    std::remove(path.c_str());
+    std::remove((path + ".players").c_str());
+}
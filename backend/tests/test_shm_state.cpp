@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "shm_state.h"
+#include "json_utils.h"
+#include "game.h"
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+std::string unique_name(const std::string& suffix) {
+    return "/crash_test_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+}
+
+TEST(ShmStateTest, ReaderWaitsForFirstPublish) {
+    std::string name = unique_name("first");
+    ShmStateReader missing(name);
+    GameSnapshot snapshot{};
+    EXPECT_FALSE(missing.read(snapshot));  // Segment yok
+    
+    ShmStatePublisher publisher(name);
+    ShmStateReader reader(name);
+    EXPECT_FALSE(reader.read(snapshot));   // Segment var ama yayın yok
+    
+    GameSnapshot published{};
+    published.round = 12;
+    published.multiplier_x100 = 345;
+    published.crash_point_count = 2;
+    published.crash_points_x100[0] = 101;
+    published.crash_points_x100[1] = 250;
+    publisher.publish(published);
+    
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_EQ(snapshot.round, 12u);
+    EXPECT_EQ(snapshot.multiplier_x100, 345u);
+    EXPECT_EQ(GameStateSerializer::serializeCrashPoints(snapshot), json::parse("[1.01, 2.5]"));
+    
+    // Geç başlayan okuyucu da bağlanabilmeli
+    EXPECT_TRUE(missing.read(snapshot));
+}
+
+// Okuyucu hiçbir zaman yarım yazılmış snapshot görmemeli
+TEST(ShmStateTest, ReadsAreConsistentUnderConcurrentWrites) {
+    std::string name = unique_name("torn");
+    ShmStatePublisher publisher(name);
+    ShmStateReader reader(name);
+    std::atomic<bool> done{false};
+    
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= 200000; i++) {
+            GameSnapshot snapshot{};
+            snapshot.round = i;
+            snapshot.multiplier_x100 = i;
+            snapshot.bets_version = i;
+            snapshot.crash_points_x100[GameSnapshot::MAX_CRASH_POINTS - 1] = i;
+            publisher.publish(snapshot);
+        }
+        done = true;
+    });
+    
+    // Tek çekirdekte yazıcı okuyucudan önce bitebilir: yazım bittikten sonra da bir kez okunur
+    size_t reads = 0;
+    bool finished = false;
+    do {
+        finished = done;
+        GameSnapshot snapshot;
+        if (reader.read(snapshot)) {
+            reads++;
+            ASSERT_EQ(snapshot.multiplier_x100, snapshot.round);
+            ASSERT_EQ(snapshot.bets_version, snapshot.round);
+            ASSERT_EQ(snapshot.crash_points_x100[GameSnapshot::MAX_CRASH_POINTS - 1], snapshot.round);
+        }
+    } while (!finished);
+    writer.join();
+    EXPECT_GT(reads, 0u);
+}
+
+// Replica'nın snapshot'tan ürettiği status, primary'ninkiyle aynı alanları taşımalı
+TEST(ShmStateTest, SnapshotMatchesGameState) {
+    CrashGame game(true);
+    game.add_player("player1", "Ahmet");
+    EXPECT_TRUE(game.place_bet("player1", 100 * MONEY_SCALE));
+    
+    GameSnapshot snapshot = GameStateSerializer::captureSnapshot(game);
+    json fromGame = GameStateSerializer::serializeGameState(game);
+    json fromSnapshot = GameStateSerializer::serializeSnapshot(snapshot, snapshot.published_at_ms);
+    
+    EXPECT_EQ(fromSnapshot["round"], fromGame["round"]);
+    EXPECT_EQ(fromSnapshot["phase"], fromGame["phase"]);
+    EXPECT_EQ(fromSnapshot["multiplier"], fromGame["multiplier"]);
+    EXPECT_EQ(fromSnapshot["active_bets"], fromGame["active_bets"]);
+    EXPECT_NEAR(fromSnapshot["remaining_time_ms"].get<double>(), fromGame["remaining_time_ms"].get<double>(), 5);
+    
+    // Geri sayım yayından bu yana geçen süre kadar ilerler
+    json later = GameStateSerializer::serializeSnapshot(snapshot, snapshot.published_at_ms + 60);
+    EXPECT_EQ(later["remaining_time_ms"], std::max<int64_t>(0, fromSnapshot["remaining_time_ms"].get<int64_t>() - 60));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "static_assets.h"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+class StaticAssetsTest : public ::testing::Test {
+protected:
+    fs::path root;
+    
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("crash_static_" + std::to_string(::getpid()));
+        fs::create_directories(root / "assets");
+        write("index.html", "<html><body><div id=\"root\"></div></body></html>");
+        write("bundle.3f9a2c1d4e5b.js", std::string(4096, 'x'));
+        write("assets/game_plane.8c1e2f3a.png", "PNG");
+        write("game_plane.png", "PNG");
+    }
+    
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+    
+    void write(const std::string& name, const std::string& content) {
+        std::ofstream(root / name, std::ios::binary) << content;
+    }
+};
+
+TEST_F(StaticAssetsTest, ServesFilesWithCachePolicy) {
+    StaticAssets assets;
+    ASSERT_EQ(assets.load(root.string()), 4u);
+    
+    const StaticAsset* bundle = assets.find("/bundle.3f9a2c1d4e5b.js");
+    ASSERT_NE(bundle, nullptr);
+    EXPECT_EQ(bundle->content_type, "application/javascript");
+    EXPECT_EQ(bundle->cache_control, "public, max-age=31536000, immutable");
+    // Önceden sıkıştırılmış ve açılınca aynı içerik
+    ContentCoding coding = bundle->response->effective_coding(ContentCoding::GZIP);
+    EXPECT_EQ(coding, ContentCoding::GZIP);
+    EXPECT_EQ(Compression::decompress(bundle->response->encoded_body(coding), coding), bundle->response->body);
+    
+    const StaticAsset* index = assets.find("/");
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->cache_control, "no-cache");
+    EXPECT_EQ(index->content_type, "text/html; charset=utf-8");
+    
+    EXPECT_EQ(assets.find("/assets/game_plane.8c1e2f3a.png")->content_type, "image/png");
+    EXPECT_EQ(assets.find("/game_plane.png")->cache_control, "public, max-age=3600");
+}
+
+TEST_F(StaticAssetsTest, SpaRoutesFallBackToIndex) {
+    StaticAssets assets;
+    assets.load(root.string());
+    
+    EXPECT_EQ(assets.find("/game"), assets.find("/index.html"));
+    EXPECT_EQ(assets.find("/profile/42"), assets.find("/index.html"));
+    // Uzantılı eksik dosya index.html değil 404 olmalı
+    EXPECT_EQ(assets.find("/missing.js"), nullptr);
+    EXPECT_EQ(assets.find("/../etc/passwd"), nullptr);
+}
+
+TEST_F(StaticAssetsTest, EtagFollowsContent) {
+    StaticAssets first;
+    first.load(root.string());
+    std::string etag = first.find("/game_plane.png")->response->etag;
+    
+    write("game_plane.png", "PNG2");
+    StaticAssets second;
+    second.load(root.string());
+    EXPECT_NE(second.find("/game_plane.png")->response->etag, etag);
+    EXPECT_EQ(second.find("/index.html")->response->etag, first.find("/index.html")->response->etag);
+}
+
+TEST(StaticAssetsNames, FingerprintDetection) {
+    EXPECT_TRUE(StaticAssets::is_fingerprinted("bundle.3f9a2c1d4e5b.js"));
+    EXPECT_TRUE(StaticAssets::is_fingerprinted("plane.8c1e2f3a.png"));
+    EXPECT_FALSE(StaticAssets::is_fingerprinted("bundle.js"));
+    EXPECT_FALSE(StaticAssets::is_fingerprinted("beko_irak.png"));
+    EXPECT_FALSE(StaticAssets::is_fingerprinted("app.config.js"));
+    EXPECT_FALSE(StaticAssets::is_fingerprinted("notes.deadbeefx.txt"));
+}
+
+TEST(StaticAssetsNames, MissingDirectoryThrows) {
+    StaticAssets assets;
+    EXPECT_THROW(assets.load("/nonexistent/crash_static"), std::runtime_error);
+}
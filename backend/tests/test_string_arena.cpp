@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "string_arena.h"
+#include <string>
+#include <vector>
+
+TEST(StringArenaTest, StoresCopies) {
+    StringArena arena(64);
+    std::string original = "player_abc123xyz";
+    std::string_view stored = arena.store(original);
+    
+    original[0] = 'X';
+    EXPECT_EQ(stored, "player_abc123xyz");
+    EXPECT_TRUE(arena.store("").empty());
+}
+
+TEST(StringArenaTest, GrowsWithNewBlocks) {
+    StringArena arena(16);
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 10; ++i) {
+        views.push_back(arena.store("player_" + std::to_string(i)));
+    }
+    views.push_back(arena.store(std::string(100, 'a')));  // Blok boyutundan büyük
+    
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(views[i], "player_" + std::to_string(i));
+    }
+    EXPECT_EQ(views.back().size(), 100u);
+    EXPECT_GT(arena.block_count(), 1u);
+}
+
+TEST(StringArenaTest, ResetReusesBlocks) {
+    StringArena arena(32);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            arena.store("player_" + std::to_string(i));
+        }
+        arena.reset();
+    }
+    
+    // İlk round'dan sonra yeni blok ayrılmamalı
+    size_t blocks = arena.block_count();
+    for (int i = 0; i < 20; ++i) {
+        arena.store("player_" + std::to_string(i));
+    }
+    EXPECT_EQ(arena.block_count(), blocks);
+}
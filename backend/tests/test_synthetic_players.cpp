@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "synthetic_players.h"
+#include "game.h"
+#include <thread>
+
+// Tüm sentetik bahisler uçuş başlamadan yerleşmeli, cashout'lar hedef çarpanda yapılmalı
+TEST(SyntheticPlayersTest, BetsSpreadOverWaitingPhase) {
+    CrashGame game(true);
+    SyntheticConfig config;
+    config.players = 2000;
+    config.tick_ms = 1;
+    config.cashout_mean = 1.01;
+    config.max_cashout = 1.02;
+    SyntheticPlayers synthetic(config);
+    synthetic.attach(game);
+    EXPECT_EQ(game.get_player_count(), 2000u);
+    
+    while (game.get_phase() == GamePhase::WAITING) {
+        game.update();
+        synthetic.on_tick(game);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(game.get_active_bet_count(), 2000);
+    EXPECT_EQ(synthetic.get_stats().bets_placed, 2000u);
+    
+    while (game.get_phase() == GamePhase::FLYING && game.get_current_multiplier() < 1.05) {
+        game.update();
+        synthetic.on_tick(game);
+    }
+    // Hedefler [1.01, 1.02] aralığında: crash daha önce gelmediyse herkes cashout yapmış olmalı
+    if (game.get_phase() == GamePhase::FLYING) {
+        EXPECT_EQ(synthetic.get_stats().cashouts, 2000u);
+        game.end_game();
+    }
+    
+    SyntheticStats stats = synthetic.get_stats();
+    EXPECT_EQ(stats.rounds, 1u);
+    json leaderboard;
+    uint64_t version = 0;
+    game.get_leaderboard_json(leaderboard, version);
+    EXPECT_EQ(leaderboard["round_top"].empty(), stats.cashouts == 0);
+}
+
+TEST(SyntheticPlayersTest, RefillsEmptyBalances) {
+    CrashGame game(true);
+    SyntheticConfig config;
+    config.players = 1;
+    config.min_bet = config.max_bet = 1000 * MONEY_SCALE;  // İlk bahis bakiyeyi bitirir
+    config.tick_ms = 1;
+    SyntheticPlayers synthetic(config);
+    synthetic.attach(game);
+    
+    for (int round = 0; round < 2; round++) {
+        while (game.get_phase() != GamePhase::WAITING) game.update();
+        synthetic.on_tick(game);
+        game.start_flying_phase();
+        game.end_game();
+        while (game.get_phase() == GamePhase::CRASHED) game.update();
+    }
+    EXPECT_EQ(synthetic.get_stats().bets_placed, 2u);
+}
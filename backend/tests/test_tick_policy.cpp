@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include "tick_policy.h"
+#include "game.h"
+
+TEST(TickPolicyTest, IntervalFollowsPhase) {
+    TickPolicy policy(TickPolicyConfig{1000, 50, 250, 200});
+    
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::WAITING, 9000), 1000);
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::FLYING, 0), 50);
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::CRASHED, 3000), 250);
+    
+    TickPolicyStats stats = policy.get_stats();
+    EXPECT_EQ(stats.waiting_ticks, 1u);
+    EXPECT_EQ(stats.flying_ticks, 1u);
+    EXPECT_EQ(stats.crashed_ticks, 1u);
+}
+
+TEST(TickPolicyTest, PhaseEndIsNotOverslept) {
+    TickPolicy policy(TickPolicyConfig{1000, 50, 250, 200});
+    
+    // Kalan süreye kırpılır; süre dolduysa hemen tekrar tick
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::WAITING, 300), 300);
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::WAITING, 0), 1);
+    EXPECT_EQ(policy.next_tick_ms(GamePhase::CRASHED, 40), 40);
+}
+
+TEST(TickPolicyTest, SpectatorsAreDownsampledOnlyWhileFlying) {
+    TickPolicy policy(TickPolicyConfig{1000, 50, 250, 200});
+    
+    EXPECT_EQ(policy.spectator_cutoff_ms(GamePhase::FLYING, 5000), 4800);
+    EXPECT_EQ(policy.spectator_cutoff_ms(GamePhase::WAITING, 5000), 5000);
+    EXPECT_EQ(policy.spectator_cutoff_ms(GamePhase::CRASHED, 5000), 5000);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "tick_protocol.h"
+#include "tick_stream.h"
+#include "game.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(TickProtocolTest, TickRoundTrip) {
+    tick_protocol::Tick tick;
+    tick.round = 4242;
+    tick.phase = tick_protocol::Phase::CRASHED;
+    tick.multiplier_x100 = 1234;
+    tick.crash_point_x100 = 1234;
+    tick.remaining_time_ms = 2500;
+    tick.active_bets = 17;
+    tick.timestamp_ms = 1700000000123;
+    
+    uint8_t frame[tick_protocol::TICK_SIZE];
+    tick_protocol::encode_tick(tick, frame);
+    // Little-endian düzen: round 4. byte'tan başlar
+    EXPECT_EQ(frame[0], 1);
+    EXPECT_EQ(frame[4], 4242 & 0xFF);
+    EXPECT_EQ(frame[5], 4242 >> 8);
+    
+    tick_protocol::Tick decoded;
+    ASSERT_TRUE(tick_protocol::decode_tick(frame, sizeof(frame), decoded));
+    EXPECT_EQ(decoded.round, tick.round);
+    EXPECT_EQ(decoded.phase, tick.phase);
+    EXPECT_EQ(decoded.multiplier_x100, tick.multiplier_x100);
+    EXPECT_EQ(decoded.crash_point_x100, tick.crash_point_x100);
+    EXPECT_EQ(decoded.remaining_time_ms, tick.remaining_time_ms);
+    EXPECT_EQ(decoded.active_bets, tick.active_bets);
+    EXPECT_EQ(decoded.timestamp_ms, tick.timestamp_ms);
+    
+    EXPECT_FALSE(tick_protocol::decode_tick(frame, sizeof(frame) - 1, decoded));
+    frame[1] = 99;  // Bilinmeyen versiyon
+    EXPECT_FALSE(tick_protocol::decode_tick(frame, sizeof(frame), decoded));
+}
+
+TEST(TickProtocolTest, CommandRoundTrip) {
+    std::string bet = tick_protocol::encode_bet("player_abc", 12345);
+    ASSERT_EQ(bet.size(), tick_protocol::BET_HEADER_SIZE + 10);
+    
+    tick_protocol::Command command;
+    ASSERT_TRUE(tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(bet.data()), bet.size(), command));
+    EXPECT_EQ(command.type, tick_protocol::MessageType::BET);
+    EXPECT_EQ(command.player_id, "player_abc");
+    EXPECT_EQ(command.amount, 12345);
+    
+    std::string cashout = tick_protocol::encode_cashout("p1");
+    ASSERT_TRUE(tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(cashout.data()), cashout.size(), command));
+    EXPECT_EQ(command.type, tick_protocol::MessageType::CASHOUT);
+    EXPECT_EQ(command.player_id, "p1");
+    
+    // Boyutu tutmayan veya JSON olan body'ler reddedilmeli
+    EXPECT_FALSE(tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(bet.data()), bet.size() - 1, command));
+    std::string jsonBody = "{\"player_id\":\"p1\"}";
+    EXPECT_FALSE(tick_protocol::decode_command(reinterpret_cast<const uint8_t*>(jsonBody.data()), jsonBody.size(), command));
+}
+
+TEST(TickProtocolTest, SerializeTickFromGame) {
+    CrashGame game(true);
+    game.add_player("player1", "Ahmet");
+    EXPECT_TRUE(game.place_bet("player1", 100 * MONEY_SCALE));
+    
+    tick_protocol::Tick tick = GameStateSerializer::serializeTick(game);
+    EXPECT_EQ(tick.round, 1u);
+    EXPECT_EQ(tick.phase, tick_protocol::Phase::WAITING);
+    EXPECT_EQ(tick.multiplier_x100, 100u);
+    EXPECT_EQ(tick.crash_point_x100, 0u);
+    EXPECT_EQ(tick.active_bets, 1u);
+}
+
+// Bağlanan istemci yayınlanan çerçeveleri bütün olarak almalı
+TEST(TickProtocolTest, StreamDeliversFrames) {
+    TickStream stream;
+    stream.start(0);
+    ASSERT_NE(stream.get_port(), 0);
+    
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(stream.get_port());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    
+    for (int i = 0; i < 200 && stream.get_stats().clients == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(stream.get_stats().clients, 1u);
+    
+    tick_protocol::Tick tick;
+    tick.round = 7;
+    uint8_t frame[tick_protocol::TICK_SIZE];
+    tick_protocol::encode_tick(tick, frame);
+    stream.publish(frame, sizeof(frame));
+    
+    uint8_t received[tick_protocol::TICK_SIZE];
+    size_t got = 0;
+    while (got < sizeof(received)) {
+        ssize_t n = ::recv(fd, received + got, sizeof(received) - got, 0);
+        ASSERT_GT(n, 0);
+        got += static_cast<size_t>(n);
+    }
+    tick_protocol::Tick decoded;
+    ASSERT_TRUE(tick_protocol::decode_tick(received, got, decoded));
+    EXPECT_EQ(decoded.round, 7u);
+    
+    ::close(fd);
+    for (int i = 0; i < 200 && stream.get_stats().clients == 1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(stream.get_stats().clients, 0u);
+    stream.stop();
+}
+
+// fd sınırında bekleyen bağlantı kapatılmalı (epoll dönüp durmamalı), sınır kalkınca yayın sürmeli
+TEST(TickProtocolTest, StreamShedsConnectionsAtFdLimit) {
+    TickStream stream;
+    stream.start(0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(stream.get_port());
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client, 0);
+    
+    // Süreci fd sınırına getir: sunucunun accept4'ü EMFILE alır
+    rlimit original{};
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &original), 0);
+    rlimit lowered = original;
+    lowered.rlim_cur = 256;
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &lowered), 0);
+    std::vector<int> fillers;
+    for (int fd = ::open("/dev/null", O_RDONLY); fd >= 0; fd = ::open("/dev/null", O_RDONLY)) {
+        fillers.push_back(fd);
+    }
+    
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    pollfd pfd{client, POLLIN, 0};
+    ASSERT_EQ(::poll(&pfd, 1, 2000), 1);
+    char byte;
+    EXPECT_EQ(::recv(client, &byte, 1, 0), 0);  // Kabul edilip kapatıldı
+    EXPECT_EQ(stream.get_stats().refused, 1u);
+    EXPECT_EQ(stream.get_stats().clients, 0u);
+    
+    for (int fd : fillers) ::close(fd);
+    ::setrlimit(RLIMIT_NOFILE, &original);
+    ::close(client);
+    
+    client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    for (int i = 0; i < 200 && stream.get_stats().clients == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(stream.get_stats().clients, 1u);
+    ::close(client);
+    stream.stop();
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "timing_wheel.h"
+
+TEST(TimingWheelTest, FiresAtDeadline) {
+    TimingWheel<int> wheel(0);
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 3);
+    
+    std::vector<int> fired;
+    auto collect = [&](int&& value) { fired.push_back(value); };
+    
+    wheel.advance(2, collect);
+    EXPECT_TRUE(fired.empty());
+    wheel.advance(3, collect);
+    EXPECT_EQ(fired, std::vector<int>({2}));
+    wheel.advance(10, collect);
+    EXPECT_EQ(fired, std::vector<int>({2, 1}));
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+// Üst seviyelere konan kayıtlar aşağı dökülüp tam zamanında tetiklenmeli
+TEST(TimingWheelTest, CascadesFromUpperLevels) {
+    TimingWheel<uint64_t> wheel(7);
+    const std::vector<uint64_t> deadlines = {8, 70, 71, 4096, 4103, 5000, 300000};
+    for (uint64_t deadline : deadlines) wheel.schedule(deadline, deadline);
+    
+    std::vector<uint64_t> fired;
+    uint64_t now = 7;
+    while (wheel.size() > 0) {
+        now++;
+        wheel.advance(now, [&](uint64_t&& deadline) {
+            EXPECT_EQ(deadline, now);
+            fired.push_back(deadline);
+        });
+    }
+    EXPECT_EQ(fired, deadlines);
+}
+
+TEST(TimingWheelTest, PastDeadlineFiresNextTick) {
+    TimingWheel<int> wheel(100);
+    wheel.schedule(1, 50);
+    
+    int fired = 0;
+    wheel.advance(101, [&](int&&) { fired++; });
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(TimingWheelTest, RescheduleFromCallback) {
+    TimingWheel<int> wheel(0);
+    wheel.schedule(1, 1);
+    
+    int fired = 0;
+    wheel.advance(1, [&](int&& value) {
+        fired++;
+        wheel.schedule(value, 100);  // Hâlâ aktif: ileriye at
+    });
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.size(), 1u);
+    
+    wheel.advance(99, [&](int&&) { fired++; });
+    EXPECT_EQ(fired, 1);
+    wheel.advance(100, [&](int&&) { fired++; });
+    EXPECT_EQ(fired, 2);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "trace.h"
+#include <atomic>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Dökümde adı verilen thread'in span'leri
+std::vector<json> events_of_thread(const json& dump, const std::string& thread_name) {
+    int64_t tid = -1;
+    for (const auto& event : dump["traceEvents"]) {
+        if (event["ph"] == "M" && event["args"]["name"] == thread_name) tid = event["tid"];
+    }
+    std::vector<json> events;
+    for (const auto& event : dump["traceEvents"]) {
+        if (event["ph"] == "X" && event["tid"] == tid) events.push_back(event);
+    }
+    return events;
+}
+
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        trace::configure(0);
+    }
+};
+
+TEST_F(TraceTest, SpansAppearInDump) {
+    trace::configure(1024);
+    std::thread worker([] {
+        trace::set_thread_name("trace-spans");
+        TRACE_SPAN("outer");
+        {
+            TRACE_SPAN("inner");
+        }
+    });
+    worker.join();
+
+    json dump = json::parse(trace::dump_json());
+    auto events = events_of_thread(dump, "trace-spans");
+    ASSERT_EQ(events.size(), 2u);
+    // İç span önce kapanır
+    EXPECT_EQ(events[0]["name"], "inner");
+    EXPECT_EQ(events[1]["name"], "outer");
+    EXPECT_GE(events[0]["ts"].get<double>(), events[1]["ts"].get<double>());
+    EXPECT_GE(events[1]["dur"].get<double>(), events[0]["dur"].get<double>());
+}
+
+TEST_F(TraceTest, RingKeepsLatestEvents) {
+    trace::configure(3);  // 4'e yuvarlanır
+    static const char* names[] = {"e0", "e1", "e2", "e3", "e4", "e5", "e6", "e7", "e8", "e9"};
+    std::thread worker([] {
+        trace::set_thread_name("trace-ring");
+        for (int i = 0; i < 10; i++) trace::record(names[i], i * 1000, i * 1000 + 500);
+    });
+    worker.join();
+
+    auto events = events_of_thread(json::parse(trace::dump_json()), "trace-ring");
+    // Yazılıyor olabilecek en eski slot dökümde atlanır: 4 - 1 olay
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events.front()["name"], "e7");
+    EXPECT_EQ(events.back()["name"], "e9");
+    EXPECT_DOUBLE_EQ(events.back()["dur"].get<double>(), 0.5);
+}
+
+TEST_F(TraceTest, DumpWhileWritingSkipsTornEvents) {
+    trace::configure(64);
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop] {
+        trace::set_thread_name("trace-writer");
+        for (int64_t i = 0; !stop.load(); i++) {
+            trace::record("tick", i * 1000, i * 1000 + 1000);
+        }
+    });
+
+    for (int i = 0; i < 200; i++) {
+        auto events = events_of_thread(json::parse(trace::dump_json()), "trace-writer");
+        EXPECT_LE(events.size(), 64u);
+        for (const auto& event : events) {
+            ASSERT_DOUBLE_EQ(event["dur"].get<double>(), 1.0);
+        }
+    }
+    stop = true;
+    writer.join();
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include "websocket_gateway.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// İstemci çerçevesi: maskeli
+std::string client_frame(websocket::Opcode opcode, std::string_view payload, bool fin = true) {
+    std::string frame = websocket::encode_frame(opcode, payload);
+    frame[0] = static_cast<char>(fin ? frame[0] : frame[0] & 0x7F);
+    size_t header = frame.size() - payload.size();
+    frame[1] = static_cast<char>(frame[1] | 0x80);
+    const uint8_t mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::string masked = frame.substr(0, header) + std::string(reinterpret_cast<const char*>(mask), 4);
+    for (size_t i = 0; i < payload.size(); i++) {
+        masked.push_back(static_cast<char>(payload[i] ^ mask[i & 3]));
+    }
+    return masked;
+}
+
+int connect_local(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Sunucu çerçevesini okur (maskesiz, 126'dan kısa)
+bool read_frame(int fd, websocket::Opcode& opcode, std::string& payload) {
+    uint8_t header[2];
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, 2000) <= 0 || ::recv(fd, header, 2, MSG_WAITALL) != 2) return false;
+    opcode = static_cast<websocket::Opcode>(header[0] & 0x0F);
+    payload.resize(header[1] & 0x7F);
+    return payload.empty() || ::recv(fd, &payload[0], payload.size(), MSG_WAITALL) == static_cast<ssize_t>(payload.size());
+}
+
+std::string read_http_head(int fd) {
+    std::string head;
+    char c;
+    while (head.find("\r\n\r\n") == std::string::npos && ::recv(fd, &c, 1, 0) == 1) head.push_back(c);
+    return head;
+}
+
+std::string upgrade_request(const std::string& player_id) {
+    return "GET /ws?player_id=" + player_id + " HTTP/1.1\r\n"
+           "Host: localhost\r\n"
+           "Upgrade: websocket\r\n"
+           "Connection: keep-alive, Upgrade\r\n"
+           "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+           "Sec-WebSocket-Version: 13\r\n\r\n";
+}
+
+}
+
+TEST(WebSocketTest, HandshakeFollowsRfc6455) {
+    // RFC 6455 bölüm 1.3'teki örnek
+    EXPECT_EQ(websocket::accept_key("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    websocket::Handshake handshake;
+    ASSERT_TRUE(websocket::parse_handshake(upgrade_request("player%5Fabc"), handshake));
+    EXPECT_EQ(handshake.player_id, "player_abc");
+    EXPECT_EQ(handshake.key, "dGhlIHNhbXBsZSBub25jZQ==");
+
+    EXPECT_FALSE(websocket::parse_handshake(upgrade_request(""), handshake));
+    std::string wrong_path = upgrade_request("p1");
+    wrong_path.replace(4, 3, "/xx");
+    EXPECT_FALSE(websocket::parse_handshake(wrong_path, handshake));
+    std::string plain_http = upgrade_request("p1");
+    plain_http.replace(plain_http.find("Upgrade: websocket"), 18, "X-Other: websocket");
+    EXPECT_FALSE(websocket::parse_handshake(plain_http, handshake));
+}
+
+TEST(WebSocketTest, DecodesMaskedClientFrames) {
+    std::string bet = tick_protocol::encode_bet("p1", 1500);
+    std::string wire = client_frame(websocket::Opcode::BINARY, bet) + client_frame(websocket::Opcode::PING, "x");
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(wire.data());
+
+    websocket::Frame frame;
+    EXPECT_EQ(websocket::decode_frame(data, 5, frame), 0);  // Eksik
+    long used = websocket::decode_frame(data, wire.size(), frame);
+    ASSERT_EQ(used, static_cast<long>(2 + 4 + bet.size()));
+    EXPECT_TRUE(frame.fin);
+    EXPECT_EQ(frame.opcode, websocket::Opcode::BINARY);
+    EXPECT_EQ(frame.payload, bet);
+    ASSERT_GT(websocket::decode_frame(data + used, wire.size() - used, frame), 0);
+    EXPECT_EQ(frame.opcode, websocket::Opcode::PING);
+    EXPECT_EQ(frame.payload, "x");
+
+    // 16 bit uzunluk; sınır aşan çerçeve gövdesi gelmeden reddedilir
+    std::string large(300, 'a');
+    std::string wide = client_frame(websocket::Opcode::BINARY, large);
+    ASSERT_EQ(websocket::decode_frame(reinterpret_cast<const uint8_t*>(wide.data()), wide.size(), frame),
+              static_cast<long>(4 + 4 + large.size()));
+    EXPECT_EQ(frame.payload, large);
+    EXPECT_EQ(websocket::decode_frame(reinterpret_cast<const uint8_t*>(wide.data()), 8, frame, 100),
+              -websocket::CLOSE_TOO_BIG);
+
+    // Maskesiz istemci çerçevesi protokol hatası
+    std::string unmasked = websocket::encode_frame(websocket::Opcode::BINARY, "abc");
+    EXPECT_EQ(websocket::decode_frame(reinterpret_cast<const uint8_t*>(unmasked.data()), unmasked.size(), frame),
+              -websocket::CLOSE_PROTOCOL_ERROR);
+}
+
+TEST(WebSocketTest, SessionCarriesTicksCommandsAndBalances) {
+    std::atomic<int> executed{0};
+    std::atomic<bool> fail_next{false};
+    int64_t balance = 100000;
+    WebSocketGateway gateway;
+    gateway.set_handlers(WebSocketHandlers{
+        [](const std::string& player_id) { return player_id == "p1"; },
+        [&](const std::string&, const tick_protocol::Command& command, int64_t& out) {
+            executed++;
+            if (fail_next.exchange(false)) throw std::runtime_error("Komut günlüğü yazılamadı");
+            if (command.type == tick_protocol::MessageType::BET) balance -= command.amount;
+            out = balance;
+            return true;
+        },
+        [&](const std::string&) { return balance; }
+    });
+    gateway.start(0);
+
+    // Bilinmeyen oyuncu el sıkışmada reddedilir
+    int stranger = connect_local(gateway.get_port());
+    ASSERT_GE(stranger, 0);
+    std::string request = upgrade_request("p2");
+    ::send(stranger, request.data(), request.size(), 0);
+    EXPECT_EQ(read_http_head(stranger).substr(0, 12), "HTTP/1.1 403");
+    ::close(stranger);
+
+    int fd = connect_local(gateway.get_port());
+    ASSERT_GE(fd, 0);
+    request = upgrade_request("p1");
+    ::send(fd, request.data(), request.size(), 0);
+    std::string head = read_http_head(fd);
+    EXPECT_EQ(head.substr(0, 12), "HTTP/1.1 101");
+    EXPECT_NE(head.find("s3pPLMBiTxaQ9kYGzzhZRbK+xOo="), std::string::npos);
+
+    websocket::Opcode opcode;
+    std::string payload;
+    int64_t received_balance = 0;
+    ASSERT_TRUE(read_frame(fd, opcode, payload));  // Bağlanınca güncel bakiye
+    ASSERT_TRUE(tick_protocol::decode_balance(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), received_balance));
+    EXPECT_EQ(received_balance, 100000);
+
+    // Aynı bağlantı üzerinden bahis ve ACK
+    std::string bet = client_frame(websocket::Opcode::BINARY, tick_protocol::encode_bet("p1", 2500));
+    ::send(fd, bet.data(), bet.size(), 0);
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    bool ok = false;
+    ASSERT_TRUE(tick_protocol::decode_ack(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), ok, received_balance));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(received_balance, 97500);
+
+    // Tick yayını; crash tick'inde bakiye de gelir
+    tick_protocol::Tick tick;
+    tick.round = 7;
+    tick.phase = tick_protocol::Phase::CRASHED;
+    uint8_t encoded[tick_protocol::TICK_SIZE];
+    tick_protocol::encode_tick(tick, encoded);
+    gateway.publish(encoded, sizeof(encoded));
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    tick_protocol::Tick decoded;
+    ASSERT_TRUE(tick_protocol::decode_tick(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), decoded));
+    EXPECT_EQ(decoded.round, 7u);
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    EXPECT_TRUE(tick_protocol::decode_balance(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), received_balance));
+
+    // Komut hatası oturumu ve gateway thread'ini düşürmez: başarısız ACK
+    fail_next = true;
+    std::string cashout = client_frame(websocket::Opcode::BINARY, tick_protocol::encode_cashout("p1"));
+    ::send(fd, cashout.data(), cashout.size(), 0);
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    ASSERT_TRUE(tick_protocol::decode_ack(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), ok, received_balance));
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(received_balance, 97500);
+
+    // Ping -> pong
+    std::string ping = client_frame(websocket::Opcode::PING, "hi");
+    ::send(fd, ping.data(), ping.size(), 0);
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    EXPECT_EQ(opcode, websocket::Opcode::PONG);
+    EXPECT_EQ(payload, "hi");
+    EXPECT_EQ(gateway.get_stats().sessions, 1u);
+
+    // Başka oyuncu adına komut oturumu kapatır, çalıştırılmaz
+    std::string foreign = client_frame(websocket::Opcode::BINARY, tick_protocol::encode_cashout("p2"));
+    ::send(fd, foreign.data(), foreign.size(), 0);
+    ASSERT_TRUE(read_frame(fd, opcode, payload));
+    EXPECT_EQ(opcode, websocket::Opcode::CLOSE);
+    ASSERT_EQ(payload.size(), 2u);
+    EXPECT_EQ((static_cast<uint8_t>(payload[0]) << 8) | static_cast<uint8_t>(payload[1]), websocket::CLOSE_POLICY);
+    EXPECT_EQ(executed.load(), 2);
+    ::close(fd);
+
+    WebSocketStats stats = gateway.get_stats();
+    EXPECT_EQ(stats.connections, 2u);
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_EQ(stats.commands, 2u);
+    gateway.stop();
+}
+
+TEST(WebSocketTest, ShedsConnectionsAtFdLimit) {
+    WebSocketGateway gateway;
+    gateway.set_handlers(WebSocketHandlers{
+        [](const std::string&) { return true; },
+        [](const std::string&, const tick_protocol::Command&, int64_t&) { return true; },
+        [](const std::string&) { return int64_t{0}; }
+    });
+    gateway.start(0);
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client, 0);
+
+    rlimit original{};
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &original), 0);
+    rlimit lowered = original;
+    lowered.rlim_cur = 256;
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &lowered), 0);
+    std::vector<int> fillers;
+    for (int fd = ::open("/dev/null", O_RDONLY); fd >= 0; fd = ::open("/dev/null", O_RDONLY)) {
+        fillers.push_back(fd);
+    }
+
+    // Bağlantı kuyrukta kalmaz: kabul edilip kapatılır
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(gateway.get_port());
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    pollfd pfd{client, POLLIN, 0};
+    ASSERT_EQ(::poll(&pfd, 1, 2000), 1);
+    char byte;
+    EXPECT_EQ(::recv(client, &byte, 1, 0), 0);
+    EXPECT_EQ(gateway.get_stats().rejected, 1u);
+
+    for (int fd : fillers) ::close(fd);
+    ::setrlimit(RLIMIT_NOFILE, &original);
+    ::close(client);
+
+    int fd = connect_local(gateway.get_port());
+    ASSERT_GE(fd, 0);
+    std::string request = upgrade_request("p1");
+    ::send(fd, request.data(), request.size(), 0);
+    EXPECT_EQ(read_http_head(fd).substr(0, 12), "HTTP/1.1 101");
+    ::close(fd);
+    gateway.stop();
+}
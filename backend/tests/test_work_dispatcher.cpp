@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "work_dispatcher.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(WorkDispatcherTest, CommandsRunBeforeReads) {
+    DispatcherConfig config;
+    config.workers = 1;
+    WorkDispatcher dispatcher(config);
+    
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(name);
+        };
+    };
+    
+    // Worker başlamadan kuyruğa at; sıralama önceliğe göre olmalı
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::READ, record("status1")));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::READ, record("status2")));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, record("cashout")));
+    
+    dispatcher.start();
+    dispatcher.stop();
+    
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], "cashout");
+    EXPECT_EQ(order[1], "status1");
+    EXPECT_EQ(order[2], "status2");
+}
+
+TEST(WorkDispatcherTest, RejectsWhenFull) {
+    DispatcherConfig config;
+    config.command_capacity = 2;
+    config.read_capacity = 1;
+    WorkDispatcher dispatcher(config);
+    
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+    EXPECT_FALSE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::READ, [] {}));
+    EXPECT_FALSE(dispatcher.submit(WorkPriority::READ, [] {}));
+    
+    DispatcherStats stats = dispatcher.get_stats();
+    EXPECT_EQ(stats.command_depth, 2u);
+    EXPECT_EQ(stats.read_depth, 1u);
+    EXPECT_EQ(stats.command_rejected, 1u);
+    EXPECT_EQ(stats.read_rejected, 1u);
+}
+
+TEST(WorkDispatcherTest, ReadsShedFirstUnderCommandBacklog) {
+    DispatcherConfig config;
+    config.read_shed_threshold = 2;
+    WorkDispatcher dispatcher(config);
+    
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::READ, [] {}));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+    
+    // Komut kuyruğu eşiğe ulaştı: okuma reddedilir, komut hâlâ kabul edilir
+    EXPECT_FALSE(dispatcher.submit(WorkPriority::READ, [] {}));
+    EXPECT_TRUE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+}
+
+TEST(WorkDispatcherTest, DedicatedCommandWorkerNotBlockedByReads) {
+    DispatcherConfig config;
+    config.workers = 2;
+    WorkDispatcher dispatcher(config);
+    dispatcher.start();
+    
+    // Tek okuma worker'ını meşgul et
+    std::atomic<bool> release{false};
+    dispatcher.submit(WorkPriority::READ, [&] {
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    
+    std::atomic<bool> command_done{false};
+    dispatcher.submit(WorkPriority::COMMAND, [&] { command_done = true; });
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!command_done && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(command_done);
+    
+    release = true;
+    dispatcher.stop();
+}
+
+TEST(WorkDispatcherTest, StopDrainsAndRejectsNewWork) {
+    WorkDispatcher dispatcher;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 10; ++i) {
+        dispatcher.submit(WorkPriority::COMMAND, [&] { done++; });
+    }
+    
+    dispatcher.start();
+    dispatcher.stop();
+    
+    EXPECT_EQ(done.load(), 10);
+    EXPECT_FALSE(dispatcher.submit(WorkPriority::COMMAND, [] {}));
+}
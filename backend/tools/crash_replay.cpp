@@ -0,0 +1,59 @@
+#include "journal_replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// ⏩ Üretim komut günlüğünü (CRASH_JOURNAL_PATH) oyun motoruna olabildiğince hızlı yeniden oynatır.
+// Kullanım: crash_replay <günlük> [--repeat N]
+// Her round sonundaki bakiye özeti tutmazsa veya bir komut reddedilirse 1 ile çıkar.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Kullanım: " << argv[0] << " <günlük> [--repeat N]" << std::endl;
+        return 2;
+    }
+    int repeat = 1;
+    for (int i = 2; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--repeat") == 0) repeat = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    std::vector<char> journal;
+    try {
+        journal = read_journal_file(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << std::endl;
+        return 2;
+    }
+
+    bool diverged = false;
+    for (int run = 1; run <= repeat; run++) {
+        JournalReplayer replayer;
+        JournalReader reader(journal.data(), journal.size());
+
+        auto started = std::chrono::steady_clock::now();
+        const ReplayStats& stats = replayer.run(reader);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        const CrashGame& game = replayer.get_game();
+        std::cout << "▶️  Çalıştırma " << run << "/" << repeat << ": "
+                  << stats.records << " kayıt, " << stats.rounds << " round, "
+                  << stats.commands << " komut, " << stats.starts << " başlatma, "
+                  << stats.handoffs << " devir" << std::endl;
+        std::cout << "   Süre: " << elapsed * 1000.0 << " ms ("
+                  << static_cast<uint64_t>(elapsed > 0 ? stats.records / elapsed : 0) << " kayıt/sn, "
+                  << "üretimde " << (stats.last_at_ms - stats.first_at_ms) / 1000 << " sn)" << std::endl;
+        std::cout << "   Son durum: round " << game.get_current_round() << ", "
+                  << game.get_player_count() << " oyuncu" << std::endl;
+        std::cout << "   Doğrulama: " << stats.checkpoints - stats.checkpoint_mismatches << "/"
+                  << stats.checkpoints << " bakiye özeti tuttu, " << stats.rejected << " komut reddedildi" << std::endl;
+        if (reader.truncated()) {
+            std::cout << "   ⚠️  Günlük " << reader.get_offset() << ". byte'ta yarım kayıtla bitiyor" << std::endl;
+        }
+        if (stats.diverged()) {
+            std::cout << "❌ Replay üretimden ayrıştı (ilk fark round " << stats.first_mismatch_round << ")" << std::endl;
+            diverged = true;
+        }
+    }
+    return diverged ? 1 : 0;
+}
@@ -4,11 +4,31 @@ set -e
 # Ensure ld cache is updated for libpistache
 ldconfig || true
 
+# Tek process modu: frontend'i de backend sunar, nginx ve replica'lar çalışmaz
+if [ "${CRASH_SERVE_STATIC:-0}" = "1" ]; then
+  export CRASH_STATIC_DIR="${CRASH_STATIC_DIR:-/usr/share/nginx/html}"
+  export CRASH_PORT="${CRASH_PORT:-80}"
+  exec /app/crash_server
+fi
+
 # Start the backend (assumes /app/crash_server exists and is executable)
 if [ -x /app/crash_server ]; then
   /app/crash_server &
   BACKEND_PID=$!
   echo "Started backend (pid $BACKEND_PID)"
+
+  # Okuma replica'ları: paylaşılan bellekten status / old-crash-points sunar (5051, SO_REUSEPORT)
+  REPLICA_PIDS=""
+  i=0
+  if [ "${CRASH_READ_REPLICAS:-0}" -gt 0 ] && [ -z "${CRASH_SHM_NAME:-}" ]; then
+    echo "Warning: CRASH_SHM_NAME is empty, read replicas are not started"
+    CRASH_READ_REPLICAS=0
+  fi
+  while [ "$i" -lt "${CRASH_READ_REPLICAS:-0}" ]; do
+    CRASH_ROLE=replica /app/crash_server &
+    REPLICA_PIDS="$REPLICA_PIDS $!"
+    i=$((i + 1))
+  done
 else
   echo "Warning: /app/crash_server not found or not executable"
 fi
@@ -16,6 +36,9 @@ fi
 # Forward signals to backend and stop gracefully
 _term() {
   echo "Caught SIGTERM, stopping..."
+  for pid in $REPLICA_PIDS; do
+    kill -TERM "$pid" 2>/dev/null || true
+  done
   if [ -n "$BACKEND_PID" ]; then
     kill -TERM "$BACKEND_PID" 2>/dev/null || true
     wait "$BACKEND_PID" || true
@@ -5,6 +5,8 @@ function AdminPanel() {
   const [playerName, setPlayerName] = useState('');
   const [amount, setAmount] = useState('');
   const [message, setMessage] = useState('');
+  const [importFile, setImportFile] = useState(null);
+  const [importErrors, setImportErrors] = useState([]);
 
   const handleLoadBalance = async () => {
     if (!playerName || !amount) {
@@ -22,6 +24,24 @@ function AdminPanel() {
     }
   };
 
+  const handleImport = async () => {
+    if (!importFile) {
+      setMessage('Lütfen bir CSV veya NDJSON dosyası seçin');
+      return;
+    }
+
+    const result = await gameAPI.importBalances(importFile);
+    if (result.rows === undefined) {
+      setMessage('❌ Hata: ' + (result.error || 'Bilinmeyen hata'));
+      setImportErrors([]);
+      return;
+    }
+    const summary = `${result.credited}/${result.rows} oyuncuya ${result.total_amount} TL yüklendi`;
+    setMessage((result.success ? '✅ ' : '❌ ') + summary +
+      (result.error_count > 0 ? ` (${result.error_count} hatalı satır)` : ''));
+    setImportErrors(result.errors || []);
+  };
+
   return (
     <div className="admin-panel">
       <h3>🔧 Admin Panel - Bakiye Yükleme</h3>
@@ -40,11 +60,26 @@ function AdminPanel() {
         />
         <button onClick={handleLoadBalance}>💳 Bakiye Yükle</button>
       </div>
+      <div className="admin-form">
+        <input
+          type="file"
+          accept=".csv,.ndjson,.jsonl,text/csv"
+          onChange={(e) => setImportFile(e.target.files[0] || null)}
+        />
+        <button onClick={handleImport}>📥 Toplu Yükle</button>
+      </div>
       {message && (
         <p className={`admin-message ${message.startsWith('✅') ? 'success' : 'error'}`}>
           {message}
         </p>
       )}
+      {importErrors.length > 0 && (
+        <ul className="admin-import-errors">
+          {importErrors.slice(0, 20).map((row) => (
+            <li key={row.line}>Satır {row.line}: {row.error}</li>
+          ))}
+        </ul>
+      )}
     </div>
   );
 }
@@ -153,6 +153,40 @@ class GameAPI {
     }
   }
 
+  // 📥 POST: Toplu bakiye yükle (Admin) - CSV veya NDJSON dosyası olduğu gibi gönderilir
+  // Sunucu gövde sınırı 64 KiB: dosya parçalar halinde sırayla yollanır, son parçada rapor döner
+  async importBalances(file) {
+    const partBytes = 48 * 1024;
+    const upload = `${Date.now().toString(36)}${Math.random().toString(36).slice(2, 10)}`;
+    const parts = Math.max(1, Math.ceil(file.size / partBytes));
+    try {
+      let part = 0;
+      let result = null;
+      while (part < parts) {
+        const last = part === parts - 1 ? '&last=1' : '';
+        const response = await fetch(`${this.baseURL}/admin/balances/import?upload=${upload}&part=${part}${last}`, {
+          method: 'POST',
+          headers: {
+            'Content-Type': file.name.endsWith('.ndjson') ? 'application/x-ndjson' : 'text/csv',
+          },
+          body: file.slice(part * partBytes, (part + 1) * partBytes)
+        });
+        result = await response.json();
+        // 409: parça zaten uygulanmış ya da sıra kaymış, sunucunun beklediği parçadan devam
+        if (response.status === 409 && result.next_part !== undefined) {
+          part = result.next_part;
+          continue;
+        }
+        if (response.status !== 202) return result;
+        part = result.next_part;
+      }
+      return result;
+    } catch (error) {
+      console.error('Import balances error:', error);
+      return { success: false, error: error.message };
+    }
+  }
+
   // 📈 GET: Eski crash pointlerini al
   async getOldCrashPoints() {
     try {
@@ -6,7 +6,7 @@ module.exports = {
   entry: './src/index.js',
   output: {
     path: path.resolve(__dirname, 'dist'),
-    filename: 'bundle.js',
+    filename: 'bundle.[contenthash:12].js', // içerik hash'i: backend / CDN bir yıl önbelleğe alabilir
     clean: true, // her build öncesi dist temizlensin
   },
   module: {
@@ -29,7 +29,7 @@ module.exports = {
         test: /\.(png|jpe?g|gif|webp|svg)$/i, // 🔥 image loader
         type: 'asset/resource',
         generator: {
-          filename: 'assets/[name][ext][query]' // dist/assets/ altında toplanır
+          filename: 'assets/[name].[contenthash:8][ext][query]' // dist/assets/ altında toplanır
         }
       }
     ]